@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+/*
+ * A FIB-only micro-benchmark of the next hop lookup of AcmeFlatForwarder on a
+ * large FIB.  It drives the FIB directly, without a forwarder or a layer 3
+ * protocol: a connection table keyed by id stands in for
+ * CCNxL3Protocol::GetConnection, and the "cached" loop repeats what
+ * AcmeFlatForwarder::ResolveNextHop does.  It does not measure queueing,
+ * the PIT or the strategy.
+ *
+ * "id" is the old path: look up the connection id in the FIB, then look up the
+ * connection in the connection table.
+ * "cached" is the current path: one FIB lookup that returns the next hop with
+ * the connection resolved on its first use and cached in its state.
+ *
+ *   ./waf --run "acme-flat-fib-benchmark --routes=100000 --lookups=2000000"
+ */
+
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/ccns3Sim-module.h"
+#include "ns3/ccns3Examples-module.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+typedef std::map<CCNxConnection::ConnIdType, Ptr<CCNxConnection> > ConnectionTableType;
+
+static Ptr<const CCNxName>
+MakeName (uint32_t index)
+{
+  char buffer[64];
+  snprintf (buffer, sizeof(buffer), "ccnx:/name=benchmark/name=route/name=%u", index);
+  return Create<CCNxName> (buffer);
+}
+
+static double
+Rate (uint32_t lookups, int64_t ms)
+{
+  return ms > 0 ? 1000.0 * lookups / ms : 0.0;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t routeCount = 100000;
+  uint32_t lookupCount = 2000000;
+  uint32_t connectionCount = 64;
+  std::string fibType = "ns3::ccnx::AcmeFlatHashFib";
+  bool bulk = false;
+
+  CommandLine cmd;
+  cmd.AddValue ("routes", "Number of routes in the FIB", routeCount);
+  cmd.AddValue ("lookups", "Number of lookups per run", lookupCount);
+  cmd.AddValue ("connections", "Number of connections the routes point to", connectionCount);
+  cmd.AddValue ("fib", "FIB TypeId", fibType);
+  cmd.AddValue ("bulk", "Load the routes with one AddRoutes call instead of one AddRoute per route", bulk);
+  cmd.Parse (argc, argv);
+
+  ObjectFactory factory;
+  factory.SetTypeId (fibType);
+  Ptr<AcmeFlatFib> fib = factory.Create<AcmeFlatFib> ();
+
+  ConnectionTableType connections;
+  for (uint32_t i = 0; i < connectionCount; ++i)
+    {
+      connections[i + 1] = Ptr<CCNxConnection> ();
+    }
+
+  std::vector<Ptr<const CCNxName> > names;
+  std::vector<uint64_t> digests;
+  for (uint32_t i = 0; i < routeCount; ++i)
+    {
+      names.push_back (MakeName (i));
+      digests.push_back (AcmeFlatNameDigest::Compute (*names.back ()));
+    }
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  if (bulk)
+    {
+      std::vector<AcmeFlatFib::BulkRouteType> routes (routeCount);
+      for (uint32_t i = 0; i < routeCount; ++i)
+        {
+          routes[i].name = names[i];
+          routes[i].digest = digests[i];
+          routes[i].connId = i % connectionCount + 1;
+        }
+      fib->AddRoutes (routes);
+    }
+  else
+    {
+      for (uint32_t i = 0; i < routeCount; ++i)
+        {
+          fib->AddRoute (names[i], digests[i], i % connectionCount + 1);
+        }
+    }
+  int64_t loadMs = clock.End ();
+
+  // The same pseudo-random sequence of names for both runs
+  std::vector<uint32_t> order (lookupCount);
+  uint32_t x = 1;
+  for (uint32_t i = 0; i < lookupCount; ++i)
+    {
+      x = x * 1103515245 + 12345;
+      order[i] = (x >> 8) % routeCount;
+    }
+
+  uint32_t found = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < lookupCount; ++i)
+    {
+      uint32_t n = order[i];
+      CCNxConnection::ConnIdType connId;
+      if (fib->Lookup (names[n], digests[n], connId))
+        {
+          ConnectionTableType::const_iterator c = connections.find (connId);
+          found += (c != connections.end ());
+        }
+    }
+  int64_t idMs = clock.End ();
+
+  // As ResolveNextHop: the table is only asked when the cached epoch is stale
+  const uint64_t epoch = 1;
+  uint64_t resolutions = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < lookupCount; ++i)
+    {
+      uint32_t n = order[i];
+      AcmeFlatFib::NextHopType *nextHop = fib->LookupNextHop (names[n], digests[n]);
+      if (nextHop)
+        {
+          AcmeFlatFib::NextHopStateType &state = fib->GetNextHopState (*nextHop);
+          if (state.epoch != epoch)
+            {
+              ConnectionTableType::const_iterator c = connections.find (nextHop->connId);
+              state.connection = c != connections.end () ? c->second : Ptr<CCNxConnection> ();
+              state.epoch = epoch;
+              resolutions++;
+            }
+          found++;
+        }
+    }
+  int64_t cachedMs = clock.End ();
+
+  std::cout << fibType << " routes " << routeCount << " lookups " << lookupCount << " found " << found << std::endl;
+  std::cout << "load   " << loadMs << " ms " << (bulk ? "bulk" : "per route") << " FIB bytes " << fib->GetMemoryUsage () << std::endl;
+  std::cout << "id     " << idMs << " ms " << Rate (lookupCount, idMs) << " lookups/sec" << std::endl;
+  std::cout << "cached " << cachedMs << " ms " << Rate (lookupCount, cachedMs) << " lookups/sec"
+            << " resolutions " << resolutions << std::endl;
+
+  fib->Dispose ();
+  return 0;
+}
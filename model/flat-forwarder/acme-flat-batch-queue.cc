@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <cmath>
+#include "acme-flat-batch-queue.h"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/simulator.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+NS_LOG_COMPONENT_DEFINE ("AcmeFlatBatchQueue");
+
+AcmeFlatBatchQueue::AcmeFlatBatchQueue (unsigned servers, uint32_t batchSize, ServiceTimeCallback serviceTime,
+                                        DequeueCallback dequeue)
+  : m_batchSize (batchSize > 0 ? batchSize : 1), m_serviceTime (serviceTime), m_dequeue (dequeue),
+  m_batches (servers > 0 ? servers : 1), m_batchCount (0), m_batchedItems (0),
+  m_maxSize (0), m_policy (TAIL_DROP), m_drops (0),
+  m_target (MilliSeconds (5)), m_interval (MilliSeconds (100)), m_dropping (false), m_count (0), m_lastCount (0),
+  m_scheduler (FIFO)
+{
+  for (size_t i = 0; i < m_batches.size (); ++i)
+    {
+      m_batches[i].reserve (m_batchSize);
+    }
+}
+
+void
+AcmeFlatBatchQueue::SetLimit (uint32_t maxSize, DropPolicyType policy, DropCallback drop)
+{
+  m_maxSize = maxSize;
+  m_policy = policy;
+  m_drop = drop;
+}
+
+void
+AcmeFlatBatchQueue::SetCoDel (Time target, Time interval)
+{
+  m_target = target;
+  m_interval = interval;
+}
+
+void
+AcmeFlatBatchQueue::Enqueue (Ptr<AcmeFlatWorkItem> item)
+{
+  if (m_maxSize > 0 && GetSize () >= m_maxSize)
+    {
+      if (m_policy == HEAD_DROP)
+        {
+          Drop (PopForDrop (), HEAD_DROP);
+        }
+      else
+        {
+          Drop (item, TAIL_DROP);
+          return;
+        }
+    }
+  if (m_scheduler == DRR)
+    {
+      Ptr<CCNxConnection> ingress = item->GetIngressConnection ();
+      m_drr.Enqueue (item, ingress ? ingress->GetConnectionId () : 0,
+                     item->GetPacket ()->GetFixedHeader ()->GetPacketLength ());
+    }
+  else
+    {
+      m_queue.push_back (item);
+    }
+  StartBatches ();
+}
+
+void
+AcmeFlatBatchQueue::SetScheduler (SchedulerType scheduler, uint32_t quantum)
+{
+  NS_ASSERT_MSG (GetSize () == 0, "Cannot change the scheduler of a busy queue");
+  m_scheduler = scheduler;
+  m_drr.SetQuantum (quantum);
+}
+
+void
+AcmeFlatBatchQueue::SetWeight (CCNxConnection::ConnIdType ingress, uint32_t weight)
+{
+  m_drr.SetWeight (ingress, weight);
+}
+
+Ptr<AcmeFlatWorkItem>
+AcmeFlatBatchQueue::Pop (void)
+{
+  if (m_scheduler == DRR)
+    {
+      return m_drr.Dequeue ();
+    }
+  if (m_queue.empty ())
+    {
+      return 0;
+    }
+  Ptr<AcmeFlatWorkItem> item = m_queue.front ();
+  m_queue.pop_front ();
+  return item;
+}
+
+Ptr<AcmeFlatWorkItem>
+AcmeFlatBatchQueue::PopForDrop (void)
+{
+  return m_scheduler == DRR ? m_drr.DropFromLongest () : Pop ();
+}
+
+void
+AcmeFlatBatchQueue::Drop (Ptr<AcmeFlatWorkItem> item, DropPolicyType policy)
+{
+  NS_LOG_DEBUG ("Drop " << policy << " with " << GetSize () << " waiting");
+  m_drops++;
+  m_drop (item, policy);
+}
+
+Ptr<AcmeFlatWorkItem>
+AcmeFlatBatchQueue::CoDelPop (Time now, bool &okToDrop)
+{
+  okToDrop = false;
+  Ptr<AcmeFlatWorkItem> item = Pop ();
+  if (!item)
+    {
+      m_firstAboveTime = Time (0);
+      return 0;
+    }
+
+  // Like a queue holding less than one MTU, a queue this item empties is not a standing queue
+  Time sojourn = now - item->GetArrivalTime ();
+  if (sojourn < m_target || GetSize () == 0)
+    {
+      m_firstAboveTime = Time (0);
+    }
+  else if (m_firstAboveTime.IsZero ())
+    {
+      m_firstAboveTime = now + m_interval;
+    }
+  else if (now >= m_firstAboveTime)
+    {
+      okToDrop = true;
+    }
+  return item;
+}
+
+Time
+AcmeFlatBatchQueue::CoDelControlLaw (Time t) const
+{
+  return t + Seconds (m_interval.GetSeconds () / std::sqrt (static_cast<double> (m_count)));
+}
+
+Ptr<AcmeFlatWorkItem>
+AcmeFlatBatchQueue::Dequeue (void)
+{
+  if (m_policy != CODEL)
+    {
+      return Pop ();
+    }
+
+  Time now = Simulator::Now ();
+  bool okToDrop;
+  Ptr<AcmeFlatWorkItem> item = CoDelPop (now, okToDrop);
+  if (m_dropping)
+    {
+      if (!okToDrop)
+        {
+          m_dropping = false;
+        }
+      while (m_dropping && now >= m_dropNext)
+        {
+          Drop (item, CODEL);
+          m_count++;
+          item = CoDelPop (now, okToDrop);
+          if (!okToDrop)
+            {
+              m_dropping = false;
+            }
+          else
+            {
+              m_dropNext = CoDelControlLaw (m_dropNext);
+            }
+        }
+    }
+  else if (okToDrop)
+    {
+      Drop (item, CODEL);
+      item = CoDelPop (now, okToDrop);
+      m_dropping = true;
+
+      // Resume near the drop rate of a recent dropping state
+      uint32_t delta = m_count - m_lastCount;
+      m_count = (delta > 1 && now - m_dropNext < m_interval * static_cast<int64_t> (16)) ? delta : 1;
+      m_dropNext = CoDelControlLaw (now);
+      m_lastCount = m_count;
+    }
+  return item;
+}
+
+void
+AcmeFlatBatchQueue::StartBatches (void)
+{
+  for (uint32_t server = 0; server < m_batches.size () && GetSize () > 0; ++server)
+    {
+      BatchType &batch = m_batches[server];
+      if (!batch.empty ())
+        {
+          continue;
+        }
+
+      while (batch.size () < m_batchSize)
+        {
+          Ptr<AcmeFlatWorkItem> item = Dequeue ();
+          if (!item)
+            {
+              break;
+            }
+          batch.push_back (item);
+        }
+      if (batch.empty ())
+        {
+          // CoDel dropped everything that was waiting
+          break;
+        }
+      m_batchCount++;
+      m_batchedItems += batch.size ();
+
+      Time delay = m_serviceTime (batch);
+      NS_LOG_DEBUG ("Server " << server << " batch of " << batch.size () << " for " << delay);
+      Simulator::Schedule (delay, &AcmeFlatBatchQueue::FinishBatch, Ptr<AcmeFlatBatchQueue> (this), server);
+    }
+}
+
+void
+AcmeFlatBatchQueue::FinishBatch (uint32_t server)
+{
+  // The server stays busy while the items are delivered, so an item the owner
+  // enqueues meanwhile waits for the next batch
+  BatchType &batch = m_batches[server];
+  for (size_t i = 0; i < batch.size (); ++i)
+    {
+      m_dequeue (batch[i]);
+    }
+  batch.clear ();
+  StartBatches ();
+}
+
+size_t
+AcmeFlatBatchQueue::GetSize (void) const
+{
+  return m_queue.size () + m_drr.GetSize ();
+}
+
+uint64_t
+AcmeFlatBatchQueue::GetBatches (void) const
+{
+  return m_batchCount;
+}
+
+uint64_t
+AcmeFlatBatchQueue::GetBatchedItems (void) const
+{
+  return m_batchedItems;
+}
+
+uint64_t
+AcmeFlatBatchQueue::GetDrops (void) const
+{
+  return m_drops;
+}
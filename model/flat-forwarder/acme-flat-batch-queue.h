@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_ACMEFLATBATCHQUEUE_H
+#define CCNS3SIM_ACMEFLATBATCHQUEUE_H
+
+#include <deque>
+#include <vector>
+#include "ns3/simple-ref-count.h"
+#include "ns3/callback.h"
+#include "ns3/nstime.h"
+#include "ns3/acme-flat-work-item.h"
+#include "ns3/acme-flat-drr-queue.h"
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * An input queue served in batches, like a vector packet processor.  It is the
+ * batch counterpart of `CCNxDelayQueue`: a FIFO in front of a number of
+ * servers.  When a server is free it takes up to `batchSize` waiting items at
+ * once (it does not wait for a batch to fill), asks the owner for the service
+ * time of the whole batch, and when that time has passed hands each item of
+ * the batch to the owner in order.
+ *
+ * Batches are kept in per-server vectors that keep their capacity, so serving
+ * does not allocate in steady state.
+ *
+ * The queue is unbounded unless SetLimit gives it a drop policy:
+ *
+ * - TAIL_DROP: an item that arrives to a full queue is dropped
+ * - HEAD_DROP: an item that arrives to a full queue is kept and the oldest waiting item is dropped
+ * - CODEL: items are dropped as a server takes them, following the CoDel
+ *   control law (RFC 8289) on their sojourn time (now minus the work item's
+ *   arrival time).  A full queue also drops arrivals, like TAIL_DROP.
+ *
+ * Dropped items go to the drop callback instead of a batch.
+ *
+ * Waiting items are served in arrival order (FIFO) unless SetScheduler picks
+ * DRR: then they wait in an `AcmeFlatDrrQueue`, one sub-queue per ingress
+ * connection, and a head drop takes the oldest item of the longest sub-queue.
+ */
+class AcmeFlatBatchQueue : public SimpleRefCount<AcmeFlatBatchQueue>
+{
+public:
+  typedef std::vector<Ptr<AcmeFlatWorkItem> > BatchType;
+
+  /**
+   * Returns the service time of a batch
+   */
+  typedef Callback<Time, const BatchType &> ServiceTimeCallback;
+
+  /**
+   * Called for each item of a batch when its service is done
+   */
+  typedef Callback<void, Ptr<AcmeFlatWorkItem> > DequeueCallback;
+
+  /**
+   * @param [in] servers The number of batches served in parallel
+   * @param [in] batchSize The most items in one batch
+   * @param [in] serviceTime Returns the service time of a batch
+   * @param [in] dequeue Receives each item when its batch is done
+   */
+  AcmeFlatBatchQueue (unsigned servers, uint32_t batchSize, ServiceTimeCallback serviceTime, DequeueCallback dequeue);
+
+  typedef enum
+  {
+    TAIL_DROP,
+    HEAD_DROP,
+    CODEL
+  } DropPolicyType;
+
+  /**
+   * Receives a dropped item and the policy that dropped it (TAIL_DROP for a
+   * full queue under CODEL)
+   */
+  typedef Callback<void, Ptr<AcmeFlatWorkItem>, DropPolicyType> DropCallback;
+
+  /**
+   * Bounds the queue.
+   *
+   * @param [in] maxSize The most items waiting for a server (0 for no limit, only useful with CODEL)
+   * @param [in] policy How to drop
+   * @param [in] drop Receives each dropped item
+   */
+  void SetLimit (uint32_t maxSize, DropPolicyType policy, DropCallback drop);
+
+  /**
+   * Sets the CoDel parameters: the acceptable sojourn time and the interval it
+   * must be exceeded for before dropping starts.  The defaults are 5 ms and 100 ms.
+   */
+  void SetCoDel (Time target, Time interval);
+
+  typedef enum
+  {
+    FIFO,
+    DRR
+  } SchedulerType;
+
+  /**
+   * Chooses the order waiting items are served in.  Call it while the queue is empty.
+   *
+   * @param [in] scheduler FIFO or DRR
+   * @param [in] quantum For DRR, the bytes of credit per round for a weight of 1
+   */
+  void SetScheduler (SchedulerType scheduler, uint32_t quantum);
+
+  /**
+   * Sets the DRR weight of an ingress connection (see `AcmeFlatDrrQueue::SetWeight`)
+   */
+  void SetWeight (ccnx::CCNxConnection::ConnIdType ingress, uint32_t weight);
+
+  /**
+   * Appends `item`, starting a batch if a server is free
+   */
+  void Enqueue (Ptr<AcmeFlatWorkItem> item);
+
+  /**
+   * @return The number of items waiting for a server (not counting batches in service)
+   */
+  size_t GetSize (void) const;
+
+  /**
+   * @return The number of batches started
+   */
+  uint64_t GetBatches (void) const;
+
+  /**
+   * @return The number of items in the batches started
+   */
+  uint64_t GetBatchedItems (void) const;
+
+  /**
+   * @return The number of items dropped
+   */
+  uint64_t GetDrops (void) const;
+
+private:
+  /**
+   * Starts a batch on each free server while items are waiting
+   */
+  void StartBatches (void);
+
+  /**
+   * Simulator event: the batch of `server` is done
+   */
+  void FinishBatch (uint32_t server);
+
+  /**
+   * @return The next item for a batch, after any CoDel drops, or null if none is waiting
+   */
+  Ptr<AcmeFlatWorkItem> Dequeue (void);
+
+  /**
+   * Takes the head of the queue for Dequeue and decides if CoDel may drop it
+   *
+   * @param [out] okToDrop True if the sojourn time has been above target for an interval
+   */
+  Ptr<AcmeFlatWorkItem> CoDelPop (Time now, bool &okToDrop);
+
+  /**
+   * @return When CoDel drops next after dropping at `t`
+   */
+  Time CoDelControlLaw (Time t) const;
+
+  void Drop (Ptr<AcmeFlatWorkItem> item, DropPolicyType policy);
+
+  /**
+   * @return The next waiting item in scheduler order, or null
+   */
+  Ptr<AcmeFlatWorkItem> Pop (void);
+
+  /**
+   * @return The waiting item a head drop removes, or null
+   */
+  Ptr<AcmeFlatWorkItem> PopForDrop (void);
+
+  uint32_t m_batchSize;
+  ServiceTimeCallback m_serviceTime;
+  DequeueCallback m_dequeue;
+
+  /**
+   * The waiting items: m_queue for FIFO, m_drr for DRR
+   */
+  std::deque<Ptr<AcmeFlatWorkItem> > m_queue;
+  AcmeFlatDrrQueue m_drr;
+
+  /**
+   * The batch of each server, empty while the server is free
+   */
+  std::vector<BatchType> m_batches;
+
+  uint64_t m_batchCount;
+  uint64_t m_batchedItems;
+
+  uint32_t m_maxSize;
+  DropPolicyType m_policy;
+  DropCallback m_drop;
+  uint64_t m_drops;
+
+  /**
+   * CoDel state, as named in RFC 8289
+   */
+  Time m_target;
+  Time m_interval;
+  bool m_dropping;
+  Time m_firstAboveTime;        //< 0 when the sojourn time is below target
+  Time m_dropNext;
+  uint32_t m_count;
+  uint32_t m_lastCount;
+
+  SchedulerType m_scheduler;
+};
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATBATCHQUEUE_H
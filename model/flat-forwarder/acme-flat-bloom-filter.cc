@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <algorithm>
+#include "acme-flat-bloom-filter.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+
+/**
+ * A counter sticks at this value rather than wrap
+ */
+static const uint8_t _maxCounter = 0xFF;
+
+static const uint32_t _maxHashes = 16;
+
+const uint32_t AcmeFlatBloomFilter::_blockSize;
+
+AcmeFlatBloomFilter::AcmeFlatBloomFilter (size_t capacity, uint32_t countersPerItem)
+  : m_capacity (std::max (static_cast<size_t> (1), capacity)), m_count (0)
+{
+  countersPerItem = std::max (1u, countersPerItem);
+
+  // k = m / n * ln 2 minimizes the false positive rate
+  m_hashes = std::max (1u, std::min (_maxHashes, countersPerItem * 69 / 100));
+  m_blocks = (m_capacity * countersPerItem + _blockSize - 1) / _blockSize;
+  m_counters.assign (m_blocks * _blockSize, 0);
+}
+
+size_t
+AcmeFlatBloomFilter::GetBlock (uint64_t digest) const
+{
+  // Scales the high 32 bits to [0, m_blocks) without a division
+  return static_cast<size_t> (((digest >> 32) * m_blocks) >> 32) * _blockSize;
+}
+
+uint32_t
+AcmeFlatBloomFilter::GetOffset (uint64_t digest, uint32_t i)
+{
+  // Double hashing in the block.  The step is odd, so the first 64 offsets are distinct.
+  uint32_t start = static_cast<uint32_t> (digest);
+  uint32_t step = static_cast<uint32_t> (digest >> 6) | 1;
+  return (start + i * step) & (_blockSize - 1);
+}
+
+void
+AcmeFlatBloomFilter::Add (uint64_t digest)
+{
+  uint8_t *block = &m_counters[GetBlock (digest)];
+  for (uint32_t i = 0; i < m_hashes; ++i)
+    {
+      uint8_t &counter = block[GetOffset (digest, i)];
+      if (counter < _maxCounter)
+        {
+          counter++;
+        }
+    }
+  m_count++;
+}
+
+void
+AcmeFlatBloomFilter::Remove (uint64_t digest)
+{
+  uint8_t *block = &m_counters[GetBlock (digest)];
+  for (uint32_t i = 0; i < m_hashes; ++i)
+    {
+      uint8_t &counter = block[GetOffset (digest, i)];
+      if (counter > 0 && counter < _maxCounter)
+        {
+          counter--;
+        }
+    }
+  if (m_count > 0)
+    {
+      m_count--;
+    }
+}
+
+bool
+AcmeFlatBloomFilter::MayContain (uint64_t digest) const
+{
+  const uint8_t *block = &m_counters[GetBlock (digest)];
+  for (uint32_t i = 0; i < m_hashes; ++i)
+    {
+      if (block[GetOffset (digest, i)] == 0)
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+size_t
+AcmeFlatBloomFilter::GetCount (void) const
+{
+  return m_count;
+}
+
+size_t
+AcmeFlatBloomFilter::GetCapacity (void) const
+{
+  return m_capacity;
+}
+
+uint32_t
+AcmeFlatBloomFilter::GetHashCount (void) const
+{
+  return m_hashes;
+}
+
+size_t
+AcmeFlatBloomFilter::GetMemoryUsage (void) const
+{
+  return m_counters.capacity ();
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_ACMEFLATBLOOMFILTER_H
+#define CCNS3SIM_ACMEFLATBLOOMFILTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * A counting Bloom filter of name digests.  MayContain is false only for a
+ * digest that is not in the filter, so a caller can skip a table lookup that
+ * is sure to miss.  It is true for every digest in the filter and, with a
+ * small probability, for others.
+ *
+ * The filter is blocked: all the counters of a digest are in one block of 64
+ * counters (64 bytes), picked by the high bits of the digest, and the low bits
+ * pick `k` counters in the block.  A query reads one block, about one cache
+ * line, whatever `k`.  With the default 8 counters per item (k = 5) about 3% of
+ * the digests not in a full filter pass it.
+ *
+ * The counters are 8 bits so Remove can undo an Add.  A counter that reaches
+ * 255 sticks there and is never decremented, so a digest in the filter can
+ * never be removed by mistake; it only adds false positives.  Removing a digest
+ * that was not added breaks the filter.
+ *
+ * The filter does not grow.  When GetCount passes GetCapacity the false
+ * positive rate rises; the owner should rebuild it larger.
+ */
+class AcmeFlatBloomFilter
+{
+public:
+  /**
+   * @param [in] capacity The number of items the filter is sized for
+   * @param [in] countersPerItem The counters per item (sets `k` to about 0.7 of it)
+   */
+  AcmeFlatBloomFilter (size_t capacity = 1024, uint32_t countersPerItem = 8);
+
+  /**
+   * Adds one instance of `digest`
+   */
+  void Add (uint64_t digest);
+
+  /**
+   * Removes one instance of `digest`, which must have been added
+   */
+  void Remove (uint64_t digest);
+
+  /**
+   * @return false if `digest` is not in the filter, true if it may be
+   */
+  bool MayContain (uint64_t digest) const;
+
+  /**
+   * @return The number of Adds less the number of Removes
+   */
+  size_t GetCount (void) const;
+
+  /**
+   * @return The number of items the filter is sized for
+   */
+  size_t GetCapacity (void) const;
+
+  /**
+   * @return The counters each digest uses
+   */
+  uint32_t GetHashCount (void) const;
+
+  /**
+   * @return The bytes of the counters
+   */
+  size_t GetMemoryUsage (void) const;
+
+private:
+  static const uint32_t _blockSize = 64;
+
+  /**
+   * @return The index of the first counter of the block of `digest`
+   */
+  size_t GetBlock (uint64_t digest) const;
+
+  /**
+   * @return The offset in its block of the `i`th counter of `digest`
+   */
+  static uint32_t GetOffset (uint64_t digest, uint32_t i);
+
+  size_t m_capacity;
+  size_t m_blocks;
+  uint32_t m_hashes;
+  size_t m_count;
+
+  std::vector<uint8_t> m_counters;
+};
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATBLOOMFILTER_H
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "acme-flat-congestion-marks.h"
+
+#include "ns3/log.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+using namespace ns3::acme;
+
+NS_LOG_COMPONENT_DEFINE ("AcmeFlatCongestionMarks");
+NS_OBJECT_ENSURE_REGISTERED (AcmeFlatCongestionMarks);
+
+static const Time _defaultMarkLifetime = Seconds (1);
+
+TypeId
+AcmeFlatCongestionMarks::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ccnx::AcmeFlatCongestionMarks")
+    .SetParent<Object> ()
+    .SetGroupName ("CCNx")
+    .AddConstructor<AcmeFlatCongestionMarks> ()
+    .AddAttribute ("MarkLifetime", "How long a packet stays marked, at least the time its Content Object takes down the reverse path",
+                   TimeValue (_defaultMarkLifetime),
+                   MakeTimeAccessor (&AcmeFlatCongestionMarks::m_markLifetime),
+                   MakeTimeChecker ())
+  ;
+  return tid;
+}
+
+AcmeFlatCongestionMarks::AcmeFlatCongestionMarks ()
+  : m_markLifetime (_defaultMarkLifetime), m_markCount (0)
+{
+  // empty
+}
+
+AcmeFlatCongestionMarks::~AcmeFlatCongestionMarks ()
+{
+  // empty (use DoDispose)
+}
+
+void
+AcmeFlatCongestionMarks::DoDispose (void)
+{
+  m_marks.clear ();
+  m_order.clear ();
+  Object::DoDispose ();
+}
+
+void
+AcmeFlatCongestionMarks::Mark (Ptr<const CCNxPacket> packet, Time now)
+{
+  Expire (now);
+  m_marks[PeekPointer (packet)] = now;
+  m_order.push_back (std::make_pair (now, packet));
+  m_markCount++;
+}
+
+void
+AcmeFlatCongestionMarks::Unmark (Ptr<const CCNxPacket> packet)
+{
+  if (!m_marks.empty ())
+    {
+      // The entry in m_order is dropped when it expires
+      m_marks.erase (PeekPointer (packet));
+    }
+}
+
+bool
+AcmeFlatCongestionMarks::IsMarked (Ptr<const CCNxPacket> packet, Time now)
+{
+  if (m_marks.empty ())
+    {
+      return false;
+    }
+  Expire (now);
+  return m_marks.find (PeekPointer (packet)) != m_marks.end ();
+}
+
+void
+AcmeFlatCongestionMarks::Expire (Time now)
+{
+  while (!m_order.empty () && m_order.front ().first + m_markLifetime <= now)
+    {
+      // A packet marked again since keeps its later mark
+      std::map<const CCNxPacket *, Time>::iterator i = m_marks.find (PeekPointer (m_order.front ().second));
+      if (i != m_marks.end () && i->second == m_order.front ().first)
+        {
+          m_marks.erase (i);
+        }
+      m_order.pop_front ();
+    }
+}
+
+size_t
+AcmeFlatCongestionMarks::GetSize (void) const
+{
+  return m_marks.size ();
+}
+
+uint64_t
+AcmeFlatCongestionMarks::GetMarks (void) const
+{
+  return m_markCount;
+}
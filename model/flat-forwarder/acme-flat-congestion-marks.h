@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+#ifndef CCNS3SIM_ACMEFLATCONGESTIONMARKS_H
+#define CCNS3SIM_ACMEFLATCONGESTIONMARKS_H
+
+#include <map>
+#include <deque>
+#include <utility>
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/ccnx-packet.h"
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * The congestion marks of Content Object packets.  It plays the role of an
+ * ECN bit, which the CCNx fixed header does not have, as a tag on the packet:
+ * an `AcmeFlatForwarder` that sends a Content Object on the reverse path of a
+ * congested PIT entry (see its "MarkingTarget") marks that packet here, and
+ * a forwarder that routes the packet later reports it as marked and passes the
+ * mark on.  A mark belongs to one packet, not to its name, so another copy of
+ * the Content Object on a different path or from a content store is not
+ * marked.  Shared by the forwarders of a simulation (see
+ * `AcmeFlatForwarderHelper`).
+ *
+ * A mark lasts at most "MarkLifetime"; the table holds a reference to each
+ * marked packet until then, so a packet allocated later at the same address
+ * is never taken for a marked one.  Expired marks are removed in the order
+ * they were made, so the cost is O(log n) per mark or lookup for n live
+ * marks, and nothing when there are none.
+ */
+class AcmeFlatCongestionMarks : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+
+  AcmeFlatCongestionMarks ();
+  virtual ~AcmeFlatCongestionMarks ();
+
+  /**
+   * Marks `packet`
+   */
+  void Mark (Ptr<const ccnx::CCNxPacket> packet, Time now);
+
+  /**
+   * Removes the mark of `packet`, if it has one
+   */
+  void Unmark (Ptr<const ccnx::CCNxPacket> packet);
+
+  /**
+   * @return true if `packet` was marked in the last "MarkLifetime" and not unmarked since
+   */
+  bool IsMarked (Ptr<const ccnx::CCNxPacket> packet, Time now);
+
+  /**
+   * @return The number of live marks (including expired marks not yet removed)
+   */
+  size_t GetSize (void) const;
+
+  /**
+   * @return The number of Mark calls
+   */
+  uint64_t GetMarks (void) const;
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /**
+   * Removes the marks that expired by `now`
+   */
+  void Expire (Time now);
+
+  Time m_markLifetime;
+
+  /**
+   * The time of the last mark of each packet
+   */
+  std::map<const ccnx::CCNxPacket *, Time> m_marks;
+
+  /**
+   * Every mark in the order it was made, for Expire.  Holds the packet so its address is not reused.
+   */
+  std::deque<std::pair<Time, Ptr<const ccnx::CCNxPacket> > > m_order;
+
+  uint64_t m_markCount;
+};
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATCONGESTIONMARKS_H
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "acme-flat-connection-index.h"
+
+#include "ns3/assert.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+using namespace ns3::acme;
+
+const uint32_t AcmeFlatConnectionIndex::_none;
+
+AcmeFlatConnectionIndex::AcmeFlatConnectionIndex ()
+{
+  // empty
+}
+
+uint64_t
+AcmeFlatConnectionIndex::Key (CCNxConnection::ConnIdType connId, uint64_t digest)
+{
+  // digest is already finalized, so the low-order bits stay well mixed
+  uint64_t key = digest ^ ((static_cast<uint64_t> (connId) + 1) * 0x9e3779b97f4a7c15ULL);
+  return key == 0 ? 1 : key;
+}
+
+uint32_t
+AcmeFlatConnectionIndex::Find (CCNxConnection::ConnIdType connId, const CCNxName &name, uint64_t digest) const
+{
+  uint64_t key = Key (connId, digest);
+  size_t position = m_index.Probe (key);
+  uint32_t entry;
+  while (m_index.Next (key, position, entry))
+    {
+      const EntryType &e = m_entries[entry];
+      if (e.connId == connId && e.digest == digest && e.name->Equals (name))
+        {
+          return entry;
+        }
+    }
+  return _none;
+}
+
+bool
+AcmeFlatConnectionIndex::Add (CCNxConnection::ConnIdType connId, Ptr<const CCNxName> name, uint64_t digest)
+{
+  if (Find (connId, *name, digest) != _none)
+    {
+      return false;
+    }
+
+  uint32_t entry;
+  if (m_freeEntries.empty ())
+    {
+      entry = static_cast<uint32_t> (m_entries.size ());
+      m_entries.push_back (EntryType ());
+    }
+  else
+    {
+      entry = m_freeEntries.back ();
+      m_freeEntries.pop_back ();
+    }
+
+  ListMapType::iterator list = m_lists.find (connId);
+  if (list == m_lists.end ())
+    {
+      ListType empty = { _none, 0 };
+      list = m_lists.insert (std::make_pair (connId, empty)).first;
+    }
+
+  EntryType &e = m_entries[entry];
+  e.name = name;
+  e.digest = digest;
+  e.connId = connId;
+  e.prev = _none;
+  e.next = list->second.head;
+  if (e.next != _none)
+    {
+      m_entries[e.next].prev = entry;
+    }
+  list->second.head = entry;
+  list->second.count++;
+
+  m_index.Insert (Key (connId, digest), entry);
+  return true;
+}
+
+bool
+AcmeFlatConnectionIndex::Remove (CCNxConnection::ConnIdType connId, const CCNxName &name, uint64_t digest)
+{
+  uint32_t entry = Find (connId, name, digest);
+  if (entry == _none)
+    {
+      return false;
+    }
+
+  ListMapType::iterator list = m_lists.find (connId);
+  NS_ASSERT_MSG (list != m_lists.end (), "Entry without a list for connection " << connId);
+
+  EntryType &e = m_entries[entry];
+  if (e.prev != _none)
+    {
+      m_entries[e.prev].next = e.next;
+    }
+  else
+    {
+      list->second.head = e.next;
+    }
+  if (e.next != _none)
+    {
+      m_entries[e.next].prev = e.prev;
+    }
+
+  if (--list->second.count == 0)
+    {
+      m_lists.erase (list);
+    }
+
+  m_index.Erase (Key (connId, digest), entry);
+  e.name = 0;
+  m_freeEntries.push_back (entry);
+  return true;
+}
+
+size_t
+AcmeFlatConnectionIndex::Take (CCNxConnection::ConnIdType connId, std::vector<AcmeFlatFib::BulkRouteType> &routes)
+{
+  ListMapType::iterator list = m_lists.find (connId);
+  if (list == m_lists.end ())
+    {
+      return 0;
+    }
+
+  size_t count = list->second.count;
+  routes.reserve (routes.size () + count);
+  for (uint32_t entry = list->second.head; entry != _none; entry = m_entries[entry].next)
+    {
+      EntryType &e = m_entries[entry];
+      AcmeFlatFib::BulkRouteType route = { e.name, e.digest, connId };
+      routes.push_back (route);
+      m_index.Erase (Key (connId, e.digest), entry);
+      e.name = 0;
+      m_freeEntries.push_back (entry);
+    }
+  m_lists.erase (list);
+  return count;
+}
+
+size_t
+AcmeFlatConnectionIndex::GetCount (CCNxConnection::ConnIdType connId) const
+{
+  ListMapType::const_iterator list = m_lists.find (connId);
+  return list == m_lists.end () ? 0 : list->second.count;
+}
+
+size_t
+AcmeFlatConnectionIndex::GetSize (void) const
+{
+  return m_entries.size () - m_freeEntries.size ();
+}
+
+size_t
+AcmeFlatConnectionIndex::GetConnectionCount (void) const
+{
+  return m_lists.size ();
+}
+
+void
+AcmeFlatConnectionIndex::Clear (void)
+{
+  m_entries.clear ();
+  m_freeEntries.clear ();
+  m_lists.clear ();
+  m_index.Clear ();
+}
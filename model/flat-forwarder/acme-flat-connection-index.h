@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_ACMEFLATCONNECTIONINDEX_H
+#define CCNS3SIM_ACMEFLATCONNECTIONINDEX_H
+
+#include <map>
+#include <vector>
+#include "ns3/ptr.h"
+#include "ns3/ccnx-name.h"
+#include "ns3/ccnx-connection.h"
+#include "ns3/acme-flat-fib.h"
+#include "ns3/acme-flat-digest-index.h"
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * The reverse of the FIB: for each connection id, the names routed to it.  The
+ * forwarder uses it to remove every route of a failed connection without
+ * scanning the FIB.
+ *
+ * Entries live in a pool and each connection keeps a doubly linked list of its
+ * entries.  An AcmeFlatDigestIndex keyed on (connection id, name digest) finds
+ * an entry for Add and Remove in O(1), and Take walks only the connection's list.
+ */
+class AcmeFlatConnectionIndex
+{
+public:
+  AcmeFlatConnectionIndex ();
+
+  /**
+   * Records that `name` is routed to `connId`.  Does nothing if it already is.
+   *
+   * @param [in] digest The AcmeFlatNameDigest of `name`
+   * @return true if added
+   */
+  bool Add (ccnx::CCNxConnection::ConnIdType connId, Ptr<const ccnx::CCNxName> name, uint64_t digest);
+
+  /**
+   * @return true if `name` was routed to `connId` and is now removed
+   */
+  bool Remove (ccnx::CCNxConnection::ConnIdType connId, const ccnx::CCNxName &name, uint64_t digest);
+
+  /**
+   * Removes every name routed to `connId` and appends them to `routes`.
+   *
+   * @return The number of names removed
+   */
+  size_t Take (ccnx::CCNxConnection::ConnIdType connId, std::vector<AcmeFlatFib::BulkRouteType> &routes);
+
+  /**
+   * @return The number of names routed to `connId`
+   */
+  size_t GetCount (ccnx::CCNxConnection::ConnIdType connId) const;
+
+  /**
+   * @return The number of (connection, name) pairs
+   */
+  size_t GetSize (void) const;
+
+  /**
+   * @return The number of connections with at least one name
+   */
+  size_t GetConnectionCount (void) const;
+
+  void Clear (void);
+
+private:
+  static const uint32_t _none = 0xFFFFFFFF;
+
+  typedef struct
+  {
+    Ptr<const ccnx::CCNxName> name;
+    uint64_t digest;
+    ccnx::CCNxConnection::ConnIdType connId;
+    uint32_t prev;
+    uint32_t next;
+  } EntryType;
+
+  typedef struct
+  {
+    uint32_t head;
+    size_t count;
+  } ListType;
+
+  typedef std::map<ccnx::CCNxConnection::ConnIdType, ListType> ListMapType;
+
+  static uint64_t Key (ccnx::CCNxConnection::ConnIdType connId, uint64_t digest);
+
+  /**
+   * @return The entry for (`connId`, `name`), or _none
+   */
+  uint32_t Find (ccnx::CCNxConnection::ConnIdType connId, const ccnx::CCNxName &name, uint64_t digest) const;
+
+  std::vector<EntryType> m_entries;
+  std::vector<uint32_t> m_freeEntries;
+  ListMapType m_lists;
+  AcmeFlatDigestIndex m_index;
+};
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATCONNECTIONINDEX_H
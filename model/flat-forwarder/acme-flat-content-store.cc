@@ -0,0 +1,455 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "acme-flat-content-store.h"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/acme-flat-packet-log.h"
+#include "ns3/uinteger.h"
+#include "ns3/enum.h"
+#include "ns3/acme-flat-name-table.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+NS_LOG_COMPONENT_DEFINE ("AcmeFlatContentStore");
+NS_OBJECT_ENSURE_REGISTERED (AcmeFlatContentStore);
+
+static const uint64_t _defaultByteCapacity = 0;
+
+const uint32_t AcmeFlatContentStore::_none;
+
+TypeId
+AcmeFlatContentStore::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ccnx::AcmeFlatContentStore")
+    .SetParent<Object> ()
+    .SetGroupName ("CCNx")
+    .AddConstructor<AcmeFlatContentStore> ()
+    .AddAttribute ("ByteCapacity", "The maximum total bytes of cached packets (0 disables the cache)",
+                   UintegerValue (_defaultByteCapacity),
+                   MakeUintegerAccessor (&AcmeFlatContentStore::m_byteCapacity),
+                   MakeUintegerChecker<uint64_t> ())
+    .AddAttribute ("Policy", "The replacement policy",
+                   EnumValue (AcmeFlatContentStore::LRU),
+                   MakeEnumAccessor (&AcmeFlatContentStore::m_policy),
+                   MakeEnumChecker (AcmeFlatContentStore::LRU, "LRU",
+                                    AcmeFlatContentStore::CLOCK, "CLOCK",
+                                    AcmeFlatContentStore::ARC, "ARC"))
+  ;
+  return tid;
+}
+
+AcmeFlatContentStore::AcmeFlatContentStore ()
+  : m_arcTarget (0), m_hits (0), m_misses (0), m_insertions (0), m_evictions (0),
+  m_byteCapacity (_defaultByteCapacity), m_policy (LRU)
+{
+  for (unsigned i = 0; i < ListCount; ++i)
+    {
+      m_lists[i].head = _none;
+      m_lists[i].tail = _none;
+      m_lists[i].bytes = 0;
+      m_lists[i].count = 0;
+    }
+}
+
+AcmeFlatContentStore::~AcmeFlatContentStore ()
+{
+  // empty (use DoDispose)
+}
+
+void
+AcmeFlatContentStore::DoDispose (void)
+{
+  m_entries.clear ();
+  m_freeEntries.clear ();
+  m_index.Clear ();
+  for (unsigned i = 0; i < ListCount; ++i)
+    {
+      m_lists[i].head = _none;
+      m_lists[i].tail = _none;
+      m_lists[i].bytes = 0;
+      m_lists[i].count = 0;
+    }
+  Object::DoDispose ();
+}
+
+uint32_t
+AcmeFlatContentStore::Find (const CCNxName &name, uint64_t digest) const
+{
+  size_t position = m_index.Probe (digest);
+  uint32_t handle;
+  while (m_index.Next (digest, position, handle))
+    {
+      if (AcmeFlatNameTable::Equals (*m_entries[handle].name, name, m_operations.segmentCompares))
+        {
+          return handle;
+        }
+    }
+  return _none;
+}
+
+uint32_t
+AcmeFlatContentStore::AllocateEntry (Ptr<const CCNxName> name, uint64_t digest)
+{
+  uint32_t handle;
+  if (m_freeEntries.empty ())
+    {
+      handle = static_cast<uint32_t> (m_entries.size ());
+      m_entries.push_back (EntryType ());
+    }
+  else
+    {
+      handle = m_freeEntries.back ();
+      m_freeEntries.pop_back ();
+    }
+
+  EntryType &entry = m_entries[handle];
+  entry.name = name;
+  entry.digest = digest;
+  entry.prev = _none;
+  entry.next = _none;
+  entry.list = NoList;
+  entry.referenced = false;
+  m_index.Insert (digest, handle);
+  m_operations.insertions++;
+  return handle;
+}
+
+void
+AcmeFlatContentStore::FreeEntry (uint32_t handle)
+{
+  Unlink (handle);
+  EntryType &entry = m_entries[handle];
+  m_index.Erase (entry.digest, handle);
+  entry.name = 0;
+  entry.packet = 0;
+  m_freeEntries.push_back (handle);
+}
+
+void
+AcmeFlatContentStore::PushFront (ListIdType list, uint32_t handle)
+{
+  EntryType &entry = m_entries[handle];
+  NS_ASSERT_MSG (entry.list == NoList, "Entry is already in list " << (int) entry.list);
+
+  ListType &l = m_lists[list];
+  entry.list = list;
+  entry.prev = _none;
+  entry.next = l.head;
+  if (l.head != _none)
+    {
+      m_entries[l.head].prev = handle;
+    }
+  else
+    {
+      l.tail = handle;
+    }
+  l.head = handle;
+  l.bytes += entry.bytes;
+  l.count++;
+}
+
+void
+AcmeFlatContentStore::Unlink (uint32_t handle)
+{
+  EntryType &entry = m_entries[handle];
+  if (entry.list == NoList)
+    {
+      return;
+    }
+
+  ListType &l = m_lists[entry.list];
+  if (entry.prev != _none)
+    {
+      m_entries[entry.prev].next = entry.next;
+    }
+  else
+    {
+      l.head = entry.next;
+    }
+  if (entry.next != _none)
+    {
+      m_entries[entry.next].prev = entry.prev;
+    }
+  else
+    {
+      l.tail = entry.prev;
+    }
+  l.bytes -= entry.bytes;
+  l.count--;
+  entry.list = NoList;
+  entry.prev = _none;
+  entry.next = _none;
+}
+
+Ptr<CCNxPacket>
+AcmeFlatContentStore::Lookup (const CCNxName &name, uint64_t digest)
+{
+  uint32_t handle = Find (name, digest);
+  if (handle == _none || !m_entries[handle].packet)
+    {
+      m_misses++;
+      return Ptr<CCNxPacket> (0);
+    }
+
+  m_hits++;
+  switch (m_policy)
+    {
+    case LRU:
+      Unlink (handle);
+      PushFront (T1, handle);
+      break;
+
+    case CLOCK:
+      m_entries[handle].referenced = true;
+      break;
+
+    case ARC:
+      Unlink (handle);
+      PushFront (T2, handle);
+      break;
+    }
+  return m_entries[handle].packet;
+}
+
+void
+AcmeFlatContentStore::Demote (uint32_t handle, ListIdType ghost)
+{
+  Unlink (handle);
+  m_entries[handle].packet = 0;
+  PushFront (ghost, handle);
+  m_evictions++;
+}
+
+void
+AcmeFlatContentStore::MakeRoom (uint32_t bytes)
+{
+  ListType &l = m_lists[T1];
+  while (l.tail != _none && l.bytes + bytes > m_byteCapacity)
+    {
+      uint32_t victim = l.tail;
+      if (m_policy == CLOCK && m_entries[victim].referenced)
+        {
+          // Second chance
+          m_entries[victim].referenced = false;
+          Unlink (victim);
+          PushFront (T1, victim);
+        }
+      else
+        {
+          FreeEntry (victim);
+          m_evictions++;
+        }
+    }
+}
+
+void
+AcmeFlatContentStore::ArcReplace (uint32_t bytes, bool hitB2)
+{
+  ListType &t1 = m_lists[T1];
+  ListType &t2 = m_lists[T2];
+  while ((t1.count > 0 || t2.count > 0) && t1.bytes + t2.bytes + bytes > m_byteCapacity)
+    {
+      if (t1.count > 0 && (t2.count == 0 || t1.bytes > m_arcTarget || (hitB2 && t1.bytes >= m_arcTarget)))
+        {
+          Demote (t1.tail, B1);
+        }
+      else
+        {
+          Demote (t2.tail, B2);
+        }
+    }
+}
+
+void
+AcmeFlatContentStore::ArcTrimGhosts (uint32_t bytes)
+{
+  while (m_lists[B1].count > 0 && m_lists[T1].bytes + m_lists[B1].bytes + bytes > m_byteCapacity)
+    {
+      FreeEntry (m_lists[B1].tail);
+    }
+
+  uint64_t total = m_lists[T1].bytes + m_lists[T2].bytes + m_lists[B1].bytes + m_lists[B2].bytes;
+  while (m_lists[B2].count > 0 && total + bytes > 2 * m_byteCapacity)
+    {
+      total -= m_entries[m_lists[B2].tail].bytes;
+      FreeEntry (m_lists[B2].tail);
+    }
+}
+
+bool
+AcmeFlatContentStore::Add (Ptr<const CCNxName> name, uint64_t digest, Ptr<CCNxPacket> packet)
+{
+  ACME_FLAT_PACKET_LOG_FUNCTION (this << name);
+
+  uint32_t bytes = packet->GetFixedHeader ()->GetPacketLength ();
+  if (bytes > m_byteCapacity)
+    {
+      return false;
+    }
+
+  uint32_t handle = Find (*name, digest);
+  bool cached = (handle != _none && m_entries[handle].packet);
+  bool hitB1 = (handle != _none && m_entries[handle].list == B1);
+  bool hitB2 = (handle != _none && m_entries[handle].list == B2);
+
+  // ARC: a ghost hit moves the target by the ratio of the ghost lists, which
+  // still count the ghost that was hit
+  if (m_policy == ARC && hitB1)
+    {
+      uint64_t ratio = m_lists[B1].bytes > 0 ? m_lists[B2].bytes / m_lists[B1].bytes : 0;
+      uint64_t delta = bytes * (ratio > 1 ? ratio : 1);
+      m_arcTarget = (m_arcTarget + delta < m_byteCapacity) ? m_arcTarget + delta : m_byteCapacity;
+    }
+  else if (m_policy == ARC && hitB2)
+    {
+      uint64_t ratio = m_lists[B2].bytes > 0 ? m_lists[B1].bytes / m_lists[B2].bytes : 0;
+      uint64_t delta = bytes * (ratio > 1 ? ratio : 1);
+      m_arcTarget = (m_arcTarget > delta) ? m_arcTarget - delta : 0;
+    }
+
+  if (handle != _none)
+    {
+      // Take it out of its list while making room so it is not the victim
+      Unlink (handle);
+    }
+
+  if (m_policy == ARC)
+    {
+      if (!cached && !hitB1 && !hitB2)
+        {
+          ArcTrimGhosts (bytes);
+        }
+      ArcReplace (bytes, hitB2);
+    }
+  else
+    {
+      MakeRoom (bytes);
+    }
+
+  if (handle == _none)
+    {
+      handle = AllocateEntry (name, digest);
+    }
+
+  EntryType &entry = m_entries[handle];
+  entry.packet = packet;
+  entry.bytes = bytes;
+  entry.referenced = false;
+
+  // ARC: an object seen before (cached or a ghost) is frequent
+  PushFront ((m_policy == ARC && (cached || hitB1 || hitB2)) ? T2 : T1, handle);
+  m_insertions++;
+  return true;
+}
+
+bool
+AcmeFlatContentStore::IsEnabled (void) const
+{
+  return m_byteCapacity > 0;
+}
+
+uint64_t
+AcmeFlatContentStore::GetByteCapacity (void) const
+{
+  return m_byteCapacity;
+}
+
+uint64_t
+AcmeFlatContentStore::GetBytes (void) const
+{
+  return m_lists[T1].bytes + m_lists[T2].bytes;
+}
+
+size_t
+AcmeFlatContentStore::GetCount (void) const
+{
+  return m_lists[T1].count + m_lists[T2].count;
+}
+
+uint64_t
+AcmeFlatContentStore::GetHits (void) const
+{
+  return m_hits;
+}
+
+uint64_t
+AcmeFlatContentStore::GetMisses (void) const
+{
+  return m_misses;
+}
+
+uint64_t
+AcmeFlatContentStore::GetInsertions (void) const
+{
+  return m_insertions;
+}
+
+uint64_t
+AcmeFlatContentStore::GetEvictions (void) const
+{
+  return m_evictions;
+}
+
+AcmeFlatOperationCounts
+AcmeFlatContentStore::GetOperations (void) const
+{
+  AcmeFlatOperationCounts operations = m_operations;
+  operations.probes += m_index.GetProbes ();
+  return operations;
+}
@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_ACMEFLATCONTENTSTORE_H
+#define CCNS3SIM_ACMEFLATCONTENTSTORE_H
+
+#include <vector>
+#include "ns3/object.h"
+#include "ns3/ccnx-name.h"
+#include "ns3/ccnx-packet.h"
+#include "ns3/acme-flat-digest-index.h"
+#include "ns3/acme-flat-operation-counts.h"
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * The Content Store of `AcmeFlatForwarder`.  It caches Content Object packets
+ * by exact name and is limited by the total packet bytes ("ByteCapacity"), not
+ * by object count.  A capacity of 0 disables the cache.
+ *
+ * The replacement policy is set by the "Policy" attribute:
+ * - LRU: evict the least recently used object.
+ * - CLOCK: second chance FIFO.  A hit only sets a reference bit, so hits do not
+ *   touch the list; eviction gives referenced objects one more pass.
+ * - ARC: Adaptive Replacement Cache with the recency (T1) and frequency (T2)
+ *   lists, their ghost lists (B1, B2), and the adaptive T1 target all counted
+ *   in bytes.  A ghost keeps the name but not the packet.
+ *
+ * Entries (and ghosts) live in a pool addressed by 32-bit handle and are linked
+ * into the policy lists through indices stored in the entry, so caching an object
+ * does not allocate once the pool has grown.  An `AcmeFlatDigestIndex` on the
+ * `AcmeFlatNameDigest` finds the entry of a name.
+ */
+class AcmeFlatContentStore : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+
+  AcmeFlatContentStore ();
+  virtual ~AcmeFlatContentStore ();
+
+  typedef enum
+  {
+    LRU,
+    CLOCK,
+    ARC
+  } PolicyType;
+
+  /**
+   * Looks up a cached Content Object.  Counts a hit or a miss.
+   *
+   * @param [in] name The name of the Interest
+   * @param [in] digest The AcmeFlatNameDigest of `name`
+   * @return The cached packet, or null
+   */
+  Ptr<ccnx::CCNxPacket> Lookup (const ccnx::CCNxName &name, uint64_t digest);
+
+  /**
+   * Caches a Content Object, evicting others as needed.  A cached object of the same
+   * name is replaced.
+   *
+   * @param [in] name The name of the Content Object
+   * @param [in] digest The AcmeFlatNameDigest of `name`
+   * @param [in] packet The Content Object packet
+   * @return true if cached, false if the cache is disabled or the packet is larger than the capacity
+   */
+  bool Add (Ptr<const ccnx::CCNxName> name, uint64_t digest, Ptr<ccnx::CCNxPacket> packet);
+
+  /**
+   * @return true if the capacity is not 0
+   */
+  bool IsEnabled (void) const;
+
+  uint64_t GetByteCapacity (void) const;
+
+  /**
+   * @return The bytes of the cached packets
+   */
+  uint64_t GetBytes (void) const;
+
+  /**
+   * @return The number of cached objects (not counting ghosts)
+   */
+  size_t GetCount (void) const;
+
+  uint64_t GetHits (void) const;
+
+  uint64_t GetMisses (void) const;
+
+  uint64_t GetInsertions (void) const;
+
+  uint64_t GetEvictions (void) const;
+
+  /**
+   * @return The operations the table has performed since it was created, for the
+   * cost model of `AcmeFlatForwarder`
+   */
+  AcmeFlatOperationCounts GetOperations (void) const;
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  static const uint32_t _none = 0xFFFFFFFF;
+
+  /**
+   * The policy lists.  LRU and CLOCK only use T1.
+   */
+  typedef enum
+  {
+    T1 = 0,
+    T2,
+    B1,
+    B2,
+    ListCount,
+    NoList = ListCount
+  } ListIdType;
+
+  typedef struct
+  {
+    Ptr<const ccnx::CCNxName> name;
+    uint64_t digest;
+    Ptr<ccnx::CCNxPacket> packet;       //< null for a ghost
+    uint32_t bytes;
+    uint32_t prev;                      //< towards the head (most recent) of the list
+    uint32_t next;                      //< towards the tail (least recent) of the list
+    uint8_t list;                       //< ListIdType
+    bool referenced;                    //< CLOCK reference bit
+  } EntryType;
+
+  typedef struct
+  {
+    uint32_t head;
+    uint32_t tail;
+    uint64_t bytes;
+    size_t count;
+  } ListType;
+
+  /**
+   * @return The handle of the entry or ghost of `name`, or _none
+   */
+  uint32_t Find (const ccnx::CCNxName &name, uint64_t digest) const;
+
+  uint32_t AllocateEntry (Ptr<const ccnx::CCNxName> name, uint64_t digest);
+
+  /**
+   * Unlinks the entry, removes it from the index, and returns it to the pool
+   */
+  void FreeEntry (uint32_t handle);
+
+  void PushFront (ListIdType list, uint32_t handle);
+
+  void Unlink (uint32_t handle);
+
+  /**
+   * Evicts until `bytes` more fit, by the LRU or CLOCK policy
+   */
+  void MakeRoom (uint32_t bytes);
+
+  /**
+   * ARC REPLACE: moves the LRU object of T1 or T2 to its ghost list until `bytes` more fit
+   *
+   * @param [in] bytes The size of the object to insert
+   * @param [in] hitB2 true if the object being inserted was a ghost in B2
+   */
+  void ArcReplace (uint32_t bytes, bool hitB2);
+
+  /**
+   * Drops ghosts so the ARC directory stays within its bounds
+   */
+  void ArcTrimGhosts (uint32_t bytes);
+
+  /**
+   * Evicts a cached object to a ghost list
+   */
+  void Demote (uint32_t handle, ListIdType ghost);
+
+  std::vector<EntryType> m_entries;
+  std::vector<uint32_t> m_freeEntries;
+  AcmeFlatDigestIndex m_index;
+
+  /**
+   * Segment compares and insertions; the probes are counted by m_index
+   */
+  mutable AcmeFlatOperationCounts m_operations;
+  ListType m_lists[ListCount];
+
+  /**
+   * The ARC target size of T1 in bytes
+   */
+  uint64_t m_arcTarget;
+
+  uint64_t m_hits;
+  uint64_t m_misses;
+  uint64_t m_insertions;
+  uint64_t m_evictions;
+
+  /**
+   * Set by the "ByteCapacity" attribute
+   */
+  uint64_t m_byteCapacity;
+
+  /**
+   * Set by the "Policy" attribute
+   */
+  PolicyType m_policy;
+};
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATCONTENTSTORE_H
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "acme-flat-digest-index.h"
+
+#include "ns3/assert.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+
+static size_t
+RoundUpPowerOfTwo (size_t n)
+{
+  size_t capacity = 1;
+  while (capacity < n)
+    {
+      capacity <<= 1;
+    }
+  return capacity;
+}
+
+AcmeFlatDigestIndex::AcmeFlatDigestIndex (uint32_t initialCapacity)
+  : m_mask (0), m_count (0), m_probes (0)
+{
+  Resize (RoundUpPowerOfTwo (initialCapacity < 2 ? 2 : initialCapacity));
+}
+
+void
+AcmeFlatDigestIndex::Resize (size_t capacity)
+{
+  std::vector<uint64_t> oldDigests;
+  std::vector<uint32_t> oldValues;
+  oldDigests.swap (m_digests);
+  oldValues.swap (m_values);
+
+  m_digests.assign (capacity, 0);
+  m_values.assign (capacity, 0);
+  m_mask = capacity - 1;
+
+  for (size_t i = 0; i < oldDigests.size (); ++i)
+    {
+      if (oldDigests[i] != 0)
+        {
+          Place (oldDigests[i], oldValues[i]);
+        }
+    }
+}
+
+void
+AcmeFlatDigestIndex::Place (uint64_t digest, uint32_t value)
+{
+  size_t i = digest & m_mask;
+  while (m_digests[i] != 0)
+    {
+      i = (i + 1) & m_mask;
+    }
+  m_digests[i] = digest;
+  m_values[i] = value;
+}
+
+void
+AcmeFlatDigestIndex::Insert (uint64_t digest, uint32_t value)
+{
+  NS_ASSERT_MSG (digest != 0, "Digest 0 is reserved");
+  if ((m_count + 1) * 10 > m_digests.size () * 7)
+    {
+      Resize (m_digests.size () << 1);
+    }
+  Place (digest, value);
+  m_count++;
+}
+
+bool
+AcmeFlatDigestIndex::Erase (uint64_t digest, uint32_t value)
+{
+  size_t hole = digest & m_mask;
+  while (m_digests[hole] != 0 && !(m_digests[hole] == digest && m_values[hole] == value))
+    {
+      hole = (hole + 1) & m_mask;
+    }
+  if (m_digests[hole] == 0)
+    {
+      return false;
+    }
+
+  m_digests[hole] = 0;
+  m_count--;
+
+  // Backward-shift: move up any entry whose home slot is not in (hole, j]
+  size_t j = (hole + 1) & m_mask;
+  while (m_digests[j] != 0)
+    {
+      size_t home = m_digests[j] & m_mask;
+      bool movable = (hole <= j) ? (home <= hole || home > j) : (home <= hole && home > j);
+      if (movable)
+        {
+          m_digests[hole] = m_digests[j];
+          m_values[hole] = m_values[j];
+          m_digests[j] = 0;
+          hole = j;
+        }
+      j = (j + 1) & m_mask;
+    }
+  return true;
+}
+
+size_t
+AcmeFlatDigestIndex::Probe (uint64_t digest) const
+{
+  return digest & m_mask;
+}
+
+bool
+AcmeFlatDigestIndex::Next (uint64_t digest, size_t &position, uint32_t &value) const
+{
+  while (m_digests[position] != 0)
+    {
+      m_probes++;
+      size_t i = position;
+      position = (position + 1) & m_mask;
+      if (m_digests[i] == digest)
+        {
+          value = m_values[i];
+          return true;
+        }
+    }
+  m_probes++;
+  return false;
+}
+
+void
+AcmeFlatDigestIndex::Clear (void)
+{
+  m_digests.assign (m_digests.size (), 0);
+  m_count = 0;
+}
+
+void
+AcmeFlatDigestIndex::Reserve (size_t count)
+{
+  size_t capacity = RoundUpPowerOfTwo ((count * 10) / 7 + 1);
+  if (capacity > m_digests.size ())
+    {
+      Resize (capacity);
+    }
+}
+
+size_t
+AcmeFlatDigestIndex::GetSize (void) const
+{
+  return m_count;
+}
+
+size_t
+AcmeFlatDigestIndex::GetCapacity (void) const
+{
+  return m_digests.size ();
+}
+
+uint64_t
+AcmeFlatDigestIndex::GetProbes (void) const
+{
+  return m_probes;
+}
+
+size_t
+AcmeFlatDigestIndex::GetMemoryUsage (void) const
+{
+  return m_digests.capacity () * sizeof(uint64_t) + m_values.capacity () * sizeof(uint32_t);
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_ACMEFLATDIGESTINDEX_H
+#define CCNS3SIM_ACMEFLATDIGESTINDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * An open-addressing hash index from a 64-bit digest to a 32-bit value, usually
+ * the index of an entry in a table that the caller owns.
+ *
+ * Several values may share a digest (the caller verifies the full key), so a
+ * lookup walks every slot of the probe sequence with a matching digest:
+ *
+ * @code
+ * size_t position = index.Probe (digest);
+ * uint32_t value;
+ * while (index.Next (digest, position, value))
+ *   {
+ *     if (table[value].key == key) { ... }
+ *   }
+ * @endcode
+ *
+ * Uses linear probing with backward-shift deletion and doubles when it exceeds
+ * a load factor of 0.7.  The digest 0 is reserved to mark an empty slot.
+ */
+class AcmeFlatDigestIndex
+{
+public:
+  /**
+   * @param [in] initialCapacity The starting number of slots (rounded up to a power of 2)
+   */
+  AcmeFlatDigestIndex (uint32_t initialCapacity = 64);
+
+  /**
+   * Adds a (digest, value) pair.  Does not check for duplicates.
+   *
+   * @param [in] digest A non-zero digest
+   * @param [in] value The value to store
+   */
+  void Insert (uint64_t digest, uint32_t value);
+
+  /**
+   * Removes the (digest, value) pair.
+   *
+   * @return true if the pair was found and removed
+   */
+  bool Erase (uint64_t digest, uint32_t value);
+
+  /**
+   * @return The starting position of the probe sequence of `digest`, for `Next`.
+   */
+  size_t Probe (uint64_t digest) const;
+
+  /**
+   * Advances `position` to the next slot holding `digest`.
+   *
+   * @param [in] digest The digest being probed
+   * @param [in,out] position The probe position, from `Probe` or a previous `Next`
+   * @param [out] value The value in the matching slot
+   * @return true if there was a match, false if the probe sequence ended
+   */
+  bool Next (uint64_t digest, size_t &position, uint32_t &value) const;
+
+  /**
+   * Removes all entries, keeping the current capacity
+   */
+  void Clear (void);
+
+  /**
+   * Re-allocates the table so it can hold `count` entries without growing.
+   */
+  void Reserve (size_t count);
+
+  size_t GetSize (void) const;
+
+  size_t GetCapacity (void) const;
+
+  /**
+   * @return The number of slots `Next` has examined, including the empty slot
+   * that ends each probe sequence.  Clear does not reset it.
+   */
+  uint64_t GetProbes (void) const;
+
+  /**
+   * @return The number of bytes allocated for slots
+   */
+  size_t GetMemoryUsage (void) const;
+
+private:
+  void Resize (size_t capacity);
+
+  void Place (uint64_t digest, uint32_t value);
+
+  std::vector<uint64_t> m_digests;
+  std::vector<uint32_t> m_values;
+  size_t m_mask;
+  size_t m_count;
+  mutable uint64_t m_probes;
+};
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATDIGESTINDEX_H
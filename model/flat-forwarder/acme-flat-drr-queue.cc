@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+#include "acme-flat-drr-queue.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+AcmeFlatDrrQueue::AcmeFlatDrrQueue (uint32_t quantum)
+  : m_quantum (quantum > 0 ? quantum : 1), m_size (0)
+{
+  // empty
+}
+
+void
+AcmeFlatDrrQueue::SetQuantum (uint32_t quantum)
+{
+  m_quantum = quantum > 0 ? quantum : 1;
+}
+
+uint32_t
+AcmeFlatDrrQueue::GetSubQueue (CCNxConnection::ConnIdType ingress)
+{
+  std::map<CCNxConnection::ConnIdType, uint32_t>::iterator i = m_index.find (ingress);
+  if (i != m_index.end ())
+    {
+      return i->second;
+    }
+
+  uint32_t handle = static_cast<uint32_t> (m_subQueues.size ());
+  SubQueueType subQueue;
+  subQueue.weight = 1;
+  subQueue.deficit = 0;
+  subQueue.credited = false;
+  m_subQueues.push_back (subQueue);
+  m_index[ingress] = handle;
+  return handle;
+}
+
+void
+AcmeFlatDrrQueue::SetWeight (CCNxConnection::ConnIdType ingress, uint32_t weight)
+{
+  m_subQueues[GetSubQueue (ingress)].weight = weight > 0 ? weight : 1;
+}
+
+uint32_t
+AcmeFlatDrrQueue::GetWeight (CCNxConnection::ConnIdType ingress) const
+{
+  std::map<CCNxConnection::ConnIdType, uint32_t>::const_iterator i = m_index.find (ingress);
+  return i == m_index.end () ? 1 : m_subQueues[i->second].weight;
+}
+
+void
+AcmeFlatDrrQueue::Enqueue (Ptr<AcmeFlatWorkItem> item, CCNxConnection::ConnIdType ingress, uint32_t bytes)
+{
+  uint32_t handle = GetSubQueue (ingress);
+  SubQueueType &subQueue = m_subQueues[handle];
+  if (subQueue.items.empty ())
+    {
+      m_active.push_back (handle);
+    }
+  EntryType entry = { item, bytes };
+  subQueue.items.push_back (entry);
+  m_size++;
+}
+
+void
+AcmeFlatDrrQueue::Deactivate (uint32_t handle)
+{
+  m_subQueues[handle].deficit = 0;
+  m_subQueues[handle].credited = false;
+}
+
+Ptr<AcmeFlatWorkItem>
+AcmeFlatDrrQueue::Dequeue (void)
+{
+  while (!m_active.empty ())
+    {
+      uint32_t handle = m_active.front ();
+      SubQueueType &subQueue = m_subQueues[handle];
+      if (!subQueue.credited)
+        {
+          subQueue.deficit += static_cast<uint64_t> (m_quantum) * subQueue.weight;
+          subQueue.credited = true;
+        }
+
+      uint32_t bytes = subQueue.items.front ().bytes;
+      if (bytes <= subQueue.deficit)
+        {
+          Ptr<AcmeFlatWorkItem> item = subQueue.items.front ().item;
+          subQueue.items.pop_front ();
+          subQueue.deficit -= bytes;
+          m_size--;
+          if (subQueue.items.empty ())
+            {
+              Deactivate (handle);
+              m_active.pop_front ();
+            }
+          return item;
+        }
+
+      // The head does not fit: keep the credit and go to the next sub-queue
+      subQueue.credited = false;
+      m_active.pop_front ();
+      m_active.push_back (handle);
+    }
+  return 0;
+}
+
+Ptr<AcmeFlatWorkItem>
+AcmeFlatDrrQueue::DropFromLongest (void)
+{
+  if (m_active.empty ())
+    {
+      return 0;
+    }
+
+  std::deque<uint32_t>::iterator longest = m_active.begin ();
+  for (std::deque<uint32_t>::iterator i = m_active.begin (); i != m_active.end (); ++i)
+    {
+      if (m_subQueues[*i].items.size () > m_subQueues[*longest].items.size ())
+        {
+          longest = i;
+        }
+    }
+
+  uint32_t handle = *longest;
+  SubQueueType &subQueue = m_subQueues[handle];
+  Ptr<AcmeFlatWorkItem> item = subQueue.items.front ().item;
+  subQueue.items.pop_front ();
+  m_size--;
+  if (subQueue.items.empty ())
+    {
+      Deactivate (handle);
+      m_active.erase (longest);
+    }
+  return item;
+}
+
+size_t
+AcmeFlatDrrQueue::GetSize (void) const
+{
+  return m_size;
+}
+
+size_t
+AcmeFlatDrrQueue::GetActiveCount (void) const
+{
+  return m_active.size ();
+}
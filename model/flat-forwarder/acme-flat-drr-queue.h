@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+#ifndef CCNS3SIM_ACMEFLATDRRQUEUE_H
+#define CCNS3SIM_ACMEFLATDRRQUEUE_H
+
+#include <deque>
+#include <map>
+#include <vector>
+#include "ns3/ptr.h"
+#include "ns3/ccnx-connection.h"
+#include "ns3/acme-flat-work-item.h"
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * Work items waiting in one sub-queue per ingress connection, served by
+ * deficit round robin (Shreedhar and Varghese).  Each visit of the round
+ * gives a sub-queue `quantum * weight` bytes of credit, and it sends packets
+ * while its head packet fits in the credit, so over a busy period each
+ * ingress gets a share of the packet bytes in proportion to its weight,
+ * whatever the others send.
+ *
+ * A sub-queue is created for an ingress on its first packet and kept, so
+ * Enqueue and Dequeue do not allocate once every ingress has been seen.
+ */
+class AcmeFlatDrrQueue
+{
+public:
+  /**
+   * @param [in] quantum The bytes of credit per round for a weight of 1
+   */
+  AcmeFlatDrrQueue (uint32_t quantum = 1500);
+
+  void SetQuantum (uint32_t quantum);
+
+  /**
+   * Sets the weight of an ingress connection.  The default is 1.
+   */
+  void SetWeight (ccnx::CCNxConnection::ConnIdType ingress, uint32_t weight);
+
+  uint32_t GetWeight (ccnx::CCNxConnection::ConnIdType ingress) const;
+
+  /**
+   * Appends `item` to the sub-queue of `ingress`
+   *
+   * @param [in] item The work item
+   * @param [in] ingress The ingress connection of the item
+   * @param [in] bytes The size the item is charged in DRR credit
+   */
+  void Enqueue (Ptr<AcmeFlatWorkItem> item, ccnx::CCNxConnection::ConnIdType ingress, uint32_t bytes);
+
+  /**
+   * @return The next item in deficit round robin order, or null if none is waiting
+   */
+  Ptr<AcmeFlatWorkItem> Dequeue (void);
+
+  /**
+   * Removes the oldest item of the longest sub-queue, to make room in a full
+   * queue at the expense of the heaviest ingress.  O(number of sub-queues).
+   *
+   * @return The removed item, or null if none is waiting
+   */
+  Ptr<AcmeFlatWorkItem> DropFromLongest (void);
+
+  /**
+   * @return The number of items waiting
+   */
+  size_t GetSize (void) const;
+
+  /**
+   * @return The number of sub-queues with items waiting
+   */
+  size_t GetActiveCount (void) const;
+
+private:
+  typedef struct
+  {
+    Ptr<AcmeFlatWorkItem> item;
+    uint32_t bytes;
+  } EntryType;
+
+  typedef struct
+  {
+    std::deque<EntryType> items;
+    uint32_t weight;
+    uint64_t deficit;       //< bytes of credit left
+    bool credited;          //< got its quantum on this visit of the round
+  } SubQueueType;
+
+  uint32_t GetSubQueue (ccnx::CCNxConnection::ConnIdType ingress);
+
+  /**
+   * Resets the credit of a sub-queue that ran empty and takes it off the round
+   */
+  void Deactivate (uint32_t subQueue);
+
+  uint32_t m_quantum;
+  std::vector<SubQueueType> m_subQueues;
+  std::map<ccnx::CCNxConnection::ConnIdType, uint32_t> m_index;
+
+  /**
+   * The round: handles of the sub-queues with items waiting, the one being served first
+   */
+  std::deque<uint32_t> m_active;
+  size_t m_size;
+};
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATDRRQUEUE_H
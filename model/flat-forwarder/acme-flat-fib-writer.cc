@@ -0,0 +1,416 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <algorithm>
+#include <cstring>
+#include "acme-flat-fib-writer.h"
+
+#include "ns3/assert.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+using namespace ns3::acme;
+
+const uint16_t AcmeFlatFibWriter::_binaryVersion;
+const uint16_t AcmeFlatFibWriter::_binaryEnd;
+
+static void
+PutUint16 (std::ostream &os, uint16_t value)
+{
+  char bytes[2] = { static_cast<char> (value >> 8), static_cast<char> (value) };
+  os.write (bytes, sizeof (bytes));
+}
+
+static void
+PutUint32 (std::ostream &os, uint32_t value)
+{
+  char bytes[4] = { static_cast<char> (value >> 24), static_cast<char> (value >> 16),
+                    static_cast<char> (value >> 8), static_cast<char> (value) };
+  os.write (bytes, sizeof (bytes));
+}
+
+/**
+ * @return true if `c` may appear unescaped in a URI segment (RFC 3986 unreserved)
+ */
+static bool
+IsUnreserved (unsigned char c)
+{
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')
+         || c == '-' || c == '.' || c == '_' || c == '~';
+}
+
+/**
+ * A route whose name is `length` bytes at `offset` in the key buffer.  The key is
+ * the segments of a binary record: a uint16 type, a uint16 length and the value
+ * for each segment, big endian.  memcmp order of keys is AcmeFlatFibWriter::Compare.
+ */
+typedef struct
+{
+  size_t offset;
+  uint32_t length;
+  uint16_t segmentCount;
+  const AcmeFlatFib::RouteType *route;
+} EntryType;
+
+static void
+AppendUint16 (std::vector<char> &keys, uint16_t value)
+{
+  keys.push_back (static_cast<char> (value >> 8));
+  keys.push_back (static_cast<char> (value));
+}
+
+/**
+ * Appends the key of `name` to `keys`
+ */
+static void
+Encode (const CCNxName &name, std::vector<char> &keys)
+{
+  for (size_t i = 0; i < name.GetSegmentCount (); ++i)
+    {
+      Ptr<const CCNxNameSegment> segment = name.GetSegment (i);
+      const std::string &value = segment->GetValue ();
+      NS_ASSERT_MSG (value.size () <= 0xFFFF, "Name segment longer than a TLV");
+      AppendUint16 (keys, static_cast<uint16_t> (segment->GetType ()));
+      AppendUint16 (keys, static_cast<uint16_t> (value.size ()));
+      keys.insert (keys.end (), value.begin (), value.end ());
+    }
+}
+
+static int
+CompareKeys (const char *a, size_t aLength, const char *b, size_t bLength)
+{
+  int result = std::memcmp (a, b, std::min (aLength, bLength));
+  if (result != 0 || aLength == bLength)
+    {
+      return result;
+    }
+  return aLength < bLength ? -1 : 1;
+}
+
+class IsLessEntry
+{
+public:
+  IsLessEntry (const char *keys)
+    : m_keys (keys)
+  {
+  }
+
+  bool operator() (const EntryType &a, const EntryType &b) const
+  {
+    int result = CompareKeys (m_keys + a.offset, a.length, m_keys + b.offset, b.length);
+    if (result != 0 || !a.route || !b.route)
+      {
+        return result < 0;
+      }
+    // The next hops of a multipath route in connection id order
+    return a.route->connId < b.route->connId;
+  }
+
+private:
+  const char *m_keys;
+};
+
+static uint16_t
+GetUint16 (const char *bytes)
+{
+  return static_cast<uint16_t> ((static_cast<unsigned char> (bytes[0]) << 8) | static_cast<unsigned char> (bytes[1]));
+}
+
+static void
+WriteText (const EntryType &entry, const char *key, bool counters, std::ostream &os)
+{
+  static const char hex[] = "0123456789ABCDEF";
+
+  os << entry.route->connId << " ccnx:";
+  if (entry.segmentCount == 0)
+    {
+      os.put ('/');
+    }
+
+  const char *end = key + entry.length;
+  while (key < end)
+    {
+      uint16_t type = GetUint16 (key);
+      uint16_t length = GetUint16 (key + 2);
+      key += 4;
+
+      if (type == CCNxNameFieldType_Name)
+        {
+          os.write ("/name=", 6);
+        }
+      else
+        {
+          char label[8] = { '/', '0', 'x', hex[(type >> 12) & 0xF], hex[(type >> 8) & 0xF],
+                            hex[(type >> 4) & 0xF], hex[type & 0xF], '=' };
+          os.write (label, sizeof (label));
+        }
+
+      for (uint16_t j = 0; j < length; ++j)
+        {
+          unsigned char c = static_cast<unsigned char> (key[j]);
+          if (IsUnreserved (c))
+            {
+              os.put (static_cast<char> (c));
+            }
+          else
+            {
+              char escape[3] = { '%', hex[c >> 4], hex[c & 0xF] };
+              os.write (escape, sizeof (escape));
+            }
+        }
+      key += length;
+    }
+  if (counters)
+    {
+      os << " cost " << entry.route->cost << " packets " << entry.route->packets << " bytes " << entry.route->bytes;
+    }
+  os.put ('\n');
+}
+
+static void
+WriteBinary (const EntryType &entry, const char *key, std::ostream &os)
+{
+  PutUint16 (os, entry.segmentCount);
+  PutUint32 (os, static_cast<uint32_t> (entry.route->connId));
+  os.write (key, entry.length);
+}
+
+AcmeFlatFibWriter::AcmeFlatFibWriter ()
+  : m_format (TEXT), m_prefix (0), m_sampleInterval (1), m_nextHopCounters (false)
+{
+  // empty
+}
+
+void
+AcmeFlatFibWriter::SetFormat (FormatType format)
+{
+  m_format = format;
+}
+
+AcmeFlatFibWriter::FormatType
+AcmeFlatFibWriter::GetFormat (void) const
+{
+  return m_format;
+}
+
+void
+AcmeFlatFibWriter::SetPrefix (Ptr<const CCNxName> prefix)
+{
+  m_prefix = prefix;
+}
+
+Ptr<const CCNxName>
+AcmeFlatFibWriter::GetPrefix (void) const
+{
+  return m_prefix;
+}
+
+void
+AcmeFlatFibWriter::SetSampleInterval (uint32_t interval)
+{
+  m_sampleInterval = interval == 0 ? 1 : interval;
+}
+
+uint32_t
+AcmeFlatFibWriter::GetSampleInterval (void) const
+{
+  return m_sampleInterval;
+}
+
+void
+AcmeFlatFibWriter::SetNextHopCounters (bool counters)
+{
+  m_nextHopCounters = counters;
+}
+
+bool
+AcmeFlatFibWriter::GetNextHopCounters (void) const
+{
+  return m_nextHopCounters;
+}
+
+int
+AcmeFlatFibWriter::Compare (const CCNxName &a, const CCNxName &b)
+{
+  size_t count = std::min (a.GetSegmentCount (), b.GetSegmentCount ());
+  for (size_t i = 0; i < count; ++i)
+    {
+      Ptr<const CCNxNameSegment> x = a.GetSegment (i);
+      Ptr<const CCNxNameSegment> y = b.GetSegment (i);
+      if (x->GetType () != y->GetType ())
+        {
+          return x->GetType () < y->GetType () ? -1 : 1;
+        }
+      const std::string &xValue = x->GetValue ();
+      const std::string &yValue = y->GetValue ();
+      if (xValue.size () != yValue.size ())
+        {
+          return xValue.size () < yValue.size () ? -1 : 1;
+        }
+      int result = std::memcmp (xValue.data (), yValue.data (), xValue.size ());
+      if (result != 0)
+        {
+          return result;
+        }
+    }
+
+  if (a.GetSegmentCount () == b.GetSegmentCount ())
+    {
+      return 0;
+    }
+  return a.GetSegmentCount () < b.GetSegmentCount () ? -1 : 1;
+}
+
+bool
+AcmeFlatFibWriter::HasPrefix (const CCNxName &name, const CCNxName &prefix)
+{
+  if (prefix.GetSegmentCount () > name.GetSegmentCount ())
+    {
+      return false;
+    }
+  for (size_t i = 0; i < prefix.GetSegmentCount (); ++i)
+    {
+      Ptr<const CCNxNameSegment> x = name.GetSegment (i);
+      Ptr<const CCNxNameSegment> y = prefix.GetSegment (i);
+      if (x->GetType () != y->GetType () || x->GetValue () != y->GetValue ())
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+uint64_t
+AcmeFlatFibWriter::Write (const AcmeFlatFib &fib, std::ostream &os) const
+{
+  std::vector<AcmeFlatFib::RouteType> routes;
+  fib.GetRoutes (routes);
+
+  std::vector<EntryType> entries;
+  std::vector<char> keys;
+  entries.reserve (routes.size ());
+  for (size_t i = 0; i < routes.size (); ++i)
+    {
+      EntryType entry;
+      entry.offset = keys.size ();
+      Encode (*routes[i].name, keys);
+      entry.length = static_cast<uint32_t> (keys.size () - entry.offset);
+      entry.segmentCount = static_cast<uint16_t> (routes[i].name->GetSegmentCount ());
+      entry.route = &routes[i];
+      entries.push_back (entry);
+    }
+  // The prefix key goes at the end of the buffer.  There is always at least one
+  // byte, so &keys[0] is valid when every name is empty.
+  EntryType prefix = { keys.size (), 0, 0, 0 };
+  if (m_prefix)
+    {
+      Encode (*m_prefix, keys);
+      prefix.length = static_cast<uint32_t> (keys.size () - prefix.offset);
+    }
+  keys.push_back (0);
+
+  IsLessEntry isLess (&keys[0]);
+  std::sort (entries.begin (), entries.end (), isLess);
+
+  std::vector<EntryType>::const_iterator i = entries.begin ();
+  if (m_prefix)
+    {
+      i = std::lower_bound (entries.begin (), entries.end (), prefix, isLess);
+    }
+
+  if (m_format == BINARY)
+    {
+      os.write ("AFIB", 4);
+      PutUint16 (os, _binaryVersion);
+    }
+
+  uint64_t written = 0;
+  uint64_t index = 0;
+  bool sampled = false;
+  for (std::vector<EntryType>::const_iterator previous = entries.end (); i != entries.end (); previous = i++)
+    {
+      const char *key = &keys[i->offset];
+      if (m_prefix && (i->length < prefix.length || std::memcmp (key, &keys[prefix.offset], prefix.length) != 0))
+        {
+          break;
+        }
+      // The next hops of a route are adjacent, and the route is sampled as a whole
+      if (previous == entries.end () || CompareKeys (&keys[previous->offset], previous->length, key, i->length) != 0)
+        {
+          sampled = index++ % m_sampleInterval == 0;
+        }
+      if (!sampled)
+        {
+          continue;
+        }
+
+      if (m_format == BINARY)
+        {
+          WriteBinary (*i, key, os);
+        }
+      else
+        {
+          WriteText (*i, key, m_nextHopCounters, os);
+        }
+      written++;
+    }
+
+  if (m_format == BINARY)
+    {
+      PutUint16 (os, _binaryEnd);
+      PutUint32 (os, static_cast<uint32_t> (written));
+    }
+  return written;
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_ACMEFLATFIBWRITER_H
+#define CCNS3SIM_ACMEFLATFIBWRITER_H
+
+#include <stdint.h>
+#include <vector>
+#include <ostream>
+#include "ns3/ptr.h"
+#include "ns3/ccnx-name.h"
+#include "ns3/acme-flat-fib.h"
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * Writes the routes of an AcmeFlatFib to a stream, sorted by name.  Each name is
+ * read once and encoded into a single key buffer (the size of the binary dump),
+ * which is sorted with memcmp and written straight from the buffer, so there is
+ * no per-route string and the sort does not chase name segments.
+ *
+ * The output may be limited to the routes under a prefix (they are contiguous in
+ * sorted order, so this is a binary search and a scan) and sampled to every Nth
+ * route, which keeps checkpoint dumps of very large tables small.  A sampled
+ * route is written with all of its next hops.
+ *
+ * The text format is one line per next hop: the connection id, a space, and the
+ * name as a URI, optionally followed by the cost and forwarding counters of the
+ * next hop (SetNextHopCounters).  A multipath route has a line per next hop.
+ * Segment types other than Name are labelled with their hex type, and value
+ * bytes outside the URI unreserved set are percent-encoded.
+ * @code
+ * 3 ccnx:/name=parc/name=csl
+ * 5 ccnx:/name=parc/0x0010=%01
+ * @endcode
+ *
+ * The binary format is big endian.  It starts with the 4 bytes "AFIB" and a
+ * uint16 version (1).  Each next hop is a uint16 segment count, a uint32 connection
+ * id, then for each segment a uint16 type, a uint16 length and the value.  The
+ * last record has a segment count of 0xFFFF followed by the uint32 number of
+ * next hops written.
+ */
+class AcmeFlatFibWriter
+{
+public:
+  typedef enum
+  {
+    TEXT,
+    BINARY
+  } FormatType;
+
+  /**
+   * A writer for every route, as text
+   */
+  AcmeFlatFibWriter ();
+
+  void SetFormat (FormatType format);
+  FormatType GetFormat (void) const;
+
+  /**
+   * Only writes routes whose name starts with `prefix`.  Null writes every route.
+   */
+  void SetPrefix (Ptr<const ccnx::CCNxName> prefix);
+  Ptr<const ccnx::CCNxName> GetPrefix (void) const;
+
+  /**
+   * Only writes every `interval`th route (after the prefix filter), starting
+   * with the first.  0 and 1 write every route.
+   */
+  void SetSampleInterval (uint32_t interval);
+  uint32_t GetSampleInterval (void) const;
+
+  /**
+   * If true, text lines end with " cost C packets P bytes B" for the next hop
+   */
+  void SetNextHopCounters (bool counters);
+  bool GetNextHopCounters (void) const;
+
+  /**
+   * Writes the routes of `fib` to `os`.
+   *
+   * @return The number of next hops written (text lines or binary records)
+   */
+  uint64_t Write (const AcmeFlatFib &fib, std::ostream &os) const;
+
+  /**
+   * Orders names segment by segment (type, then length, then value bytes).  A
+   * name sorts right before the names it is a prefix of.
+   *
+   * @return Less than, equal to or greater than 0 as `a` sorts before, with or after `b`
+   */
+  static int Compare (const ccnx::CCNxName &a, const ccnx::CCNxName &b);
+
+  /**
+   * @return true if the first segments of `name` are the segments of `prefix`
+   */
+  static bool HasPrefix (const ccnx::CCNxName &name, const ccnx::CCNxName &prefix);
+
+private:
+  static const uint16_t _binaryVersion = 1;
+  static const uint16_t _binaryEnd = 0xFFFF;
+
+  FormatType m_format;
+  Ptr<const ccnx::CCNxName> m_prefix;
+  uint32_t m_sampleInterval;
+  bool m_nextHopCounters;
+};
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATFIBWRITER_H
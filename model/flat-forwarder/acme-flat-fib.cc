@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "acme-flat-fib.h"
+
+#include "ns3/assert.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+
+NS_OBJECT_ENSURE_REGISTERED (AcmeFlatFib);
+
+const uint32_t AcmeFlatFib::NoAlternates;
+const uint32_t AcmeFlatFib::NoState;
+
+TypeId
+AcmeFlatFib::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ccnx::AcmeFlatFib")
+    .SetParent<Object> ()
+    .SetGroupName ("CCNx")
+  ;
+  return tid;
+}
+
+AcmeFlatFib::AcmeFlatFib ()
+{
+  // empty
+}
+
+AcmeFlatFib::~AcmeFlatFib ()
+{
+  // empty
+}
+
+void
+AcmeFlatFib::DoDispose (void)
+{
+  m_alternates.clear ();
+  m_freeAlternates.clear ();
+  m_states.clear ();
+  m_freeStates.clear ();
+  Object::DoDispose ();
+}
+
+AcmeFlatFib::NextHopType
+AcmeFlatFib::MakeNextHop (ccnx::CCNxConnection::ConnIdType connId)
+{
+  NextHopType nextHop;
+  nextHop.connId = connId;
+  nextHop.cost = 0;
+  nextHop.alternates = NoAlternates;
+  nextHop.state = NoState;
+  return nextHop;
+}
+
+AcmeFlatFib::NextHopStateType &
+AcmeFlatFib::GetNextHopState (NextHopType &nextHop)
+{
+  if (nextHop.state == NoState)
+    {
+      NextHopStateType empty = { Ptr<ccnx::CCNxConnection> (0), 0, 0, 0, Time (0) };
+      if (m_freeStates.empty ())
+        {
+          nextHop.state = static_cast<uint32_t> (m_states.size ());
+          m_states.push_back (empty);
+        }
+      else
+        {
+          nextHop.state = m_freeStates.back ();
+          m_freeStates.pop_back ();
+          m_states[nextHop.state] = empty;
+        }
+    }
+  return m_states[nextHop.state];
+}
+
+const AcmeFlatFib::NextHopStateType &
+AcmeFlatFib::PeekNextHopState (const NextHopType &nextHop) const
+{
+  static const NextHopStateType empty = { Ptr<ccnx::CCNxConnection> (0), 0, 0, 0, Time (0) };
+  return nextHop.state == NoState ? empty : m_states[nextHop.state];
+}
+
+void
+AcmeFlatFib::ReleaseNextHopState (NextHopType &nextHop)
+{
+  if (nextHop.state != NoState)
+    {
+      // Drop the cached connection now rather than when the slot is reused
+      m_states[nextHop.state].connection = 0;
+      m_freeStates.push_back (nextHop.state);
+      nextHop.state = NoState;
+    }
+}
+
+bool
+AcmeFlatFib::AddNextHop (Ptr<const ccnx::CCNxName> name, uint64_t digest, ccnx::CCNxConnection::ConnIdType connId, uint32_t cost)
+{
+  NextHopType *first = FindRoute (name, digest);
+  if (!first)
+    {
+      AddRoute (name, digest, connId);
+      first = FindRoute (name, digest);
+      NS_ASSERT_MSG (first, "Route missing after AddRoute");
+      first->cost = cost;
+      return true;
+    }
+
+  size_t count = GetNextHopCount (*first);
+  for (size_t i = 0; i < count; ++i)
+    {
+      if (GetNextHop (*first, i).connId == connId)
+        {
+          return false;
+        }
+    }
+
+  if (first->alternates == NoAlternates)
+    {
+      if (m_freeAlternates.empty ())
+        {
+          first->alternates = static_cast<uint32_t> (m_alternates.size ());
+          m_alternates.push_back (std::vector<NextHopType> ());
+        }
+      else
+        {
+          first->alternates = m_freeAlternates.back ();
+          m_freeAlternates.pop_back ();
+        }
+    }
+
+  NextHopType nextHop = MakeNextHop (connId);
+  nextHop.cost = cost;
+  m_alternates[first->alternates].push_back (nextHop);
+  return true;
+}
+
+size_t
+AcmeFlatFib::GetNextHopCount (const NextHopType &first) const
+{
+  return first.alternates == NoAlternates ? 1 : 1 + m_alternates[first.alternates].size ();
+}
+
+AcmeFlatFib::NextHopType &
+AcmeFlatFib::GetNextHop (NextHopType &first, size_t i)
+{
+  return i == 0 ? first : m_alternates[first.alternates][i - 1];
+}
+
+const AcmeFlatFib::NextHopType &
+AcmeFlatFib::GetNextHop (const NextHopType &first, size_t i) const
+{
+  return i == 0 ? first : m_alternates[first.alternates][i - 1];
+}
+
+AcmeFlatFib::RemoveNextHopResultType
+AcmeFlatFib::RemoveNextHop (NextHopType &first, ccnx::CCNxConnection::ConnIdType connId)
+{
+  if (first.alternates == NoAlternates)
+    {
+      if (first.connId != connId)
+        {
+          return NEXT_HOP_NOT_FOUND;
+        }
+      ReleaseNextHopState (first);
+      return ROUTE_EMPTY;
+    }
+
+  uint32_t handle = first.alternates;
+  std::vector<NextHopType> &alternates = m_alternates[handle];
+  if (first.connId == connId)
+    {
+      ReleaseNextHopState (first);
+      first = alternates.front ();
+      first.alternates = handle;
+      alternates.erase (alternates.begin ());
+    }
+  else
+    {
+      std::vector<NextHopType>::iterator i = alternates.begin ();
+      while (i != alternates.end () && i->connId != connId)
+        {
+          ++i;
+        }
+      if (i == alternates.end ())
+        {
+          return NEXT_HOP_NOT_FOUND;
+        }
+      ReleaseNextHopState (*i);
+      alternates.erase (i);
+    }
+
+  if (alternates.empty ())
+    {
+      first.alternates = NoAlternates;
+      m_freeAlternates.push_back (handle);
+    }
+  return NEXT_HOP_REMOVED;
+}
+
+void
+AcmeFlatFib::AppendRoutes (const ccnx::CCNxName *name, const NextHopType &first, std::vector<RouteType> &routes) const
+{
+  size_t count = GetNextHopCount (first);
+  for (size_t i = 0; i < count; ++i)
+    {
+      const NextHopType &nextHop = GetNextHop (first, i);
+      const NextHopStateType &state = PeekNextHopState (nextHop);
+      RouteType route = { name, nextHop.connId, nextHop.cost, state.packets, state.bytes };
+      routes.push_back (route);
+    }
+}
+
+AcmeFlatFib::NextHopType *
+AcmeFlatFib::LookupRoute (Ptr<const ccnx::CCNxName> name, uint64_t digest, Ptr<const ccnx::CCNxName> &routeName)
+{
+  NextHopType *first = LookupNextHop (name, digest);
+  if (first)
+    {
+      routeName = name;
+    }
+  return first;
+}
+
+bool
+AcmeFlatFib::IsExactMatch (void) const
+{
+  return false;
+}
+
+AcmeFlatOperationCounts
+AcmeFlatFib::GetOperations (void) const
+{
+  return m_operations;
+}
+
+size_t
+AcmeFlatFib::GetNextHopMemoryUsage (void) const
+{
+  size_t bytes = m_alternates.capacity () * sizeof(std::vector<NextHopType>) + m_freeAlternates.capacity () * sizeof(uint32_t)
+    + m_states.capacity () * sizeof(NextHopStateType) + m_freeStates.capacity () * sizeof(uint32_t);
+  for (size_t i = 0; i < m_alternates.size (); ++i)
+    {
+      bytes += m_alternates[i].capacity () * sizeof(NextHopType);
+    }
+  return bytes;
+}
+
+size_t
+AcmeFlatFib::AddRoutes (const std::vector<BulkRouteType> &routes)
+{
+  size_t added = 0;
+  for (size_t i = 0; i < routes.size (); ++i)
+    {
+      if (AddRoute (routes[i].name, routes[i].digest, routes[i].connId))
+        {
+          if (routes[i].cost != 0)
+            {
+              FindRoute (routes[i].name, routes[i].digest)->cost = routes[i].cost;
+            }
+          added++;
+        }
+    }
+  return added;
+}
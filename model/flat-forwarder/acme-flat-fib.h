@@ -0,0 +1,343 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_ACMEFLATFIB_H
+#define CCNS3SIM_ACMEFLATFIB_H
+
+#include <vector>
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/ccnx-name.h"
+#include "ns3/ccnx-connection.h"
+#include "ns3/acme-flat-operation-counts.h"
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * Abstract FIB used by `AcmeFlatForwarder`.  A FIB maps a name to the
+ * connection ID of its next hop.
+ *
+ * Every call carries the name's `AcmeFlatNameDigest` so the forwarder computes it
+ * once per name and implementations that index by digest do not recompute it.
+ * Implementations that do not use the digest ignore it.
+ *
+ * The implementation is chosen with the "FibType" attribute of `AcmeFlatForwarder`
+ * (see `AcmeFlatForwarderHelper::SetFibType`).
+ *
+ * Each route stores a `NextHopType` of 16 bytes: the connection id, the cost
+ * and two handles.  What the forwarder keeps per next hop (the resolved
+ * `CCNxConnection`, counters and a round trip time) is a `NextHopStateType` in
+ * a pool in this class, allocated when the owner first asks for it, so a lookup
+ * only touches the table and routes that carry no traffic pay 4 bytes for it.
+ *
+ * A route may have several next hops (AddNextHop).  The first stays in the
+ * route; the others are kept in a pool in this class, found through the first
+ * next hop's `alternates` handle, so single-path routes pay nothing for it.
+ */
+class AcmeFlatFib : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+
+  AcmeFlatFib ();
+  virtual ~AcmeFlatFib ();
+
+  /**
+   * A next hop of a route.  The FIB sets all of it; the owner reaches its
+   * state through GetNextHopState.
+   */
+  typedef struct
+  {
+    ccnx::CCNxConnection::ConnIdType connId;
+    uint32_t cost;              //< the route metric
+    uint32_t alternates;        //< in the first next hop of a route, the handle of the others (or NoAlternates)
+    uint32_t state;             //< the handle of its NextHopStateType (or NoState)
+  } NextHopType;
+
+  static const uint32_t NoAlternates = 0xFFFFFFFF;
+  static const uint32_t NoState = 0xFFFFFFFF;
+
+  /**
+   * What the owner keeps for a next hop.  It may cache the connection of
+   * `connId` in `connection` and tag it with `epoch`, count what it forwards in
+   * `packets` and `bytes`, and keep a round trip time estimate in `rtt`; the FIB
+   * keeps them with the next hop until it is removed.  An epoch of 0 means
+   * nothing is cached, an rtt of 0 that nothing is measured.
+   */
+  typedef struct
+  {
+    Ptr<ccnx::CCNxConnection> connection;
+    uint64_t epoch;
+    uint64_t packets;
+    uint64_t bytes;
+    Time rtt;
+  } NextHopStateType;
+
+  /**
+   * @return A next hop for `connId` with cost 0 and no state
+   */
+  static NextHopType MakeNextHop (ccnx::CCNxConnection::ConnIdType connId);
+
+  /**
+   * @param [in] nextHop A next hop of this FIB, from LookupNextHop, FindRoute or GetNextHop
+   * @return The state of `nextHop`, allocated empty on first use.  Valid until
+   *         the next GetNextHopState, AddNextHop or RemoveRoute.
+   */
+  virtual NextHopStateType & GetNextHopState (NextHopType &nextHop);
+
+  /**
+   * Like GetNextHopState, but does not allocate: a next hop without state reads
+   * as empty.
+   */
+  virtual const NextHopStateType & PeekNextHopState (const NextHopType &nextHop) const;
+
+  /**
+   * Adds `connId` as a next hop of `name`, adding the route if there is none.
+   *
+   * @param [in] name The name to route
+   * @param [in] digest The AcmeFlatNameDigest of `name`
+   * @param [in] connId The next hop
+   * @param [in] cost The route metric of the next hop
+   * @return true if added, false if `connId` is already a next hop of `name`
+   */
+  virtual bool AddNextHop (Ptr<const ccnx::CCNxName> name, uint64_t digest, ccnx::CCNxConnection::ConnIdType connId, uint32_t cost);
+
+  /**
+   * @return The number of next hops of the route whose first next hop is `first`
+   */
+  virtual size_t GetNextHopCount (const NextHopType &first) const;
+
+  /**
+   * @param [in] first The first next hop of a route, from LookupNextHop or FindRoute
+   * @param [in] i In [0, GetNextHopCount (first)); 0 is `first` itself
+   * @return The `i`th next hop of the route.  Valid until the next AddNextHop or RemoveRoute.
+   */
+  virtual NextHopType & GetNextHop (NextHopType &first, size_t i);
+  virtual const NextHopType & GetNextHop (const NextHopType &first, size_t i) const;
+
+  /**
+   * Adds a route for `name` to `connId`.
+   *
+   * @param [in] name The name to route
+   * @param [in] digest The AcmeFlatNameDigest of `name`
+   * @param [in] connId The next hop
+   * @return true if added, false if the name is already in the FIB
+   */
+  virtual bool AddRoute (Ptr<const ccnx::CCNxName> name, uint64_t digest, ccnx::CCNxConnection::ConnIdType connId) = 0;
+
+  /**
+   * A route to add with AddRoutes
+   */
+  typedef struct
+  {
+    Ptr<const ccnx::CCNxName> name;
+    uint64_t digest;                            //< AcmeFlatNameDigest of `name`
+    ccnx::CCNxConnection::ConnIdType connId;
+    uint32_t cost;
+  } BulkRouteType;
+
+  /**
+   * Adds a batch of routes.  `routes` must not repeat a name; names already in
+   * the FIB are skipped.  A FIB overrides this to size its tables once for the
+   * whole batch.  The default calls AddRoute for each route.
+   *
+   * @return The number of routes added
+   */
+  virtual size_t AddRoutes (const std::vector<BulkRouteType> &routes);
+
+  /**
+   * Removes `connId` from the next hops of `name`, and the route with its last next hop.
+   *
+   * @param [in] name The name to remove
+   * @param [in] digest The AcmeFlatNameDigest of `name`
+   * @param [in] connId The next hop of the route
+   * @return true if removed, false if there was no such route
+   */
+  virtual bool RemoveRoute (Ptr<const ccnx::CCNxName> name, uint64_t digest, ccnx::CCNxConnection::ConnIdType connId) = 0;
+
+  /**
+   * Looks up the next hop for `name`.
+   *
+   * @param [in] name The name to look up
+   * @param [in] digest The AcmeFlatNameDigest of `name`
+   * @param [out] connId The next hop, if found
+   * @return true if there is a route, false otherwise
+   */
+  virtual bool Lookup (Ptr<const ccnx::CCNxName> name, uint64_t digest, ccnx::CCNxConnection::ConnIdType &connId) const = 0;
+
+  /**
+   * Looks up the next hop for `name`, so the caller can use or update its cached connection.
+   *
+   * @param [in] name The name to look up
+   * @param [in] digest The AcmeFlatNameDigest of `name`
+   * @return The next hop of the route, or null.  Valid until the next AddRoute or RemoveRoute.
+   */
+  virtual NextHopType * LookupNextHop (Ptr<const ccnx::CCNxName> name, uint64_t digest) = 0;
+
+  /**
+   * @return true if LookupNextHop only matches a route for exactly the name
+   * looked up, false if it may match a route for a prefix of it.  The default
+   * is false.
+   */
+  virtual bool IsExactMatch (void) const;
+
+  /**
+   * Like LookupNextHop, and also returns the name of the route found, which is
+   * shorter than `name` if a prefix of it matched.  The default is for an exact
+   * match FIB and returns `name` itself.
+   *
+   * @param [out] routeName The name of the route, if found
+   * @return The first next hop of the route, or null.  Valid until the next AddRoute or RemoveRoute.
+   */
+  virtual NextHopType * LookupRoute (Ptr<const ccnx::CCNxName> name, uint64_t digest, Ptr<const ccnx::CCNxName> &routeName);
+
+  /**
+   * Like LookupNextHop, but only matches a route for exactly `name`.
+   *
+   * @return The first next hop of the route, or null.  Valid until the next AddRoute or RemoveRoute.
+   */
+  virtual NextHopType * FindRoute (Ptr<const ccnx::CCNxName> name, uint64_t digest) = 0;
+
+  /**
+   * A next hop of a route as listed by GetRoutes.  `name` belongs to the FIB and
+   * is valid until the next AddRoute or RemoveRoute.
+   */
+  typedef struct
+  {
+    const ccnx::CCNxName *name;
+    ccnx::CCNxConnection::ConnIdType connId;
+    uint32_t cost;
+    uint64_t packets;
+    uint64_t bytes;
+  } RouteType;
+
+  /**
+   * Appends every next hop of every route in the FIB to `routes`, in no particular order.
+   */
+  virtual void GetRoutes (std::vector<RouteType> &routes) const = 0;
+
+  /**
+   * @return The number of routes in the FIB
+   */
+  virtual size_t GetSize (void) const = 0;
+
+  /**
+   * @return The approximate number of bytes the FIB allocated, not counting the names it shares with the caller
+   */
+  virtual size_t GetMemoryUsage (void) const = 0;
+
+  /**
+   * @return The operations the FIB has performed since it was created, for the
+   * cost model of `AcmeFlatForwarder`
+   */
+  virtual AcmeFlatOperationCounts GetOperations (void) const;
+
+protected:
+  virtual void DoDispose (void);
+
+  /**
+   * Implementations count what their lookups and insertions do here
+   */
+  mutable AcmeFlatOperationCounts m_operations;
+
+  typedef enum
+  {
+    NEXT_HOP_NOT_FOUND,
+    NEXT_HOP_REMOVED,
+    ROUTE_EMPTY         //< `connId` was the only next hop, the caller erases the route
+  } RemoveNextHopResultType;
+
+  /**
+   * Removes `connId` from the route whose first next hop is `first` and frees
+   * its state.  If it is `first` itself, the next alternate takes its place.
+   */
+  RemoveNextHopResultType RemoveNextHop (NextHopType &first, ccnx::CCNxConnection::ConnIdType connId);
+
+  /**
+   * Appends a RouteType for each next hop of the route `name`, for GetRoutes
+   */
+  void AppendRoutes (const ccnx::CCNxName *name, const NextHopType &first, std::vector<RouteType> &routes) const;
+
+  /**
+   * @return The bytes allocated for alternate next hops and next hop state, for GetMemoryUsage
+   */
+  size_t GetNextHopMemoryUsage (void) const;
+
+private:
+  /**
+   * Frees the state of `nextHop`, if it has any
+   */
+  void ReleaseNextHopState (NextHopType &nextHop);
+
+  /**
+   * The next hops after the first of each multipath route, by handle
+   */
+  std::vector<std::vector<NextHopType> > m_alternates;
+  std::vector<uint32_t> m_freeAlternates;
+
+  /**
+   * The state of the next hops that have any, by handle
+   */
+  std::vector<NextHopStateType> m_states;
+  std::vector<uint32_t> m_freeStates;
+};
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATFIB_H
@@ -56,6 +56,9 @@
 #include "ns3/log.h"
 #include "ns3/acme-flat-forwarder-helper.h"
 #include "ns3/acme-flat-forwarder.h"
+#include "ns3/acme-flat-hash-strategy.h"
+#include "ns3/acme-flat-map-fib.h"
+#include "ns3/acme-flat-name-digest.h"
 #include "ns3/ccnx-standard-pit.h"
 #include "ns3/ccnx-l3-protocol.h"
 
@@ -68,6 +71,9 @@ NS_LOG_COMPONENT_DEFINE ("AcmeFlatForwarderHelper");
 AcmeFlatForwarderHelper::AcmeFlatForwarderHelper ()
 {
   m_factory.SetTypeId (AcmeFlatForwarder::GetTypeId ());
+  m_contentStoreFactory.SetTypeId (AcmeFlatContentStore::GetTypeId ());
+  m_strategyFactory.SetTypeId (AcmeFlatHashStrategy::GetTypeId ());
+  m_fibType = AcmeFlatMapFib::GetTypeId ();
 }
 
 AcmeFlatForwarderHelper::~AcmeFlatForwarderHelper ()
@@ -81,10 +87,83 @@ AcmeFlatForwarderHelper::SetPitType (const TypeId id)
   m_factory.Set ("PitType", TypeIdValue (id));
 }
 
+void
+AcmeFlatForwarderHelper::SetFibType (const TypeId id)
+{
+  m_factory.Set ("FibType", TypeIdValue (id));
+  m_fibType = id;
+}
+
+void
+AcmeFlatForwarderHelper::SetContentStoreAttribute (std::string name, const AttributeValue &value)
+{
+  m_contentStoreFactory.Set (name, value);
+}
+
+void
+AcmeFlatForwarderHelper::SetStrategyType (const TypeId id)
+{
+  m_strategyFactory.SetTypeId (id);
+}
+
+void
+AcmeFlatForwarderHelper::SetStrategyAttribute (std::string name, const AttributeValue &value)
+{
+  m_strategyFactory.Set (name, value);
+}
+
+Ptr<AcmeFlatCongestionMarks>
+AcmeFlatForwarderHelper::GetCongestionMarks (void) const
+{
+  if (!m_congestionMarks)
+    {
+      m_congestionMarks = CreateObject<AcmeFlatCongestionMarks> ();
+    }
+  return m_congestionMarks;
+}
+
+void
+AcmeFlatForwarderHelper::SetSharedFib (Ptr<AcmeFlatFib> fib)
+{
+  m_sharedFib = fib;
+}
+
+Ptr<AcmeFlatFib>
+AcmeFlatForwarderHelper::GetSharedFib (void) const
+{
+  return m_sharedFib;
+}
+
+bool
+AcmeFlatForwarderHelper::AddSharedRoute (Ptr<const CCNxName> name, CCNxConnection::ConnIdType connId, uint32_t cost)
+{
+  if (!m_sharedFib)
+    {
+      ObjectFactory fibFactory;
+      fibFactory.SetTypeId (m_fibType);
+      m_sharedFib = fibFactory.Create<AcmeFlatFib> ();
+    }
+  return m_sharedFib->AddNextHop (name, AcmeFlatNameDigest::Compute (*name), connId, cost);
+}
+
 void
 AcmeFlatForwarderHelper::Install (Ptr<Node> node) const
 {
   Ptr<AcmeFlatForwarder> forwarder = m_factory.Create<AcmeFlatForwarder> ();
+  forwarder->SetContentStore (m_contentStoreFactory.Create<AcmeFlatContentStore> ());
+  forwarder->SetStrategy (m_strategyFactory.Create<AcmeFlatStrategy> ());
+  if (!forwarder->GetMarkingTarget ().IsZero ())
+    {
+      GetCongestionMarks ();
+    }
+  if (m_congestionMarks)
+    {
+      forwarder->SetCongestionMarks (m_congestionMarks);
+    }
+  if (m_sharedFib)
+    {
+      forwarder->SetSharedFib (m_sharedFib);
+    }
   node->AggregateObject (forwarder);
 
   Ptr<CCNxL3Protocol> ccnx = node->GetObject<CCNxL3Protocol> ();
@@ -103,3 +182,19 @@ AcmeFlatForwarderHelper::GetForwardingTypeId () const
 {
   return AcmeFlatForwarder::GetTypeId ();
 }
+
+AcmeFlatForwarderStats
+AcmeFlatForwarderHelper::GetStats (Ptr<Node> node) const
+{
+  Ptr<AcmeFlatForwarder> forwarder = node->GetObject<AcmeFlatForwarder> ();
+  NS_ASSERT_MSG (forwarder, "Got null AcmeFlatForwarder from node " << node);
+  return forwarder->GetStats ();
+}
+
+uint64_t
+AcmeFlatForwarderHelper::WriteForwardingTable (Ptr<OutputStreamWrapper> stream, Ptr<Node> node, const AcmeFlatFibWriter &writer) const
+{
+  Ptr<AcmeFlatForwarder> forwarder = node->GetObject<AcmeFlatForwarder> ();
+  NS_ASSERT_MSG (forwarder, "Got null AcmeFlatForwarder from node " << node);
+  return forwarder->PrintForwardingTable (stream, writer);
+}
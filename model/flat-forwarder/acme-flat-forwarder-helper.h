@@ -59,6 +59,11 @@
 
 #include "ns3/object-factory.h"
 #include "ns3/ccnx-forwarding-helper.h"
+#include "ns3/acme-flat-forwarder-stats.h"
+#include "ns3/acme-flat-fib-writer.h"
+#include "ns3/acme-flat-congestion-marks.h"
+#include "ns3/acme-flat-fib.h"
+#include "ns3/output-stream-wrapper.h"
 
 namespace ns3 {
 namespace acme {
@@ -71,8 +76,8 @@ namespace acme {
  * Example:
  * @code
  * {
- *     CCNxFlatForwarderHelper flatHelper;
- *     flatHelper.SetPitType(AcmePit::GetTypeId());
+ *     AcmeFlatForwarderHelper flatHelper;
+ *     flatHelper.SetPitType(AcmeFlatPit::GetTypeId());
  *
  *     CCNxStackHelper ccnx;
  *     ccnx.SetForwardingHelper(flatHelper);
@@ -89,15 +94,15 @@ public:
 
   /**
    * Sets a custom PIT implementation by its Runtime Type Id.  If not set,
-   * the forwarder will use its default PIT type.
+   * the forwarder will use its default PIT type, `AcmeFlatPit`.
    *
    * @param id The runtime type of the PIT to use
    *
    * Example:
    * @code
    * {
-   *     FlatForwarderHelper flatHelper;
-   *     flatHelper.SetPitType(AcmePit::GetTypeId());
+   *     AcmeFlatForwarderHelper flatHelper;
+   *     flatHelper.SetPitType(AcmeFlatPit::GetTypeId());
    *
    *     CCNxStackHelper ccnx;
    *     ccnx.SetForwardingHelper(flatHelper);
@@ -108,6 +113,123 @@ public:
    */
   void SetPitType (const TypeId id);
 
+  /**
+   * Sets the FIB implementation by its Runtime Type Id.  If not set, the
+   * forwarder uses `AcmeFlatMapFib`.  Use `AcmeFlatTrieFib` for longest
+   * prefix match.
+   *
+   * @param id The runtime type of the FIB to use (a subclass of `AcmeFlatFib`)
+   *
+   * Example:
+   * @code
+   * {
+   *     AcmeFlatForwarderHelper flatHelper;
+   *     flatHelper.SetFibType(AcmeFlatHashFib::GetTypeId());
+   * }
+   * @endcode
+   */
+  void SetFibType (const TypeId id);
+
+  /**
+   * Sets an attribute of the `AcmeFlatContentStore` created for each forwarder.
+   * The cache is disabled unless "ByteCapacity" is set.
+   *
+   * @param name The attribute name
+   * @param value The attribute value
+   *
+   * Example:
+   * @code
+   * {
+   *     AcmeFlatForwarderHelper flatHelper;
+   *     flatHelper.SetContentStoreAttribute ("ByteCapacity", UintegerValue (10000000));
+   *     flatHelper.SetContentStoreAttribute ("Policy", EnumValue (AcmeFlatContentStore::ARC));
+   * }
+   * @endcode
+   */
+  void SetContentStoreAttribute (std::string name, const AttributeValue &value);
+
+  /**
+   * Sets the strategy that chooses among the next hops of a multipath route by
+   * its Runtime Type Id.  If not set, the forwarder uses `AcmeFlatHashStrategy`.
+   * Use `AcmeFlatRttStrategy` to prefer the next hop with the lowest round trip time.
+   *
+   * @param id The runtime type of the strategy to use (a subclass of `AcmeFlatStrategy`)
+   *
+   * Example:
+   * @code
+   * {
+   *     AcmeFlatForwarderHelper flatHelper;
+   *     flatHelper.SetStrategyType (AcmeFlatRttStrategy::GetTypeId ());
+   *     flatHelper.SetStrategyAttribute ("ExplorationFraction", DoubleValue (0.02));
+   * }
+   * @endcode
+   */
+  void SetStrategyType (const TypeId id);
+
+  /**
+   * Sets an attribute of the strategy created for each forwarder (see SetStrategyType)
+   *
+   * @param name The attribute name
+   * @param value The attribute value
+   */
+  void SetStrategyAttribute (std::string name, const AttributeValue &value);
+
+  /**
+   * Every forwarder this helper installs shares these congestion marks, so a
+   * Content Object packet marked at one forwarder is reported as marked by the
+   * forwarders on its way downstream, and by no others.  Marking is off unless the forwarders have a
+   * "MarkingTarget".  The marks are created by the first call to this method or
+   * the first install of a forwarder with a "MarkingTarget", and are given to
+   * the forwarders installed from then on, so a network without marking does
+   * not look up marks:
+   * @code
+   * {
+   *     Config::SetDefault ("ns3::ccnx::AcmeFlatForwarder::MarkingTarget", TimeValue (MilliSeconds (5)));
+   *     AcmeFlatForwarderHelper flatHelper;
+   *     flatHelper.GetCongestionMarks ()->SetAttribute ("MarkLifetime", TimeValue (Seconds (2)));
+   * }
+   * @endcode
+   *
+   * @return The congestion marks of the forwarders installed by this helper
+   */
+  Ptr<AcmeFlatCongestionMarks> GetCongestionMarks (void) const;
+
+  /**
+   * Every forwarder this helper installs afterwards reads the routes of `fib`
+   * instead of holding its own copy, and keeps only the routes it changes
+   * (see `AcmeFlatOverlayFib`).  For large topologies where many nodes have
+   * the same routes.  A connection id in a shared route must name the same
+   * link on every node, for example the uplink when every node adds it first.
+   * Load the routes before the simulation starts and do not change them after:
+   * @code
+   * {
+   *     AcmeFlatForwarderHelper flatHelper;
+   *     flatHelper.SetFibType (AcmeFlatTrieFib::GetTypeId ());
+   *     flatHelper.AddSharedRoute (Create<CCNxName> ("ccnx:/name=acm"), 1);
+   *
+   *     CCNxStackHelper ccnx;
+   *     ccnx.SetForwardingHelper (flatHelper);
+   *     ccnx.Install (nodes);
+   * }
+   * @endcode
+   *
+   * @param fib A FIB of the same type as the forwarders' (see SetFibType), or null for none
+   */
+  void SetSharedFib (Ptr<AcmeFlatFib> fib);
+
+  /**
+   * @return The FIB shared by the forwarders installed by this helper, or null
+   */
+  Ptr<AcmeFlatFib> GetSharedFib (void) const;
+
+  /**
+   * Adds a next hop to a route of the shared FIB, creating the FIB (see
+   * SetFibType) if there is none.
+   *
+   * @return true if added, false if `connId` is already a next hop of `name`
+   */
+  bool AddSharedRoute (Ptr<const ccnx::CCNxName> name, ccnx::CCNxConnection::ConnIdType connId, uint32_t cost = 0);
+
   /**
    * This method is implemented by the concrete layer 3 helper, for example
    * inside class CCNxFlatForwarderHelper.
@@ -123,8 +245,37 @@ public:
    */
   virtual TypeId GetForwardingTypeId () const;
 
+  /**
+   * Returns the statistics of the AcmeFlatForwarder on a node
+   *
+   * @param node The node to query (must have an AcmeFlatForwarder)
+   * @return A copy of the forwarder's statistics
+   */
+  AcmeFlatForwarderStats GetStats (Ptr<Node> node) const;
+
+  /**
+   * Writes the routes of the AcmeFlatForwarder on a node selected by `writer`,
+   * for example a sampled binary dump at a checkpoint:
+   * @code
+   * {
+   *     AcmeFlatFibWriter writer;
+   *     writer.SetFormat (AcmeFlatFibWriter::BINARY);
+   *     writer.SetSampleInterval (100);
+   *     flatHelper.WriteForwardingTable (stream, node, writer);
+   * }
+   * @endcode
+   *
+   * @return The number of routes written
+   */
+  uint64_t WriteForwardingTable (Ptr<OutputStreamWrapper> stream, Ptr<Node> node, const AcmeFlatFibWriter &writer) const;
+
 private:
   ObjectFactory m_factory;
+  ObjectFactory m_contentStoreFactory;
+  ObjectFactory m_strategyFactory;
+  mutable Ptr<AcmeFlatCongestionMarks> m_congestionMarks;
+  TypeId m_fibType;
+  Ptr<AcmeFlatFib> m_sharedFib;
 };
 
 }   /* namespace ccnx */
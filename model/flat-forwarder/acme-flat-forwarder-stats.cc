@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "acme-flat-forwarder-stats.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+
+AcmeFlatForwarderStats::AcmeFlatForwarderStats ()
+  : m_interestsIn (0), m_objectsIn (0), m_interestsForwarded (0), m_interestsAggregated (0), m_interestsSatisfiedFromCache (0),
+  m_objectsForwarded (0), m_noRouteDrops (0), m_filteredNoRouteDrops (0), m_ingressEqualsEgressDrops (0), m_unsolicitedObjectDrops (0),
+  m_tailDrops (0), m_headDrops (0), m_coDelDrops (0), m_rateLimitDrops (0), m_rateLimitFlags (0),
+  m_congestionMarks (0), m_markedObjects (0)
+{
+  // empty
+}
+
+void
+AcmeFlatForwarderStats::IncrementInterestsIn (void)
+{
+  m_interestsIn++;
+}
+
+void
+AcmeFlatForwarderStats::IncrementObjectsIn (void)
+{
+  m_objectsIn++;
+}
+
+void
+AcmeFlatForwarderStats::IncrementInterestsForwarded (void)
+{
+  m_interestsForwarded++;
+}
+
+void
+AcmeFlatForwarderStats::IncrementInterestsAggregated (void)
+{
+  m_interestsAggregated++;
+}
+
+void
+AcmeFlatForwarderStats::IncrementInterestsSatisfiedFromCache (void)
+{
+  m_interestsSatisfiedFromCache++;
+}
+
+void
+AcmeFlatForwarderStats::IncrementObjectsForwarded (uint64_t egressCount)
+{
+  m_objectsForwarded += egressCount;
+}
+
+void
+AcmeFlatForwarderStats::IncrementNoRouteDrops (void)
+{
+  m_noRouteDrops++;
+}
+
+void
+AcmeFlatForwarderStats::IncrementFilteredNoRouteDrops (void)
+{
+  m_filteredNoRouteDrops++;
+}
+
+void
+AcmeFlatForwarderStats::IncrementIngressEqualsEgressDrops (void)
+{
+  m_ingressEqualsEgressDrops++;
+}
+
+void
+AcmeFlatForwarderStats::IncrementUnsolicitedObjectDrops (void)
+{
+  m_unsolicitedObjectDrops++;
+}
+
+void
+AcmeFlatForwarderStats::IncrementTailDrops (void)
+{
+  m_tailDrops++;
+}
+
+void
+AcmeFlatForwarderStats::IncrementHeadDrops (void)
+{
+  m_headDrops++;
+}
+
+void
+AcmeFlatForwarderStats::IncrementCoDelDrops (void)
+{
+  m_coDelDrops++;
+}
+
+void
+AcmeFlatForwarderStats::IncrementRateLimitDrops (void)
+{
+  m_rateLimitDrops++;
+}
+
+void
+AcmeFlatForwarderStats::IncrementRateLimitFlags (void)
+{
+  m_rateLimitFlags++;
+}
+
+void
+AcmeFlatForwarderStats::IncrementCongestionMarks (void)
+{
+  m_congestionMarks++;
+}
+
+void
+AcmeFlatForwarderStats::IncrementMarkedObjects (uint64_t egressCount)
+{
+  m_markedObjects += egressCount;
+}
+
+void
+AcmeFlatForwarderStats::RecordInputLatency (Time latency)
+{
+  m_inputLatency.Record (latency);
+}
+
+uint64_t
+AcmeFlatForwarderStats::GetInterestsIn (void) const
+{
+  return m_interestsIn;
+}
+
+uint64_t
+AcmeFlatForwarderStats::GetObjectsIn (void) const
+{
+  return m_objectsIn;
+}
+
+uint64_t
+AcmeFlatForwarderStats::GetInterestsForwarded (void) const
+{
+  return m_interestsForwarded;
+}
+
+uint64_t
+AcmeFlatForwarderStats::GetInterestsAggregated (void) const
+{
+  return m_interestsAggregated;
+}
+
+uint64_t
+AcmeFlatForwarderStats::GetInterestsSatisfiedFromCache (void) const
+{
+  return m_interestsSatisfiedFromCache;
+}
+
+uint64_t
+AcmeFlatForwarderStats::GetObjectsForwarded (void) const
+{
+  return m_objectsForwarded;
+}
+
+uint64_t
+AcmeFlatForwarderStats::GetNoRouteDrops (void) const
+{
+  return m_noRouteDrops;
+}
+
+uint64_t
+AcmeFlatForwarderStats::GetFilteredNoRouteDrops (void) const
+{
+  return m_filteredNoRouteDrops;
+}
+
+uint64_t
+AcmeFlatForwarderStats::GetIngressEqualsEgressDrops (void) const
+{
+  return m_ingressEqualsEgressDrops;
+}
+
+uint64_t
+AcmeFlatForwarderStats::GetUnsolicitedObjectDrops (void) const
+{
+  return m_unsolicitedObjectDrops;
+}
+
+uint64_t
+AcmeFlatForwarderStats::GetTailDrops (void) const
+{
+  return m_tailDrops;
+}
+
+uint64_t
+AcmeFlatForwarderStats::GetHeadDrops (void) const
+{
+  return m_headDrops;
+}
+
+uint64_t
+AcmeFlatForwarderStats::GetCoDelDrops (void) const
+{
+  return m_coDelDrops;
+}
+
+uint64_t
+AcmeFlatForwarderStats::GetRateLimitDrops (void) const
+{
+  return m_rateLimitDrops;
+}
+
+uint64_t
+AcmeFlatForwarderStats::GetRateLimitFlags (void) const
+{
+  return m_rateLimitFlags;
+}
+
+uint64_t
+AcmeFlatForwarderStats::GetCongestionMarks (void) const
+{
+  return m_congestionMarks;
+}
+
+uint64_t
+AcmeFlatForwarderStats::GetMarkedObjects (void) const
+{
+  return m_markedObjects;
+}
+
+const AcmeFlatLatencyHistogram &
+AcmeFlatForwarderStats::GetInputLatency (void) const
+{
+  return m_inputLatency;
+}
+
+AcmeFlatForwarderStats &
+AcmeFlatForwarderStats::operator+= (const AcmeFlatForwarderStats &other)
+{
+  m_interestsIn += other.m_interestsIn;
+  m_objectsIn += other.m_objectsIn;
+  m_interestsForwarded += other.m_interestsForwarded;
+  m_interestsAggregated += other.m_interestsAggregated;
+  m_interestsSatisfiedFromCache += other.m_interestsSatisfiedFromCache;
+  m_objectsForwarded += other.m_objectsForwarded;
+  m_noRouteDrops += other.m_noRouteDrops;
+  m_filteredNoRouteDrops += other.m_filteredNoRouteDrops;
+  m_ingressEqualsEgressDrops += other.m_ingressEqualsEgressDrops;
+  m_unsolicitedObjectDrops += other.m_unsolicitedObjectDrops;
+  m_tailDrops += other.m_tailDrops;
+  m_headDrops += other.m_headDrops;
+  m_coDelDrops += other.m_coDelDrops;
+  m_rateLimitDrops += other.m_rateLimitDrops;
+  m_rateLimitFlags += other.m_rateLimitFlags;
+  m_congestionMarks += other.m_congestionMarks;
+  m_markedObjects += other.m_markedObjects;
+  m_inputLatency += other.m_inputLatency;
+  return *this;
+}
+
+std::ostream &
+ns3::acme::operator<< (std::ostream &os, const AcmeFlatForwarderStats &stats)
+{
+  os << "interests in " << stats.GetInterestsIn ()
+     << " forwarded " << stats.GetInterestsForwarded ()
+     << " aggregated " << stats.GetInterestsAggregated ()
+     << " from cache " << stats.GetInterestsSatisfiedFromCache ()
+     << " no route " << stats.GetNoRouteDrops ()
+     << " filtered " << stats.GetFilteredNoRouteDrops ()
+     << " ingress=egress " << stats.GetIngressEqualsEgressDrops ()
+     << " objects in " << stats.GetObjectsIn ()
+     << " forwarded " << stats.GetObjectsForwarded ()
+     << " unsolicited " << stats.GetUnsolicitedObjectDrops ()
+     << " queue drops tail " << stats.GetTailDrops ()
+     << " head " << stats.GetHeadDrops ()
+     << " codel " << stats.GetCoDelDrops ()
+     << " rate limited dropped " << stats.GetRateLimitDrops ()
+     << " flagged " << stats.GetRateLimitFlags ()
+     << " congestion marks " << stats.GetCongestionMarks ()
+     << " marked objects " << stats.GetMarkedObjects ()
+     << " input latency " << stats.GetInputLatency ();
+  return os;
+}
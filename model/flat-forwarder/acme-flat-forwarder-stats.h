@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_ACMEFLATFORWARDERSTATS_H
+#define CCNS3SIM_ACMEFLATFORWARDERSTATS_H
+
+#include <stdint.h>
+#include <ostream>
+#include "ns3/nstime.h"
+#include "ns3/acme-flat-latency-histogram.h"
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * Packet counters and the input latency histogram of one `AcmeFlatForwarder`
+ * (see `AcmeFlatForwarder::GetStats` and `AcmeFlatForwarderHelper::GetStats`).
+ * Like `NfpStats`, the stats of several nodes add with `operator+=`:
+ *
+ * @code
+ * AcmeFlatForwarderStats total;
+ * for (NodeContainer::Iterator i = nodes.Begin (); i != nodes.End (); ++i)
+ *   {
+ *     total += flatHelper.GetStats (*i);
+ *   }
+ * @endcode
+ */
+class AcmeFlatForwarderStats
+{
+public:
+  AcmeFlatForwarderStats ();
+
+  void IncrementInterestsIn (void);
+  void IncrementObjectsIn (void);
+  void IncrementInterestsForwarded (void);
+  void IncrementInterestsAggregated (void);
+  void IncrementInterestsSatisfiedFromCache (void);
+  void IncrementObjectsForwarded (uint64_t egressCount);
+  void IncrementNoRouteDrops (void);
+  void IncrementFilteredNoRouteDrops (void);
+  void IncrementIngressEqualsEgressDrops (void);
+  void IncrementUnsolicitedObjectDrops (void);
+  void IncrementTailDrops (void);
+  void IncrementHeadDrops (void);
+  void IncrementCoDelDrops (void);
+  void IncrementRateLimitDrops (void);
+  void IncrementRateLimitFlags (void);
+  void IncrementCongestionMarks (void);
+  void IncrementMarkedObjects (uint64_t egressCount);
+
+  /**
+   * Records the time a packet spent in the input queue, waiting plus service time
+   */
+  void RecordInputLatency (Time latency);
+
+  /**
+   * @return The number of Interests received
+   */
+  uint64_t GetInterestsIn (void) const;
+
+  /**
+   * @return The number of Content Objects received
+   */
+  uint64_t GetObjectsIn (void) const;
+
+  /**
+   * @return The number of Interests forwarded by the FIB
+   */
+  uint64_t GetInterestsForwarded (void) const;
+
+  /**
+   * @return The number of Interests aggregated in the PIT (not forwarded)
+   */
+  uint64_t GetInterestsAggregated (void) const;
+
+  /**
+   * @return The number of Interests answered by the content store
+   */
+  uint64_t GetInterestsSatisfiedFromCache (void) const;
+
+  /**
+   * @return The number of Content Object copies sent (one per pending ingress)
+   */
+  uint64_t GetObjectsForwarded (void) const;
+
+  /**
+   * @return The number of Interests dropped because the FIB has no route (or its connection is gone)
+   */
+  uint64_t GetNoRouteDrops (void) const;
+
+  /**
+   * @return The number of no route drops the FIB filter found without a FIB lookup (included in GetNoRouteDrops)
+   */
+  uint64_t GetFilteredNoRouteDrops (void) const;
+
+  /**
+   * @return The number of Interests dropped because the route points back to their ingress
+   */
+  uint64_t GetIngressEqualsEgressDrops (void) const;
+
+  /**
+   * @return The number of Content Objects dropped because no PIT entry was waiting for them
+   */
+  uint64_t GetUnsolicitedObjectDrops (void) const;
+
+  /**
+   * @return The number of packets dropped on arrival to a full input queue
+   */
+  uint64_t GetTailDrops (void) const;
+
+  /**
+   * @return The number of packets dropped from the head of a full input queue to make room
+   */
+  uint64_t GetHeadDrops (void) const;
+
+  /**
+   * @return The number of packets dropped by CoDel for a standing input queue
+   */
+  uint64_t GetCoDelDrops (void) const;
+
+  /**
+   * @return The number of Interests dropped on arrival for exceeding the rate limit of their ingress
+   */
+  uint64_t GetRateLimitDrops (void) const;
+
+  /**
+   * @return The number of Interests over the rate limit of their ingress that were routed anyway
+   */
+  uint64_t GetRateLimitFlags (void) const;
+
+  /**
+   * @return The number of packets that waited longer than the marking target (met congestion)
+   */
+  uint64_t GetCongestionMarks (void) const;
+
+  /**
+   * @return The number of marked Content Object copies sent (one per egress)
+   */
+  uint64_t GetMarkedObjects (void) const;
+
+  /**
+   * @return The histogram of input queue wait plus service time
+   */
+  const AcmeFlatLatencyHistogram & GetInputLatency (void) const;
+
+  AcmeFlatForwarderStats & operator+= (const AcmeFlatForwarderStats &other);
+
+private:
+  uint64_t m_interestsIn;
+  uint64_t m_objectsIn;
+  uint64_t m_interestsForwarded;
+  uint64_t m_interestsAggregated;
+  uint64_t m_interestsSatisfiedFromCache;
+  uint64_t m_objectsForwarded;
+  uint64_t m_noRouteDrops;
+  uint64_t m_filteredNoRouteDrops;
+  uint64_t m_ingressEqualsEgressDrops;
+  uint64_t m_unsolicitedObjectDrops;
+  uint64_t m_tailDrops;
+  uint64_t m_headDrops;
+  uint64_t m_coDelDrops;
+  uint64_t m_rateLimitDrops;
+  uint64_t m_rateLimitFlags;
+  uint64_t m_congestionMarks;
+  uint64_t m_markedObjects;
+  AcmeFlatLatencyHistogram m_inputLatency;
+};
+
+std::ostream & operator<< (std::ostream &os, const AcmeFlatForwarderStats &stats);
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATFORWARDERSTATS_H
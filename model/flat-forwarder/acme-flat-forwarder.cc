@@ -53,17 +53,31 @@
  * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
  */
 /*
- * Temporary FIB for initial testing.  Needs to be replaced.  Only does exact match.  Only single path routing.
- *    m_fib: CCNxName -> ConnId
+ * Exact match (or longest prefix match with AcmeFlatTrieFib).  Only single path routing.
+ *    m_fib: CCNxName -> (ConnId, cached connection), implementation selected by the "FibType" attribute
+ *    m_pit: CCNxName -> { ingress ConnId }, so objects follow the reverse path
+ *    m_contentStore: CCNxName -> Content Object, byte-limited
  *
 
  */
+#include <algorithm>
 #include "acme-flat-forwarder.h"
 
 #include "ns3/log.h"
 #include "ns3/assert.h"
 #include "ns3/ccnx-l3-protocol.h"
 #include "ns3/integer.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
+#include "ns3/object-factory.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include "ns3/acme-flat-name-digest.h"
+#include "ns3/acme-flat-packet-log.h"
+#include "ns3/acme-flat-map-fib.h"
+#include "ns3/acme-flat-hash-strategy.h"
 
 using namespace ns3;
 using namespace ns3::acme;
@@ -75,6 +89,7 @@ NS_OBJECT_ENSURE_REGISTERED (AcmeFlatForwarder);
 static const Time _defaultLayerDelayConstant = MicroSeconds (1);
 static const Time _defaultLayerDelaySlope = Seconds (0);
 static unsigned _defaultLayerDelayServers = 1;
+static const Time _defaultPitTimerTick = MilliSeconds (1);
 
 TypeId
 AcmeFlatForwarder::GetTypeId (void)
@@ -95,13 +110,141 @@ AcmeFlatForwarder::GetTypeId (void)
                    IntegerValue (_defaultLayerDelayServers),
                    MakeIntegerAccessor (&AcmeFlatForwarder::m_layerDelayServers),
                    MakeIntegerChecker<unsigned> ())
+    .AddAttribute ("Cores", "The number of simulated cores, each with its own input queue fed by name hash (0 for one shared queue)",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&AcmeFlatForwarder::m_cores),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("BatchSize", "The most packets a server takes from the input queue at once (0 or 1 for one at a time)",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&AcmeFlatForwarder::m_batchSize),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("BatchDelayConstant", "The fixed delay of a batch, on top of the layer delay of each of its packets",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&AcmeFlatForwarder::m_batchDelayConstant),
+                   MakeTimeChecker ())
+    .AddAttribute ("MaxInputQueueDepth", "The most packets waiting in each input queue (0 for no limit)",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&AcmeFlatForwarder::m_maxInputQueueDepth),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("InputQueueDropPolicy", "How a bounded input queue drops packets",
+                   EnumValue (AcmeFlatBatchQueue::TAIL_DROP),
+                   MakeEnumAccessor (&AcmeFlatForwarder::m_inputQueueDropPolicy),
+                   MakeEnumChecker (AcmeFlatBatchQueue::TAIL_DROP, "TailDrop",
+                                    AcmeFlatBatchQueue::HEAD_DROP, "HeadDrop",
+                                    AcmeFlatBatchQueue::CODEL, "CoDel"))
+    .AddAttribute ("CoDelTarget", "The acceptable input queue sojourn time of the CoDel drop policy",
+                   TimeValue (MilliSeconds (5)),
+                   MakeTimeAccessor (&AcmeFlatForwarder::m_coDelTarget),
+                   MakeTimeChecker ())
+    .AddAttribute ("CoDelInterval", "How long the sojourn time must stay above CoDelTarget before CoDel drops",
+                   TimeValue (MilliSeconds (100)),
+                   MakeTimeAccessor (&AcmeFlatForwarder::m_coDelInterval),
+                   MakeTimeChecker ())
+    .AddAttribute ("InputQueueScheduler", "The order waiting packets are served in: arrival order, or deficit round robin across ingress connections",
+                   EnumValue (AcmeFlatBatchQueue::FIFO),
+                   MakeEnumAccessor (&AcmeFlatForwarder::m_inputQueueScheduler),
+                   MakeEnumChecker (AcmeFlatBatchQueue::FIFO, "FIFO",
+                                    AcmeFlatBatchQueue::DRR, "DRR"))
+    .AddAttribute ("DrrQuantum", "The bytes an ingress connection of weight 1 may send per DRR round",
+                   UintegerValue (1500),
+                   MakeUintegerAccessor (&AcmeFlatForwarder::m_drrQuantum),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("InterestRateLimit", "The Interests per second accepted from each ingress connection (0 for no limit)",
+                   DoubleValue (0),
+                   MakeDoubleAccessor (&AcmeFlatForwarder::m_interestRateLimit),
+                   MakeDoubleChecker<double> (0))
+    .AddAttribute ("InterestBurstLimit", "The most Interests an ingress connection may send back to back within InterestRateLimit",
+                   UintegerValue (32),
+                   MakeUintegerAccessor (&AcmeFlatForwarder::m_interestBurstLimit),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("InterestRateLimitAction", "What to do with an Interest over InterestRateLimit",
+                   EnumValue (AcmeFlatForwarder::RATE_LIMIT_DROP),
+                   MakeEnumAccessor (&AcmeFlatForwarder::m_interestRateLimitAction),
+                   MakeEnumChecker (AcmeFlatForwarder::RATE_LIMIT_DROP, "Drop",
+                                    AcmeFlatForwarder::RATE_LIMIT_FLAG, "Flag"))
+    .AddAttribute ("MarkingTarget", "The input queue sojourn time above which a packet marks its Content Object as congested (0 for no marking)",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&AcmeFlatForwarder::m_markingTarget),
+                   MakeTimeChecker ())
+    .AddAttribute ("HotNames", "The number of most requested names to report (0 to not count names)",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&AcmeFlatForwarder::m_hotNameCount),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("HotNameSketchWidth", "The counters per row of the Count-Min sketch of Interest names",
+                   UintegerValue (4096),
+                   MakeUintegerAccessor (&AcmeFlatForwarder::m_hotNameSketchWidth),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("HotNameSketchDepth", "The rows of the Count-Min sketch of Interest names",
+                   UintegerValue (4),
+                   MakeUintegerAccessor (&AcmeFlatForwarder::m_hotNameSketchDepth),
+                   MakeUintegerChecker<uint32_t> (1, 8))
+    .AddAttribute ("FibFilterCountersPerRoute", "The counters per route of a Bloom filter of FIB names checked before each Interest's FIB lookup (0 for no filter)",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&AcmeFlatForwarder::m_fibFilterCountersPerRoute),
+                   MakeUintegerChecker<uint32_t> (0, 64))
+    .AddAttribute ("NameTableCapacity", "The number of names no table uses that the name table keeps (0 to not intern names)",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&AcmeFlatForwarder::m_nameTableCapacity),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("ProbeDelay", "The service time of each table probe (hash slot, tree node or trie edge examined)",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&AcmeFlatForwarder::m_probeDelay),
+                   MakeTimeChecker ())
+    .AddAttribute ("SegmentCompareDelay", "The service time of each name segment compared in a table lookup",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&AcmeFlatForwarder::m_segmentCompareDelay),
+                   MakeTimeChecker ())
+    .AddAttribute ("InsertionDelay", "The service time of each table insertion",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&AcmeFlatForwarder::m_insertionDelay),
+                   MakeTimeChecker ())
+    .AddAttribute ("FibType", "The TypeId of the AcmeFlatFib implementation",
+                   TypeIdValue (AcmeFlatMapFib::GetTypeId ()),
+                   MakeTypeIdAccessor (&AcmeFlatForwarder::m_fibType),
+                   MakeTypeIdChecker ())
+    .AddAttribute ("PitType", "The TypeId of the AcmeFlatPit implementation",
+                   TypeIdValue (AcmeFlatPit::GetTypeId ()),
+                   MakeTypeIdAccessor (&AcmeFlatForwarder::m_pitType),
+                   MakeTypeIdChecker ())
+    .AddAttribute ("PitTimerTick", "The granularity of PIT entry expiry (one simulator event per occupied tick)",
+                   TimeValue (_defaultPitTimerTick),
+                   MakeTimeAccessor (&AcmeFlatForwarder::m_pitTimerTick),
+                   MakeTimeChecker (NanoSeconds (1)))
+    .AddAttribute ("TraceSampleInterval", "Fire the SampledRoute trace for 1 in N routed packets (0 disables it)",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&AcmeFlatForwarder::m_traceSampleInterval),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddTraceSource ("SampledRoute", "A routed packet, 1 in TraceSampleInterval",
+                     MakeTraceSourceAccessor (&AcmeFlatForwarder::m_sampledRouteTrace),
+                     "ns3::acme::AcmeFlatForwarder::SampledRouteTracedCallback")
+    .AddTraceSource ("InputQueueDrop", "A packet dropped by a bounded input queue",
+                     MakeTraceSourceAccessor (&AcmeFlatForwarder::m_inputQueueDropTrace),
+                     "ns3::acme::AcmeFlatForwarder::InputQueueDropTracedCallback")
+    .AddTraceSource ("InterestRateLimited", "An Interest over the rate limit of its ingress connection",
+                     MakeTraceSourceAccessor (&AcmeFlatForwarder::m_interestRateLimitedTrace),
+                     "ns3::acme::AcmeFlatForwarder::InterestRateLimitedTracedCallback")
+    .AddTraceSource ("CongestionMarked", "A Content Object of a congested name, once per egress connection",
+                     MakeTraceSourceAccessor (&AcmeFlatForwarder::m_congestionMarkedTrace),
+                     "ns3::acme::AcmeFlatForwarder::CongestionMarkedTracedCallback")
   ;
   return tid;
 }
 
 AcmeFlatForwarder::AcmeFlatForwarder ()
-  :     m_layerDelayConstant (_defaultLayerDelayConstant), m_layerDelaySlope (_defaultLayerDelaySlope),
-  m_layerDelayServers (_defaultLayerDelayServers)
+  : m_fibType (AcmeFlatMapFib::GetTypeId ()), m_connectionEpoch (1), m_nextHopResolutions (0), m_bulkLoad (),
+  m_fibFilterCountersPerRoute (0), m_fibFilter (1, 1), m_nameTableCapacity (0), m_names (0),
+  m_pitType (AcmeFlatPit::GetTypeId ()),
+  m_pitTimerTick (_defaultPitTimerTick), m_pitTimerEventTick (AcmeFlatTimerWheel::Never),
+  m_pitTimersStarted (0), m_pitTimerEvents (0), m_pitEntriesExpired (0),
+  m_layerDelayConstant (_defaultLayerDelayConstant), m_layerDelaySlope (_defaultLayerDelaySlope),
+  m_layerDelayServers (_defaultLayerDelayServers), m_cores (0), m_batchSize (0), m_costModel (false),
+  m_maxInputQueueDepth (0), m_inputQueueDropPolicy (AcmeFlatBatchQueue::TAIL_DROP),
+  m_coDelTarget (MilliSeconds (5)), m_coDelInterval (MilliSeconds (100)),
+  m_inputQueueScheduler (AcmeFlatBatchQueue::FIFO), m_drrQuantum (1500),
+  m_interestRateLimit (0), m_interestBurstLimit (32), m_interestRateLimitAction (RATE_LIMIT_DROP),
+  m_markingTarget (Seconds (0)),
+  m_hotNameCount (0), m_hotNameSketchWidth (4096), m_hotNameSketchDepth (4), m_hotNames (1, 1, 0), m_poolStats (),
+  m_traceSampleInterval (0), m_traceSampleCount (0)
 {
   // empty
 }
@@ -115,7 +258,40 @@ void
 AcmeFlatForwarder::DoDispose (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  // empty
+  Simulator::Cancel (m_pitTimerEvent);
+  m_pitTimerEventTick = AcmeFlatTimerWheel::Never;
+  m_pitTimers.Clear ();
+  m_freeWorkItems.clear ();
+  m_freeConnectionLists.clear ();
+  m_spareEgressNodes.clear ();
+  m_coreQueues.clear ();
+  m_batchQueues.clear ();
+  m_connectionRoutes.Clear ();
+  m_congestionMarks = 0;
+  m_names = AcmeFlatNameTable (0);
+  m_sharedFib = 0;
+  m_overlayFib = 0;
+
+  if (m_fib)
+    {
+      m_fib->Dispose ();
+      m_fib = 0;
+    }
+  if (m_pit)
+    {
+      m_pit->Dispose ();
+      m_pit = 0;
+    }
+  if (m_contentStore)
+    {
+      m_contentStore->Dispose ();
+      m_contentStore = 0;
+    }
+  if (m_strategy)
+    {
+      m_strategy->Dispose ();
+      m_strategy = 0;
+    }
 }
 
 void
@@ -123,231 +299,1382 @@ AcmeFlatForwarder::DoInitialize (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
 
+  m_costModel = !m_probeDelay.IsZero () || !m_segmentCompareDelay.IsZero () || !m_insertionDelay.IsZero ();
+
   m_inputQueue = Create<DelayQueueType> (m_layerDelayServers,
                                          MakeCallback (&AcmeFlatForwarder::GetServiceTime, this),
                                          MakeCallback (&AcmeFlatForwarder::ServiceInputQueue, this));
+
+  // Only the batch queue can bound its depth
+  bool bounded = m_maxInputQueueDepth > 0 || m_inputQueueDropPolicy == AcmeFlatBatchQueue::CODEL;
+  bool batchQueues = m_batchSize > 1 || bounded || m_inputQueueScheduler != AcmeFlatBatchQueue::FIFO;
+
+  m_coresStarted = Simulator::Now ();
+  for (uint32_t core = 0; core < m_cores; ++core)
+    {
+      if (!batchQueues)
+        {
+          m_coreQueues.push_back (Create<DelayQueueType> (1,
+                                                          MakeCallback (&AcmeFlatForwarder::GetServiceTime, this),
+                                                          MakeCallback (&AcmeFlatForwarder::ServiceInputQueue, this)));
+        }
+      CoreStatsType stats = { 0, 0, 0, Time (0), Time (0), Simulator::Now () };
+      m_coreStats.push_back (stats);
+    }
+
+  if (batchQueues)
+    {
+      // One shared queue with m_layerDelayServers servers, or a single-server queue per core
+      uint32_t queues = m_cores > 0 ? m_cores : 1;
+      unsigned servers = m_cores > 0 ? 1 : m_layerDelayServers;
+      for (uint32_t i = 0; i < queues; ++i)
+        {
+          Ptr<AcmeFlatBatchQueue> queue = Create<AcmeFlatBatchQueue> (servers, m_batchSize,
+                                                                      MakeCallback (&AcmeFlatForwarder::GetBatchServiceTime, this),
+                                                                      MakeCallback (&AcmeFlatForwarder::ServiceInputQueue, this));
+          if (bounded)
+            {
+              queue->SetLimit (m_maxInputQueueDepth, m_inputQueueDropPolicy,
+                               MakeCallback (&AcmeFlatForwarder::InputQueueDrop, this));
+              queue->SetCoDel (m_coDelTarget, m_coDelInterval);
+            }
+          queue->SetScheduler (m_inputQueueScheduler, m_drrQuantum);
+          for (IngressWeightMapType::const_iterator j = m_ingressWeights.begin (); j != m_ingressWeights.end (); ++j)
+            {
+              queue->SetWeight (j->first, j->second);
+            }
+          m_batchQueues.push_back (queue);
+        }
+    }
+
+  ObjectFactory fibFactory;
+  fibFactory.SetTypeId (m_fibType);
+  m_fib = fibFactory.Create<AcmeFlatFib> ();
+  if (m_sharedFib)
+    {
+      m_overlayFib = CreateObject<AcmeFlatOverlayFib> ();
+      m_overlayFib->SetFibs (m_sharedFib, m_fib);
+      m_fib = m_overlayFib;
+    }
+
+  ObjectFactory pitFactory;
+  pitFactory.SetTypeId (m_pitType);
+  m_pit = pitFactory.Create<AcmeFlatPit> ();
+  m_pit->SetExpiredCallback (MakeCallback (&AcmeFlatForwarder::PitEntryExpired, this));
+
+  if (!m_contentStore)
+    {
+      m_contentStore = CreateObject<AcmeFlatContentStore> ();
+    }
+
+  if (!m_strategy)
+    {
+      m_strategy = CreateObject<AcmeFlatHashStrategy> ();
+    }
+
+  if (m_fibFilterCountersPerRoute > 0)
+    {
+      m_fibFilter = AcmeFlatBloomFilter (1024, m_fibFilterCountersPerRoute);
+      if (m_sharedFib)
+        {
+          RebuildFibFilter ();
+        }
+    }
+
+  if (m_nameTableCapacity > 0)
+    {
+      m_names = AcmeFlatNameTable (m_nameTableCapacity);
+    }
+
+  if (m_hotNameCount > 0)
+    {
+      m_hotNames = AcmeFlatHeavyHitters (m_hotNameSketchWidth, m_hotNameSketchDepth, m_hotNameCount);
+    }
+
+  if (!m_congestionMarks && !m_markingTarget.IsZero ())
+    {
+      m_congestionMarks = CreateObject<AcmeFlatCongestionMarks> ();
+    }
 }
 
-Time
-AcmeFlatForwarder::GetServiceTime (Ptr<CCNxStandardForwarderWorkItem> item)
+void
+AcmeFlatForwarder::SetContentStore (Ptr<AcmeFlatContentStore> contentStore)
 {
-  Time delay = m_layerDelayConstant + m_layerDelaySlope * item->GetPacket ()->GetFixedHeader ()->GetPacketLength ();
-  return delay;
+  m_contentStore = contentStore;
 }
 
-void
-AcmeFlatForwarder::RouteOutput (Ptr<CCNxPacket> packet,
-                                Ptr<CCNxConnection> ingressConnection,
-                                Ptr<CCNxConnection> egressConnection)
+Ptr<AcmeFlatContentStore>
+AcmeFlatForwarder::GetContentStore (void) const
 {
-  NS_LOG_FUNCTION (this << packet << ingressConnection);
-  Ptr<CCNxStandardForwarderWorkItem> item = Create<CCNxStandardForwarderWorkItem> (packet, ingressConnection, egressConnection);
-  m_inputQueue->push_back (item);
+  return m_contentStore;
 }
 
 void
-AcmeFlatForwarder::RouteInput (Ptr<CCNxPacket> packet,
-                               Ptr<CCNxConnection> ingressConnection)
+AcmeFlatForwarder::SetStrategy (Ptr<AcmeFlatStrategy> strategy)
 {
-  NS_LOG_FUNCTION (this << packet << ingressConnection);
-  Ptr<CCNxStandardForwarderWorkItem> item = Create<CCNxStandardForwarderWorkItem> (packet, ingressConnection, Ptr<CCNxConnection> (0));
-  m_inputQueue->push_back (item);
+  m_strategy = strategy;
 }
 
-void
-AcmeFlatForwarder::ServiceInputQueue (Ptr<CCNxStandardForwarderWorkItem> item)
+Ptr<AcmeFlatStrategy>
+AcmeFlatForwarder::GetStrategy (void) const
 {
-  NS_LOG_FUNCTION (this << item->GetPacket () << item->GetIngressConnection () << item->GetEgressConnection ());
+  return m_strategy;
+}
 
-  Ptr<CCNxConnection> egress = InnerReceive (item);
+Time
+AcmeFlatForwarder::GetLayerDelay (Ptr<AcmeFlatWorkItem> item) const
+{
+  return m_layerDelayConstant + m_layerDelaySlope * item->GetPacket ()->GetFixedHeader ()->GetPacketLength ();
+}
 
-  if (item->GetEgressConnection ())
+Time
+AcmeFlatForwarder::GetServiceTime (Ptr<AcmeFlatWorkItem> item)
+{
+  Time delay = GetLayerDelay (item);
+  if (m_costModel)
     {
-      // User specified an egressFromUser connection, so use that.
-      item->SetRouteError (CCNxRoutingError::CCNxRoutingError_NoError);
-      NS_LOG_DEBUG (": user has overridden fib lookup");
-      egress = item->GetEgressConnection ();
+      delay += RouteWorkItem (item);
     }
+  if (!m_coreStats.empty ())
+    {
+      m_coreStats[item->GetCore ()].busy += delay;
+    }
+  return delay;
+}
 
-  Ptr<CCNxConnectionList> connections = Create<CCNxConnectionList> ();
-
-  if (egress)
+Time
+AcmeFlatForwarder::GetBatchServiceTime (const AcmeFlatBatchQueue::BatchType &batch)
+{
+  Time delay = m_batchDelayConstant;
+  for (AcmeFlatBatchQueue::BatchType::const_iterator i = batch.begin (); i != batch.end (); ++i)
+    {
+      if (m_inputQueueScheduler == AcmeFlatBatchQueue::DRR)
+        {
+          m_ingressWaits[(*i)->GetIngressConnection ()->GetConnectionId ()].Record (Simulator::Now () - (*i)->GetArrivalTime ());
+        }
+      delay += GetLayerDelay (*i);
+      if (m_costModel)
+        {
+          delay += RouteWorkItem (*i);
+        }
+    }
+  if (!m_coreStats.empty ())
     {
-      connections->push_back (egress);
+      // A batch comes from one queue, so one core
+      m_coreStats[batch.front ()->GetCore ()].busy += delay;
     }
+  return delay;
+}
 
+Time
+AcmeFlatForwarder::RouteWorkItem (Ptr<AcmeFlatWorkItem> item)
+{
+  AcmeFlatOperationCounts before = GetOperations ();
+  Ptr<CCNxConnectionList> connections = AllocateConnectionList ();
+  item->SetRoutedPacket (InnerReceive (item, connections));
   item->SetConnectionsList (connections);
+  AcmeFlatOperationCounts performed = GetOperations () - before;
 
-  NS_LOG_DEBUG ("RouteOutput(packet=" << *item->GetPacket () << ", from " << item->GetIngressConnection ()->GetConnectionId ()
-                                      << ",  will be fwded to " << connections->size () << " destinations");
+  Time delay = m_probeDelay * static_cast<int64_t> (performed.probes)
+    + m_segmentCompareDelay * static_cast<int64_t> (performed.segmentCompares)
+    + m_insertionDelay * static_cast<int64_t> (performed.insertions);
+  m_operationsDelay += delay;
+  return delay;
+}
 
-  if (connections->size () > 0)
+void
+AcmeFlatForwarder::EnqueueWorkItem (Ptr<AcmeFlatWorkItem> item)
+{
+  uint32_t core = 0;
+  if (!m_coreStats.empty ())
     {
-      NS_LOG_DEBUG ("first destination is " << connections->front ()->GetConnectionId () );
+      // The same name always lands on the same core; InnerReceive reuses the digest
+      uint64_t digest = AcmeFlatNameDigest::Compute (*item->GetPacket ()->GetMessage ()->GetName ());
+      core = static_cast<uint32_t> (((digest >> 32) * m_coreStats.size ()) >> 32);
+      item->SetNameDigest (digest);
+      item->SetCore (core);
+      m_coreStats[core].items++;
+      ChangeCoreDepth (core, 1);
     }
 
-  m_routeCallback (item->GetPacket (), item->GetIngressConnection (), item->GetRouteError (), item->GetConnectionsList ());
+  if (!m_batchQueues.empty ())
+    {
+      m_batchQueues[core]->Enqueue (item);
+    }
+  else if (!m_coreQueues.empty ())
+    {
+      m_coreQueues[core]->push_back (item);
+    }
+  else
+    {
+      m_inputQueue->push_back (item);
+    }
 }
 
-Ptr<CCNxConnection>
-AcmeFlatForwarder::InnerReceive (Ptr<CCNxStandardForwarderWorkItem> item)
+void
+AcmeFlatForwarder::InputQueueDrop (Ptr<AcmeFlatWorkItem> item, AcmeFlatBatchQueue::DropPolicyType policy)
 {
-  NS_LOG_FUNCTION (this << item->GetPacket () << item->GetIngressConnection ());
+  ACME_FLAT_PACKET_LOG_DEBUG ("Input queue drop " << policy << " of " << *item->GetPacket ());
 
-  Ptr<CCNxConnection> egress;
-  switch (item->GetPacket ()->GetFixedHeader ()->GetPacketType ())
+  if (!m_coreStats.empty ())
     {
-    case CCNxFixedHeaderType_Interest:
-      egress = ForwardInterest (item->GetPacket (), item->GetIngressConnection ());
-      break;
+      ChangeCoreDepth (item->GetCore (), -1);
+    }
 
-    case CCNxFixedHeaderType_Object:
-      egress = ForwardContentObject (item->GetPacket (), item->GetIngressConnection ());
+  switch (policy)
+    {
+    case AcmeFlatBatchQueue::TAIL_DROP:
+      m_stats.IncrementTailDrops ();
+      break;
+    case AcmeFlatBatchQueue::HEAD_DROP:
+      m_stats.IncrementHeadDrops ();
+      break;
+    case AcmeFlatBatchQueue::CODEL:
+      m_stats.IncrementCoDelDrops ();
       break;
-
-    default:
-      NS_ASSERT_MSG (false, "Unsupported packetType");
     }
-  NS_LOG_INFO ("Route " << item->GetPacket ()->GetMessage ()->GetName () << " egress " << egress);
-  return egress;
+
+  m_inputQueueDropTrace (item->GetPacket (), item->GetIngressConnection (), policy);
+  ReleaseWorkItem (item);
 }
 
-Ptr<CCNxConnection>
-AcmeFlatForwarder::ForwardInterest (Ptr<CCNxPacket> packet, Ptr<CCNxConnection> ingress)
+void
+AcmeFlatForwarder::SetIngressWeight (CCNxConnection::ConnIdType connId, uint32_t weight)
 {
-  NS_LOG_FUNCTION (this << packet << ingress);
-  NS_LOG_INFO ("Forwarding " << *packet);
-
-  Ptr<CCNxConnection> result = Ptr<CCNxConnection> (0);
-
-  FibMapType::const_iterator i = m_fib.find (packet->GetMessage ()->GetName ());
-  if (i == m_fib.end ())
-    {
-      NS_LOG_INFO ("No route in FIB : " << *packet->GetMessage ()->GetName ());
-      // DROP
-    }
-  else
+  m_ingressWeights[connId] = weight;
+  for (size_t i = 0; i < m_batchQueues.size (); ++i)
     {
-      if (i->second != ingress->GetConnectionId ())
-        {
-          Ptr<CCNxConnection> connection = m_ccnx->GetConnection (i->second);
-          if (connection)
-            {
-              NS_LOG_INFO ("Route found, packet forward to connid " << connection->GetConnectionId ());
-            }
-          else
-            {
-              NS_LOG_INFO ("Could not resolve CCNxL3Protocol connection for connid " << i->second);
-            }
-          result = connection;
-        }
-      else
-        {
-          NS_LOG_INFO ("Egress is same as ingress connid " << i->second << " : no route");
-        }
+      m_batchQueues[i]->SetWeight (connId, weight);
     }
-  return result;
 }
 
-Ptr<CCNxConnection>
-AcmeFlatForwarder::ForwardContentObject (Ptr<CCNxPacket> packet, Ptr<CCNxConnection> ingress)
+const AcmeFlatForwarder::IngressWaitMapType &
+AcmeFlatForwarder::GetIngressWaits (void) const
+{
+  return m_ingressWaits;
+}
+
+void
+AcmeFlatForwarder::SetCongestionMarks (Ptr<AcmeFlatCongestionMarks> marks)
 {
-  NS_LOG_FUNCTION (this << packet << ingress);
+  m_congestionMarks = marks;
+}
 
-  NS_LOG_INFO ("Forwarding " << *packet);
+Ptr<AcmeFlatCongestionMarks>
+AcmeFlatForwarder::GetCongestionMarks (void) const
+{
+  return m_congestionMarks;
+}
 
-  // TODO: The CS/PIT/FIB lookups
-  return (Ptr<CCNxConnection>) 0;
+Time
+AcmeFlatForwarder::GetMarkingTarget (void) const
+{
+  return m_markingTarget;
 }
 
-// =========
-// Fake FIB section
+void
+AcmeFlatForwarder::SetSharedFib (Ptr<AcmeFlatFib> fib)
+{
+  NS_ASSERT_MSG (!m_fib, "SetSharedFib must be called before the forwarder is initialized");
+  m_sharedFib = fib;
+}
 
-bool
-AcmeFlatForwarder::AddRoute (CCNxConnection::ConnIdType connId, Ptr<const CCNxName> name)
+void
+AcmeFlatForwarder::MarkContentObject (Ptr<CCNxPacket> packet, bool marked, Ptr<CCNxConnectionList> egress)
 {
-  NS_LOG_FUNCTION (this << connId << name);
+  if (!m_congestionMarks || egress->empty ())
+    {
+      return;
+    }
 
-  if (connId != CCNxConnection::ConnIdLocalHost)
+  if (!marked)
     {
-      FibMapType::const_iterator j = m_fib.find (name);
-      NS_ASSERT_MSG (j == m_fib.end (), "Name already exits in FIB " << *name);
+      // A packet from the content store may still carry the mark of an earlier trip
+      m_congestionMarks->Unmark (packet);
+      return;
+    }
 
-      m_fib[name] = connId;
+  m_congestionMarks->Mark (packet, Simulator::Now ());
+  m_stats.IncrementMarkedObjects (egress->size ());
+  for (CCNxConnectionList::const_iterator i = egress->begin (); i != egress->end (); ++i)
+    {
+      m_congestionMarkedTrace (packet, *i);
+    }
+}
 
-      NS_LOG_INFO ("AddRoute connId " << connId << " name " << *name);
+bool
+AcmeFlatForwarder::ConformsToRateLimit (Ptr<CCNxPacket> packet, Ptr<CCNxConnection> ingress)
+{
+  if (m_interestRateLimit <= 0 || packet->GetFixedHeader ()->GetPacketType () != CCNxFixedHeaderType_Interest)
+    {
       return true;
     }
-  else
+
+  IngressRateLimitMapType::iterator bucket = m_ingressRateLimits.find (ingress->GetConnectionId ());
+  if (bucket == m_ingressRateLimits.end ())
     {
-      return false;
+      AcmeFlatTokenBucket full (m_interestRateLimit, m_interestBurstLimit);
+      bucket = m_ingressRateLimits.insert (std::make_pair (ingress->GetConnectionId (), full)).first;
+    }
+
+  if (bucket->second.Consume (Simulator::Now ()))
+    {
+      return true;
     }
 
+  ACME_FLAT_PACKET_LOG_DEBUG ("Interest over the rate limit of connection " << ingress->GetConnectionId ());
+  m_interestRateLimitedTrace (packet, ingress, m_interestRateLimitAction);
+  if (m_interestRateLimitAction == RATE_LIMIT_FLAG)
+    {
+      m_stats.IncrementRateLimitFlags ();
+      return true;
+    }
+  m_stats.IncrementRateLimitDrops ();
+  return false;
 }
 
-bool
-AcmeFlatForwarder::AddRoute (Ptr<CCNxConnection> connection, Ptr<const CCNxName> name)
+const AcmeFlatForwarder::IngressRateLimitMapType &
+AcmeFlatForwarder::GetIngressRateLimits (void) const
 {
-  NS_LOG_FUNCTION (this << connection << name);
-  return AddRoute (connection->GetConnectionId (), name);
+  return m_ingressRateLimits;
 }
 
-bool
-AcmeFlatForwarder::AddRoute (Ptr<const CCNxRoute> route)
+const AcmeFlatHeavyHitters &
+AcmeFlatForwarder::GetHotNames (void) const
 {
-  NS_LOG_FUNCTION (this << route);
-  bool added = false;
-  for (CCNxRoute::const_iterator i = route->begin (); i != route->end (); ++i)
-    {
-      added |= AddRoute (i->GetConnection ()->GetConnectionId (), i->GetPrefix ());
-    }
-  return added;
+  return m_hotNames;
 }
 
+const AcmeFlatBloomFilter &
+AcmeFlatForwarder::GetFibFilter (void) const
+{
+  return m_fibFilter;
+}
 
-bool
-AcmeFlatForwarder::RemoveRoute (CCNxConnection::ConnIdType connId, Ptr<const CCNxName> name)
+const AcmeFlatNameTable &
+AcmeFlatForwarder::GetNameTable (void) const
 {
-  NS_LOG_FUNCTION (this << connId << name);
-  FibMapType::iterator j = m_fib.find (name);
-  if (j != m_fib.end () && (j->second == connId))
+  return m_names;
+}
+
+Ptr<const CCNxName>
+AcmeFlatForwarder::InternName (Ptr<const CCNxName> name, uint64_t digest)
+{
+  if (m_nameTableCapacity == 0)
     {
-      m_fib.erase (j);
-      NS_LOG_INFO ("RemoveRoute connection " << connId << " name " << *name);
-      return true;
+      return name;
     }
-  return false;
+  return m_names.GetName (m_names.Intern (name, digest));
 }
 
-bool
-AcmeFlatForwarder::RemoveRoute (Ptr<CCNxConnection> connection, Ptr<const CCNxName> name)
+void
+AcmeFlatForwarder::ChangeCoreDepth (uint32_t core, int64_t delta)
 {
-  NS_LOG_FUNCTION (this << connection << name);
-  return RemoveRoute (connection->GetConnectionId (), name);
+  CoreStatsType &stats = m_coreStats[core];
+  Time now = Simulator::Now ();
+  stats.depthTime += (now - stats.lastChange) * static_cast<int64_t> (stats.depth);
+  stats.lastChange = now;
+  stats.depth += delta;
+  stats.peakDepth = std::max (stats.peakDepth, stats.depth);
 }
 
-bool
-AcmeFlatForwarder::RemoveRoute (Ptr<const CCNxRoute> route)
+const std::vector<AcmeFlatForwarder::CoreStatsType> &
+AcmeFlatForwarder::GetCoreStats (void) const
 {
-  NS_LOG_FUNCTION (this << route);
-  bool removed = false;
-  for (CCNxRoute::const_iterator i = route->begin (); i != route->end (); ++i)
+  return m_coreStats;
+}
+
+AcmeFlatOperationCounts
+AcmeFlatForwarder::GetOperations (void) const
+{
+  return m_fib->GetOperations () + m_pit->GetOperations () + m_contentStore->GetOperations () + m_names.GetOperations ();
+}
+
+void
+AcmeFlatForwarder::RouteOutput (Ptr<CCNxPacket> packet,
+                                Ptr<CCNxConnection> ingressConnection,
+                                Ptr<CCNxConnection> egressConnection)
+{
+  ACME_FLAT_PACKET_LOG_FUNCTION (this << packet << ingressConnection);
+  Ptr<AcmeFlatWorkItem> item = AllocateWorkItem (packet, ingressConnection, egressConnection);
+  EnqueueWorkItem (item);
+}
+
+void
+AcmeFlatForwarder::RouteInput (Ptr<CCNxPacket> packet,
+                               Ptr<CCNxConnection> ingressConnection)
+{
+  ACME_FLAT_PACKET_LOG_FUNCTION (this << packet << ingressConnection);
+  if (!ConformsToRateLimit (packet, ingressConnection))
     {
-      removed |= RemoveRoute (i->GetConnection (), i->GetPrefix ());
+      return;
     }
-  return removed;
+  Ptr<AcmeFlatWorkItem> item = AllocateWorkItem (packet, ingressConnection, Ptr<CCNxConnection> (0));
+  EnqueueWorkItem (item);
 }
 
 void
-AcmeFlatForwarder::PrintForwardingStatistics (Ptr<OutputStreamWrapper> streamWrapper) const
+AcmeFlatForwarder::ServiceInputQueue (Ptr<AcmeFlatWorkItem> item)
 {
-  std::ostream *stream = streamWrapper->GetStream ();
-  *stream << "AcmeFlatForwarder does not support printing statistics" << std::endl;
+  ACME_FLAT_PACKET_LOG_FUNCTION (this << item->GetPacket () << item->GetIngressConnection () << item->GetEgressConnection ());
+
+  if (!m_coreStats.empty ())
+    {
+      ChangeCoreDepth (item->GetCore (), -1);
+    }
+
+  Ptr<CCNxConnectionList> connections = item->GetConnectionsList ();
+  Ptr<CCNxPacket> packet;
+  if (connections)
+    {
+      // The cost model routed it when its service started
+      packet = item->GetRoutedPacket ();
+    }
+  else
+    {
+      connections = AllocateConnectionList ();
+      packet = InnerReceive (item, connections);
+    }
+
+  if (item->GetEgressConnection ())
+    {
+      // User specified an egressFromUser connection, so use that.
+      item->SetRouteError (CCNxRoutingError::CCNxRoutingError_NoError);
+      ACME_FLAT_PACKET_LOG_DEBUG (": user has overridden fib lookup");
+      packet = item->GetPacket ();
+      ClearEgress (connections);
+      AddEgress (connections, item->GetEgressConnection ());
+    }
+
+  ACME_FLAT_PACKET_LOG_DEBUG ("RouteOutput(packet=" << *item->GetPacket () << ", from " << item->GetIngressConnection ()->GetConnectionId ()
+                                                    << ",  will be fwded to " << connections->size () << " destinations");
+
+  if (connections->size () > 0)
+    {
+      ACME_FLAT_PACKET_LOG_DEBUG ("first destination is " << connections->front ()->GetConnectionId () );
+    }
+
+  m_stats.RecordInputLatency (Simulator::Now () - item->GetArrivalTime ());
+
+  if (m_traceSampleInterval > 0 && ++m_traceSampleCount >= m_traceSampleInterval)
+    {
+      m_traceSampleCount = 0;
+      m_sampledRouteTrace (packet, item->GetIngressConnection (), item->GetRouteError (), connections);
+    }
+
+  m_routeCallback (packet, item->GetIngressConnection (), item->GetRouteError (), connections);
+
+  ReleaseConnectionList (connections);
+  ReleaseWorkItem (item);
 }
 
-void
+Ptr<AcmeFlatWorkItem>
+AcmeFlatForwarder::AllocateWorkItem (Ptr<CCNxPacket> packet,
+                                     Ptr<CCNxConnection> ingressConnection,
+                                     Ptr<CCNxConnection> egressConnection)
+{
+  Ptr<AcmeFlatWorkItem> item;
+  while (!m_freeWorkItems.empty () && !item)
+    {
+      // Only this pool may hold a free item; drop any someone else kept
+      if (m_freeWorkItems.back ()->GetReferenceCount () == 1)
+        {
+          item = m_freeWorkItems.back ();
+          m_poolStats.workItemHits++;
+        }
+      m_freeWorkItems.pop_back ();
+    }
+
+  if (!item)
+    {
+      item = Create<AcmeFlatWorkItem> ();
+      m_poolStats.workItemAllocations++;
+    }
+
+  item->Reset (packet, ingressConnection, egressConnection, Simulator::Now ());
+  return item;
+}
+
+void
+AcmeFlatForwarder::ReleaseWorkItem (Ptr<AcmeFlatWorkItem> item)
+{
+  item->Clear ();
+  m_freeWorkItems.push_back (item);
+}
+
+Ptr<CCNxConnectionList>
+AcmeFlatForwarder::AllocateConnectionList (void)
+{
+  Ptr<CCNxConnectionList> connections;
+  while (!m_freeConnectionLists.empty () && !connections)
+    {
+      // The route callback may have kept the list; leave it alone in that case
+      if (m_freeConnectionLists.back ()->GetReferenceCount () == 1)
+        {
+          connections = m_freeConnectionLists.back ();
+          ClearEgress (connections);
+          m_poolStats.connectionListHits++;
+        }
+      m_freeConnectionLists.pop_back ();
+    }
+
+  if (!connections)
+    {
+      connections = Create<CCNxConnectionList> ();
+      m_poolStats.connectionListAllocations++;
+    }
+  return connections;
+}
+
+void
+AcmeFlatForwarder::ReleaseConnectionList (Ptr<CCNxConnectionList> connections)
+{
+  m_freeConnectionLists.push_back (connections);
+}
+
+void
+AcmeFlatForwarder::AddEgress (Ptr<CCNxConnectionList> egress, Ptr<CCNxConnection> connection)
+{
+  if (m_spareEgressNodes.empty ())
+    {
+      egress->push_back (connection);
+    }
+  else
+    {
+      egress->splice (egress->end (), m_spareEgressNodes, m_spareEgressNodes.begin ());
+      egress->back () = connection;
+    }
+}
+
+void
+AcmeFlatForwarder::ClearEgress (Ptr<CCNxConnectionList> egress)
+{
+  for (CCNxConnectionList::iterator i = egress->begin (); i != egress->end (); ++i)
+    {
+      *i = 0;
+    }
+  m_spareEgressNodes.splice (m_spareEgressNodes.end (), *egress);
+}
+
+Ptr<CCNxPacket>
+AcmeFlatForwarder::InnerReceive (Ptr<AcmeFlatWorkItem> item, Ptr<CCNxConnectionList> egress)
+{
+  ACME_FLAT_PACKET_LOG_FUNCTION (this << item->GetPacket () << item->GetIngressConnection ());
+
+  // Digest the name once for all table lookups on this packet
+  uint64_t digest = item->GetNameDigest ();
+  if (digest == 0)
+    {
+      digest = AcmeFlatNameDigest::Compute (*item->GetPacket ()->GetMessage ()->GetName ());
+    }
+
+  // Sojourn time as of routing: the wait, plus the service time unless the cost model routes at service start
+  Time now = Simulator::Now ();
+  bool congested = !m_markingTarget.IsZero () && now - item->GetArrivalTime () > m_markingTarget;
+  if (congested)
+    {
+      m_stats.IncrementCongestionMarks ();
+    }
+
+  Ptr<CCNxPacket> packet = item->GetPacket ();
+  switch (item->GetPacket ()->GetFixedHeader ()->GetPacketType ())
+    {
+    case CCNxFixedHeaderType_Interest:
+      m_stats.IncrementInterestsIn ();
+      if (m_hotNameCount > 0)
+        {
+          m_hotNames.Add (item->GetPacket ()->GetMessage ()->GetName (), digest);
+        }
+      packet = ForwardInterest (item->GetPacket (), item->GetIngressConnection (), digest, congested, egress);
+      if (packet != item->GetPacket ())
+        {
+          // Answered from the content store, so only the wait here can mark it
+          MarkContentObject (packet, congested, egress);
+        }
+      break;
+
+    case CCNxFixedHeaderType_Object:
+      {
+        m_stats.IncrementObjectsIn ();
+        bool pitMarked = ForwardContentObject (item->GetPacket (), item->GetIngressConnection (), digest, egress);
+        bool arrivedMarked = m_congestionMarks && m_congestionMarks->IsMarked (packet, now);
+        MarkContentObject (packet, congested || pitMarked || arrivedMarked, egress);
+        break;
+      }
+
+    default:
+      NS_ASSERT_MSG (false, "Unsupported packetType");
+    }
+  ACME_FLAT_PACKET_LOG_INFO ("Route " << item->GetPacket ()->GetMessage ()->GetName () << " egress count " << egress->size ());
+  return packet;
+}
+
+Ptr<CCNxPacket>
+AcmeFlatForwarder::ForwardInterest (Ptr<CCNxPacket> packet, Ptr<CCNxConnection> ingress, uint64_t digest,
+                                    bool congested, Ptr<CCNxConnectionList> egress)
+{
+  ACME_FLAT_PACKET_LOG_FUNCTION (this << packet << ingress);
+  ACME_FLAT_PACKET_LOG_INFO ("Forwarding " << *packet);
+
+  Ptr<const CCNxName> name = InternName (packet->GetMessage ()->GetName (), digest);
+  Time now = Simulator::Now ();
+
+  if (m_contentStore->IsEnabled ())
+    {
+      Ptr<CCNxPacket> cached = m_contentStore->Lookup (*name, digest);
+      if (cached)
+        {
+          ACME_FLAT_PACKET_LOG_INFO ("Content store hit : " << *name);
+          m_stats.IncrementInterestsSatisfiedFromCache ();
+          AddEgress (egress, ingress);
+          return cached;
+        }
+    }
+
+  uint32_t pending = m_pit->Find (*name, digest, now);
+  if (pending != AcmeFlatPit::None)
+    {
+      if (congested)
+        {
+          m_pit->SetCongestionMark (pending);
+        }
+      if (m_pit->AddIngress (pending, ingress->GetConnectionId (), now))
+        {
+          ACME_FLAT_PACKET_LOG_INFO ("Aggregated in PIT : " << *name);
+          m_stats.IncrementInterestsAggregated ();
+          return packet;
+        }
+      // A retransmission from a connection already in the entry is forwarded again
+    }
+
+  AcmeFlatFib::NextHopType *nextHop = 0;
+  if (m_fibFilterCountersPerRoute > 0 && IsFilteredOut (*name, digest))
+    {
+      // A sure miss, so skip the lookup
+      m_stats.IncrementFilteredNoRouteDrops ();
+    }
+  else
+    {
+      nextHop = m_fib->LookupNextHop (name, digest);
+    }
+  if (!nextHop)
+    {
+      ACME_FLAT_PACKET_LOG_INFO ("No route in FIB : " << *packet->GetMessage ()->GetName ());
+      m_stats.IncrementNoRouteDrops ();
+      // DROP
+    }
+  else
+    {
+      bool multipath = m_fib->GetNextHopCount (*nextHop) > 1;
+      if (multipath)
+        {
+          nextHop = &m_strategy->SelectNextHop (*m_fib, *nextHop, digest, ingress->GetConnectionId ());
+        }
+      CCNxConnection::ConnIdType connId = nextHop->connId;
+      if (connId != ingress->GetConnectionId ())
+        {
+          Ptr<CCNxConnection> connection = ResolveNextHop (*nextHop);
+          if (connection)
+            {
+              ACME_FLAT_PACKET_LOG_INFO ("Route found, packet forward to connid " << connection->GetConnectionId ());
+              if (pending == AcmeFlatPit::None)
+                {
+                  pending = m_pit->Insert (name, digest, now);
+                  m_pit->AddIngress (pending, ingress->GetConnectionId (), now);
+                  StartPitTimer (pending);
+                  if (congested)
+                    {
+                      m_pit->SetCongestionMark (pending);
+                    }
+                  if (multipath && m_strategy->IsMeasuring ())
+                    {
+                      m_pit->SetEgress (pending, connId, now);
+                    }
+                }
+              else
+                {
+                  // A Content Object could answer either copy, so the retransmission is not timed
+                  m_pit->ClearEgress (pending);
+                }
+              AddEgress (egress, connection);
+              m_stats.IncrementInterestsForwarded ();
+              AcmeFlatFib::NextHopStateType &state = m_fib->GetNextHopState (*nextHop);
+              state.packets++;
+              state.bytes += packet->GetFixedHeader ()->GetPacketLength ();
+            }
+          else
+            {
+              ACME_FLAT_PACKET_LOG_INFO ("Could not resolve CCNxL3Protocol connection for connid " << connId);
+              m_stats.IncrementNoRouteDrops ();
+            }
+        }
+      else
+        {
+          ACME_FLAT_PACKET_LOG_INFO ("Egress is same as ingress connid " << connId << " : no route");
+          m_stats.IncrementIngressEqualsEgressDrops ();
+        }
+    }
+  return packet;
+}
+
+bool
+AcmeFlatForwarder::ForwardContentObject (Ptr<CCNxPacket> packet, Ptr<CCNxConnection> ingress, uint64_t digest,
+                                         Ptr<CCNxConnectionList> egress)
+{
+  ACME_FLAT_PACKET_LOG_FUNCTION (this << packet << ingress);
+
+  ACME_FLAT_PACKET_LOG_INFO ("Forwarding " << *packet);
+
+  Ptr<const CCNxName> name = InternName (packet->GetMessage ()->GetName (), digest);
+  uint32_t pending = m_pit->Find (*name, digest, Simulator::Now ());
+  if (pending == AcmeFlatPit::None)
+    {
+      ACME_FLAT_PACKET_LOG_INFO ("No PIT entry, dropping unsolicited object : " << *name);
+      m_stats.IncrementUnsolicitedObjectDrops ();
+      return false;
+    }
+
+  CCNxConnection::ConnIdType egressId;
+  Time sent;
+  if (m_pit->GetEgress (pending, egressId, sent) && egressId == ingress->GetConnectionId ())
+    {
+      AcmeFlatFib::NextHopType *nextHop = LookupNextHop (name, digest, egressId);
+      if (nextHop)
+        {
+          m_strategy->ReportRtt (*m_fib, *nextHop, Simulator::Now () - sent);
+        }
+    }
+
+  if (m_contentStore->IsEnabled ())
+    {
+      m_contentStore->Add (name, digest, packet);
+    }
+
+  const AcmeFlatPit::IngressListType &pendingIngress = m_pit->GetIngress (pending);
+  for (AcmeFlatPit::IngressListType::const_iterator i = pendingIngress.begin (); i != pendingIngress.end (); ++i)
+    {
+      if (*i == ingress->GetConnectionId ())
+        {
+          continue;
+        }
+
+      Ptr<CCNxConnection> connection = m_ccnx->GetConnection (*i);
+      if (connection)
+        {
+          AddEgress (egress, connection);
+        }
+      else
+        {
+          ACME_FLAT_PACKET_LOG_INFO ("Could not resolve CCNxL3Protocol connection for connid " << *i);
+        }
+    }
+  m_stats.IncrementObjectsForwarded (egress->size ());
+  bool marked = m_pit->HasCongestionMark (pending);
+  m_pit->Erase (pending);
+  return marked;
+}
+
+// =========
+// PIT expiry section
+
+uint64_t
+AcmeFlatForwarder::GetPitTimerTick (Time time) const
+{
+  int64_t step = m_pitTimerTick.GetTimeStep ();
+  return static_cast<uint64_t> ((time.GetTimeStep () + step - 1) / step);
+}
+
+void
+AcmeFlatForwarder::StartPitTimer (uint32_t handle)
+{
+  Time expiry;
+  bool live = m_pit->GetExpiry (handle, m_pit->GetGeneration (handle), expiry);
+  NS_ASSERT_MSG (live, "Starting the timer of a free PIT entry " << handle);
+
+  m_pitTimers.Insert (GetPitTimerTick (expiry), handle, m_pit->GetGeneration (handle));
+  m_pitTimersStarted++;
+  SchedulePitTimerTick ();
+}
+
+void
+AcmeFlatForwarder::SchedulePitTimerTick (void)
+{
+  uint64_t tick = m_pitTimers.GetNextTick ();
+  if (tick >= m_pitTimerEventTick)
+    {
+      // Nothing pending, or the scheduled event comes first
+      return;
+    }
+
+  Simulator::Cancel (m_pitTimerEvent);
+  Time delay = m_pitTimerTick * static_cast<int64_t> (tick) - Simulator::Now ();
+  m_pitTimerEvent = Simulator::Schedule (delay, &AcmeFlatForwarder::PitTimerTick, this);
+  m_pitTimerEventTick = tick;
+  m_pitTimerEvents++;
+}
+
+void
+AcmeFlatForwarder::PitTimerTick (void)
+{
+  Time now = Simulator::Now ();
+  m_pitTimerEventTick = AcmeFlatTimerWheel::Never;
+
+  m_expiredPitTimers.clear ();
+  m_pitTimers.Advance (now.GetTimeStep () / m_pitTimerTick.GetTimeStep (), m_expiredPitTimers);
+
+  for (std::vector<AcmeFlatTimerWheel::TimerType>::const_iterator i = m_expiredPitTimers.begin (); i != m_expiredPitTimers.end (); ++i)
+    {
+      Time expiry;
+      if (!m_pit->GetExpiry (i->handle, i->generation, expiry))
+        {
+          // Satisfied or already expired by a lookup
+          continue;
+        }
+
+      if (expiry <= now)
+        {
+          PitEntryExpired (i->handle);
+          m_pit->Erase (i->handle);
+          m_pitEntriesExpired++;
+        }
+      else
+        {
+          // The lifetime was extended by another Interest
+          m_pitTimers.Insert (GetPitTimerTick (expiry), i->handle, i->generation);
+        }
+    }
+
+  NS_LOG_DEBUG ("PIT timer tick expired " << m_expiredPitTimers.size () << " timers, " << m_pitTimers.GetSize () << " pending");
+  SchedulePitTimerTick ();
+}
+
+void
+AcmeFlatForwarder::PitEntryExpired (uint32_t handle)
+{
+  CCNxConnection::ConnIdType egressId;
+  Time sent;
+  if (m_pit->GetEgress (handle, egressId, sent))
+    {
+      AcmeFlatFib::NextHopType *nextHop = LookupNextHop (m_pit->GetName (handle), m_pit->GetDigest (handle), egressId);
+      if (nextHop)
+        {
+          m_strategy->ReportTimeout (*m_fib, *nextHop, Simulator::Now () - sent);
+        }
+    }
+}
+
+// =========
+// FIB section
+
+bool
+AcmeFlatForwarder::AddRoute (CCNxConnection::ConnIdType connId, Ptr<const CCNxName> name, uint32_t cost)
+{
+  NS_LOG_FUNCTION (this << connId << name << cost);
+
+  if (connId != CCNxConnection::ConnIdLocalHost)
+    {
+      uint64_t digest = AcmeFlatNameDigest::Compute (*name);
+      name = InternName (name, digest);
+      if (m_fib->AddNextHop (name, digest, connId, cost))
+        {
+          m_connectionRoutes.Add (connId, name, digest);
+          FibFilterAdd (digest);
+          NS_LOG_INFO ("AddRoute connId " << connId << " name " << *name);
+          return true;
+        }
+      NS_LOG_INFO ("AddRoute connId " << connId << " is already a next hop of " << *name);
+      return false;
+    }
+  else
+    {
+      return false;
+    }
+
+}
+
+bool
+AcmeFlatForwarder::AddRoute (Ptr<CCNxConnection> connection, Ptr<const CCNxName> name)
+{
+  NS_LOG_FUNCTION (this << connection << name);
+  return AddRoute (connection->GetConnectionId (), name, 0);
+}
+
+bool
+AcmeFlatForwarder::AddRoute (Ptr<const CCNxRoute> route)
+{
+  NS_LOG_FUNCTION (this << route);
+  bool added = false;
+  for (CCNxRoute::const_iterator i = route->begin (); i != route->end (); ++i)
+    {
+      added |= AddRoute (i->GetConnection ()->GetConnectionId (), i->GetPrefix (), i->GetCost ());
+    }
+  return added;
+}
+
+/**
+ * Orders bulk routes by digest, so equal names are adjacent
+ */
+static bool
+IsLessDigest (const AcmeFlatFib::BulkRouteType &a, const AcmeFlatFib::BulkRouteType &b)
+{
+  return a.digest < b.digest;
+}
+
+size_t
+AcmeFlatForwarder::AddRoutes (const std::vector<Ptr<const CCNxRoute> > &routes)
+{
+  NS_LOG_FUNCTION (this << routes.size ());
+
+  SystemWallClockMs clock;
+  clock.Start ();
+
+  std::vector<AcmeFlatFib::BulkRouteType> batch;
+  for (size_t r = 0; r < routes.size (); ++r)
+    {
+      for (CCNxRoute::const_iterator i = routes[r]->begin (); i != routes[r]->end (); ++i)
+        {
+          CCNxConnection::ConnIdType connId = i->GetConnection ()->GetConnectionId ();
+          if (connId != CCNxConnection::ConnIdLocalHost)
+            {
+              uint64_t digest = AcmeFlatNameDigest::Compute (*i->GetPrefix ());
+              AcmeFlatFib::BulkRouteType route = { InternName (i->GetPrefix (), digest), digest, connId, i->GetCost () };
+              batch.push_back (route);
+            }
+        }
+    }
+
+  // Stable, so the first route of a name stays first
+  std::stable_sort (batch.begin (), batch.end (), IsLessDigest);
+
+  // The first route of each name goes to the FIB in one AddRoutes, its other
+  // next hops after it.  A name can only repeat within a run of equal digests.
+  std::vector<AcmeFlatFib::BulkRouteType> first;
+  std::vector<AcmeFlatFib::BulkRouteType> alternates;
+  first.reserve (batch.size ());
+  for (size_t i = 0; i < batch.size (); ++i)
+    {
+      bool sameName = false;
+      bool sameNextHop = false;
+      for (size_t j = i; j > 0 && batch[j - 1].digest == batch[i].digest && !sameNextHop; --j)
+        {
+          if (batch[j - 1].name->Equals (*batch[i].name))
+            {
+              sameName = true;
+              sameNextHop = batch[j - 1].connId == batch[i].connId;
+            }
+        }
+      if (!sameName)
+        {
+          first.push_back (batch[i]);
+        }
+      else if (!sameNextHop)
+        {
+          alternates.push_back (batch[i]);
+        }
+    }
+
+  // A name that is already in the FIB gets the route as another next hop,
+  // which AddNextHop refuses if it is one already
+  size_t fresh = 0;
+  for (size_t i = 0; i < first.size (); ++i)
+    {
+      if (m_fib->FindRoute (first[i].name, first[i].digest))
+        {
+          alternates.push_back (first[i]);
+        }
+      else
+        {
+          first[fresh++] = first[i];
+        }
+    }
+  first.resize (fresh);
+
+  // Every one of these is new, so each goes in the index and the filter once
+  std::vector<uint64_t> filtered;
+  size_t added = m_fib->AddRoutes (first);
+  NS_ASSERT_MSG (added == first.size (), "AddRoutes skipped a route not in the FIB");
+  for (size_t i = 0; i < first.size (); ++i)
+    {
+      m_connectionRoutes.Add (first[i].connId, first[i].name, first[i].digest);
+      filtered.push_back (first[i].digest);
+    }
+  for (size_t i = 0; i < alternates.size (); ++i)
+    {
+      const AcmeFlatFib::BulkRouteType &route = alternates[i];
+      if (m_fib->AddNextHop (route.name, route.digest, route.connId, route.cost))
+        {
+          m_connectionRoutes.Add (route.connId, route.name, route.digest);
+          filtered.push_back (route.digest);
+          added++;
+        }
+    }
+
+  if (m_fibFilterCountersPerRoute > 0)
+    {
+      if (m_fibFilter.GetCount () + filtered.size () > m_fibFilter.GetCapacity ())
+        {
+          RebuildFibFilter ();
+        }
+      else
+        {
+          for (size_t i = 0; i < filtered.size (); ++i)
+            {
+              m_fibFilter.Add (filtered[i]);
+            }
+        }
+    }
+
+  size_t batchSize = batch.size ();
+  size_t bytes = m_fib->GetMemoryUsage ()
+    + (batch.capacity () + first.capacity () + alternates.capacity ()) * sizeof(AcmeFlatFib::BulkRouteType);
+
+  m_bulkLoad.batches++;
+  m_bulkLoad.routesAdded += added;
+  m_bulkLoad.duplicates += batchSize - added;
+  m_bulkLoad.wallClockMs += clock.End ();
+  m_bulkLoad.peakBytes = std::max (m_bulkLoad.peakBytes, bytes);
+
+  NS_LOG_INFO ("AddRoutes added " << added << " of " << batchSize << " FIB bytes " << m_fib->GetMemoryUsage ());
+  return added;
+}
+
+const AcmeFlatForwarder::BulkLoadReportType &
+AcmeFlatForwarder::GetBulkLoadReport (void) const
+{
+  return m_bulkLoad;
+}
+
+bool
+AcmeFlatForwarder::RemoveRoute (CCNxConnection::ConnIdType connId, Ptr<const CCNxName> name)
+{
+  NS_LOG_FUNCTION (this << connId << name);
+  uint64_t digest = AcmeFlatNameDigest::Compute (*name);
+  if (m_fib->RemoveRoute (name, digest, connId))
+    {
+      m_connectionRoutes.Remove (connId, *name, digest);
+      FibFilterRemove (digest);
+      NS_LOG_INFO ("RemoveRoute connection " << connId << " name " << *name);
+      if (m_connectionRoutes.GetCount (connId) == 0)
+        {
+          // Usually the connection is going away, as when a portal closes
+          ConnectionRemoved (connId);
+        }
+      return true;
+    }
+  return false;
+}
+
+size_t
+AcmeFlatForwarder::RemoveRoutesForConnection (Ptr<CCNxConnection> connection)
+{
+  NS_LOG_FUNCTION (this << connection->GetConnectionId ());
+
+  CCNxConnection::ConnIdType connId = connection->GetConnectionId ();
+  std::vector<AcmeFlatFib::BulkRouteType> routes;
+  m_connectionRoutes.Take (connId, routes);
+  if (m_overlayFib)
+    {
+      // The index only has the routes added to this forwarder
+      m_overlayFib->GetSharedRoutes (connId, routes);
+    }
+
+  size_t removed = 0;
+  for (size_t i = 0; i < routes.size (); ++i)
+    {
+      if (m_fib->RemoveRoute (routes[i].name, routes[i].digest, connId))
+        {
+          FibFilterRemove (routes[i].digest);
+          removed++;
+        }
+    }
+
+  ConnectionRemoved (connId);
+  NS_LOG_INFO ("RemoveRoutesForConnection connection " << connId << " removed " << removed);
+  return removed;
+}
+
+void
+AcmeFlatForwarder::FibFilterAdd (uint64_t digest)
+{
+  if (m_fibFilterCountersPerRoute > 0)
+    {
+      if (m_fibFilter.GetCount () < m_fibFilter.GetCapacity ())
+        {
+          m_fibFilter.Add (digest);
+        }
+      else
+        {
+          // m_fib already has the new next hop
+          RebuildFibFilter ();
+        }
+    }
+}
+
+void
+AcmeFlatForwarder::FibFilterRemove (uint64_t digest)
+{
+  if (m_fibFilterCountersPerRoute > 0)
+    {
+      m_fibFilter.Remove (digest);
+    }
+}
+
+void
+AcmeFlatForwarder::RebuildFibFilter (void)
+{
+  std::vector<AcmeFlatFib::RouteType> routes;
+  m_fib->GetRoutes (routes);
+
+  m_fibFilter = AcmeFlatBloomFilter (std::max (m_fibFilter.GetCapacity (), routes.size () * 2), m_fibFilterCountersPerRoute);
+  for (size_t i = 0; i < routes.size (); ++i)
+    {
+      m_fibFilter.Add (AcmeFlatNameDigest::Compute (*routes[i].name));
+    }
+  NS_LOG_INFO ("RebuildFibFilter next hops " << routes.size () << " capacity " << m_fibFilter.GetCapacity ());
+}
+
+bool
+AcmeFlatForwarder::IsFilteredOut (const CCNxName &name, uint64_t digest)
+{
+  if (m_fib->IsExactMatch ())
+    {
+      return !m_fibFilter.MayContain (digest);
+    }
+
+  // Any prefix of the name may have the route
+  AcmeFlatNameDigest::ComputePrefixes (name, m_fibFilterDigests);
+  for (size_t i = 0; i < m_fibFilterDigests.size (); ++i)
+    {
+      if (m_fibFilter.MayContain (m_fibFilterDigests[i]))
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+AcmeFlatForwarder::ConnectionRemoved (CCNxConnection::ConnIdType connId)
+{
+  NS_LOG_FUNCTION (this << connId);
+  m_connectionEpoch++;
+}
+
+const AcmeFlatForwarder::PoolStatsType &
+AcmeFlatForwarder::GetPoolStats (void) const
+{
+  return m_poolStats;
+}
+
+uint64_t
+AcmeFlatForwarder::GetNextHopResolutions (void) const
+{
+  return m_nextHopResolutions;
+}
+
+Ptr<CCNxConnection>
+AcmeFlatForwarder::ResolveNextHop (AcmeFlatFib::NextHopType &nextHop)
+{
+  AcmeFlatFib::NextHopStateType &state = m_fib->GetNextHopState (nextHop);
+  if (state.epoch != m_connectionEpoch)
+    {
+      m_nextHopResolutions++;
+      state.connection = m_ccnx->GetConnection (nextHop.connId);
+      // Do not cache a miss, the connection may be added later
+      state.epoch = state.connection ? m_connectionEpoch : 0;
+    }
+  return state.connection;
+}
+
+AcmeFlatFib::NextHopType *
+AcmeFlatForwarder::LookupNextHop (Ptr<const CCNxName> name, uint64_t digest, CCNxConnection::ConnIdType connId)
+{
+  AcmeFlatFib::NextHopType *first = m_fib->LookupNextHop (name, digest);
+  if (first)
+    {
+      size_t count = m_fib->GetNextHopCount (*first);
+      for (size_t i = 0; i < count; ++i)
+        {
+          AcmeFlatFib::NextHopType &nextHop = m_fib->GetNextHop (*first, i);
+          if (nextHop.connId == connId)
+            {
+              return &nextHop;
+            }
+        }
+    }
+  return 0;
+}
+
+bool
+AcmeFlatForwarder::RemoveRoute (Ptr<CCNxConnection> connection, Ptr<const CCNxName> name)
+{
+  NS_LOG_FUNCTION (this << connection << name);
+  return RemoveRoute (connection->GetConnectionId (), name);
+}
+
+bool
+AcmeFlatForwarder::RemoveRoute (Ptr<const CCNxRoute> route)
+{
+  NS_LOG_FUNCTION (this << route);
+  bool removed = false;
+  for (CCNxRoute::const_iterator i = route->begin (); i != route->end (); ++i)
+    {
+      removed |= RemoveRoute (i->GetConnection (), i->GetPrefix ());
+    }
+  return removed;
+}
+
+void
+AcmeFlatForwarder::PrintForwardingStatistics (Ptr<OutputStreamWrapper> streamWrapper) const
+{
+  std::ostream *stream = streamWrapper->GetStream ();
+  *stream << "AcmeFlatForwarder " << m_stats << std::endl;
+  *stream << "AcmeFlatForwarder PIT entries " << m_pit->GetSize ()
+          << " expired " << m_pitEntriesExpired
+          << " timers " << m_pitTimersStarted
+          << " events " << m_pitTimerEvents
+          << " events saved " << (m_pitTimersStarted > m_pitTimerEvents ? m_pitTimersStarted - m_pitTimerEvents : 0)
+          << std::endl;
+  *stream << "AcmeFlatForwarder content store objects " << m_contentStore->GetCount ()
+          << " bytes " << m_contentStore->GetBytes () << "/" << m_contentStore->GetByteCapacity ()
+          << " hits " << m_contentStore->GetHits ()
+          << " misses " << m_contentStore->GetMisses ()
+          << " evictions " << m_contentStore->GetEvictions ()
+          << std::endl;
+  if (m_overlayFib)
+    {
+      *stream << "AcmeFlatForwarder shared FIB routes " << m_sharedFib->GetSize ()
+              << " copied " << m_overlayFib->GetCopies ()
+              << " withdrawn " << m_overlayFib->GetWithdrawnCount ()
+              << " private routes " << m_overlayFib->GetLocalFib ()->GetSize ()
+              << std::endl;
+    }
+  *stream << "AcmeFlatForwarder FIB routes " << m_fib->GetSize ()
+          << " bytes " << m_fib->GetMemoryUsage ()
+          << " bulk loads " << m_bulkLoad.batches
+          << " routes " << m_bulkLoad.routesAdded
+          << " duplicates " << m_bulkLoad.duplicates
+          << " time " << m_bulkLoad.wallClockMs << " ms"
+          << " peak bytes " << m_bulkLoad.peakBytes
+          << " connections " << m_connectionRoutes.GetConnectionCount ()
+          << std::endl;
+  *stream << "AcmeFlatForwarder next hops resolved " << m_nextHopResolutions
+          << " connection epoch " << m_connectionEpoch
+          << std::endl;
+  *stream << "AcmeFlatForwarder pool work items hits " << m_poolStats.workItemHits
+          << " allocations " << m_poolStats.workItemAllocations
+          << " connection lists hits " << m_poolStats.connectionListHits
+          << " allocations " << m_poolStats.connectionListAllocations
+          << std::endl;
+
+  AcmeFlatOperationCounts operations = GetOperations ();
+  *stream << "AcmeFlatForwarder operations probes " << operations.probes
+          << " segment compares " << operations.segmentCompares
+          << " insertions " << operations.insertions
+          << " charged " << m_operationsDelay
+          << std::endl;
+
+  if (!m_batchQueues.empty ())
+    {
+      uint64_t batches = 0;
+      uint64_t items = 0;
+      size_t waiting = 0;
+      for (size_t i = 0; i < m_batchQueues.size (); ++i)
+        {
+          batches += m_batchQueues[i]->GetBatches ();
+          items += m_batchQueues[i]->GetBatchedItems ();
+          waiting += m_batchQueues[i]->GetSize ();
+        }
+      *stream << "AcmeFlatForwarder batches " << batches
+              << " items " << items
+              << " mean size " << (batches > 0 ? static_cast<double> (items) / batches : 0.0)
+              << " waiting " << waiting
+              << std::endl;
+    }
+
+  for (IngressWaitMapType::const_iterator i = m_ingressWaits.begin (); i != m_ingressWaits.end (); ++i)
+    {
+      IngressWeightMapType::const_iterator weight = m_ingressWeights.find (i->first);
+      *stream << "AcmeFlatForwarder ingress " << i->first
+              << " weight " << (weight == m_ingressWeights.end () ? 1 : weight->second)
+              << " wait " << i->second
+              << std::endl;
+    }
+
+  if (m_fibFilterCountersPerRoute > 0)
+    {
+      *stream << "AcmeFlatForwarder FIB filter next hops " << m_fibFilter.GetCount ()
+              << " capacity " << m_fibFilter.GetCapacity ()
+              << " hashes " << m_fibFilter.GetHashCount ()
+              << " bytes " << m_fibFilter.GetMemoryUsage ()
+              << " lookups skipped " << m_stats.GetFilteredNoRouteDrops ()
+              << std::endl;
+    }
+
+  if (m_nameTableCapacity > 0)
+    {
+      *stream << "AcmeFlatForwarder name table names " << m_names.GetSize ()
+              << " capacity " << m_names.GetCapacity ()
+              << " hits " << m_names.GetHits ()
+              << " retired " << m_names.GetRetired ()
+              << " bytes " << m_names.GetMemoryUsage ()
+              << std::endl;
+    }
+
+  if (m_hotNameCount > 0)
+    {
+      *stream << "AcmeFlatForwarder hot names interests " << m_hotNames.GetTotal ()
+              << " sketch bytes " << m_hotNames.GetMemoryUsage ()
+              << std::endl;
+      std::vector<AcmeFlatHeavyHitters::HitterType> top = m_hotNames.GetTopK ();
+      for (size_t i = 0; i < top.size (); ++i)
+        {
+          *stream << "AcmeFlatForwarder hot name " << i + 1
+                  << " count " << top[i].count
+                  << " " << *top[i].name
+                  << std::endl;
+        }
+    }
+
+  for (IngressRateLimitMapType::const_iterator i = m_ingressRateLimits.begin (); i != m_ingressRateLimits.end (); ++i)
+    {
+      *stream << "AcmeFlatForwarder ingress " << i->first
+              << " interests conforming " << i->second.GetConforming ()
+              << " exceeding " << i->second.GetExceeding ()
+              << std::endl;
+    }
+
+  Time now = Simulator::Now ();
+  for (size_t core = 0; core < m_coreStats.size (); ++core)
+    {
+      const CoreStatsType &stats = m_coreStats[core];
+      Time depthTime = stats.depthTime + (now - stats.lastChange) * static_cast<int64_t> (stats.depth);
+      double seconds = (now - m_coresStarted).GetSeconds ();
+      *stream << "AcmeFlatForwarder core " << core
+              << " items " << stats.items
+              << " utilization " << (seconds > 0 ? 100.0 * stats.busy.GetSeconds () / seconds : 0.0) << "%"
+              << " depth " << stats.depth
+              << " mean " << (seconds > 0 ? depthTime.GetSeconds () / seconds : 0.0)
+              << " peak " << stats.peakDepth
+              << std::endl;
+    }
+}
+
+const AcmeFlatForwarderStats &
+AcmeFlatForwarder::GetStats (void) const
+{
+  return m_stats;
+}
+
+void
 AcmeFlatForwarder::PrintForwardingTable (Ptr<OutputStreamWrapper> streamWrapper) const
+{
+  PrintForwardingTable (streamWrapper, AcmeFlatFibWriter ());
+}
+
+uint64_t
+AcmeFlatForwarder::PrintForwardingTable (Ptr<OutputStreamWrapper> streamWrapper, const AcmeFlatFibWriter &writer) const
 {
   std::ostream *stream = streamWrapper->GetStream ();
-  *stream << "AcmeFlatForwarder not implemented" << std::endl;
+  return writer.Write (*m_fib, *stream);
 }
@@ -59,21 +59,142 @@
 #include <map>
 #include "ns3/ccnx-forwarder.h"
 #include "ns3/ccnx-delay-queue.h"
-#include "ns3/ccnx-standard-forwarder-work-item.h"
 #include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/traced-callback.h"
+#include "ns3/acme-flat-fib.h"
+#include "ns3/acme-flat-overlay-fib.h"
+#include "ns3/acme-flat-fib-writer.h"
+#include "ns3/acme-flat-connection-index.h"
+#include "ns3/acme-flat-pit.h"
+#include "ns3/acme-flat-timer-wheel.h"
+#include "ns3/acme-flat-content-store.h"
+#include "ns3/acme-flat-strategy.h"
+#include "ns3/acme-flat-work-item.h"
+#include "ns3/acme-flat-batch-queue.h"
+#include "ns3/acme-flat-token-bucket.h"
+#include "ns3/acme-flat-congestion-marks.h"
+#include "ns3/acme-flat-heavy-hitters.h"
+#include "ns3/acme-flat-bloom-filter.h"
+#include "ns3/acme-flat-name-table.h"
+#include "ns3/acme-flat-forwarder-stats.h"
 
 namespace ns3 {
 namespace acme {
 /**
- * @defgroup flat-forwarder Flat Forwarder: single path exact name routing
+ * @defgroup flat-forwarder Flat Forwarder: multipath exact or longest prefix name routing
  * @ingroup ccnx-forwarder
  * */
 
 /**
  * @ingroup flat-forwarder
  *
-* The flat forwarder does not do longest matching prefix.  It is only
-* exact match, so in it the same as having a flat global namespace.
+ * By default the flat forwarder only does exact match, so it is the same as
+ * having a flat global namespace.  With `AcmeFlatTrieFib` it does longest
+ * matching prefix.
+ *
+ * The FIB implementation is selected with the "FibType" attribute.  The default
+ * is `AcmeFlatMapFib`; `AcmeFlatHashFib` is a hash table keyed on the name digest.
+ * `AcmeFlatTrieFib` switches the forwarder to longest prefix match, so one
+ * route serves every name below it.
+ *
+ * A route may have several next hops (one AddRoute per connection).  An
+ * `AcmeFlatStrategy` chooses the next hop of each Interest (see
+ * `AcmeFlatForwarderHelper::SetStrategyType`).  The default
+ * `AcmeFlatHashStrategy` spreads names by rendezvous hashing;
+ * `AcmeFlatRttStrategy` prefers the next hop with the lowest round trip time.
+ * Each next hop counts the packets and bytes sent to it (see
+ * `AcmeFlatFibWriter::SetNextHopCounters`).
+ *
+ * Interests are recorded in an `AcmeFlatPit` (see the "PitType" attribute) so
+ * Content Objects follow the reverse path and duplicate Interests from other
+ * connections are aggregated.  PIT entries are expired by a timing wheel that
+ * runs one simulator event per occupied tick (see "PitTimerTick"), not one per
+ * entry.
+ *
+ * An Interest that hits the `AcmeFlatContentStore` is answered from the cache.
+ * The cache is disabled unless it is given a byte capacity (see
+ * `AcmeFlatForwarderHelper::SetContentStoreAttribute`).
+ *
+ * By default all packets share one input queue with "LayerDelayServers"
+ * servers.  With "Cores" set, each simulated core has its own single-server
+ * queue and a packet goes to the core picked by its name digest, so a popular
+ * name loads one core; see GetCoreStats for per-core utilization and depth.
+ *
+ * With "BatchSize" above 1 each queue is an `AcmeFlatBatchQueue`: a free server
+ * takes up to that many waiting packets at once and spends
+ * "BatchDelayConstant" on the batch plus the layer delay of each packet.
+ *
+ * Setting any of "ProbeDelay", "SegmentCompareDelay" or "InsertionDelay" turns
+ * on the cost model: a packet's service time also charges each table probe,
+ * name segment compared and table insertion that routing it performed in the
+ * FIB, PIT and content store (see `AcmeFlatOperationCounts`), so the delay
+ * follows the data structures chosen.  To know that work the packet is routed
+ * when its service starts, and its egress is delivered when the service time is
+ * up; table state changes at the start rather than the end of service.
+ *
+ * The input queues are unbounded unless "MaxInputQueueDepth" is set or
+ * "InputQueueDropPolicy" is CoDel; then each is an `AcmeFlatBatchQueue` (of one
+ * item per batch without "BatchSize") that drops by that policy.  A dropped
+ * packet is not routed: it is counted in the stats and reported by the
+ * "InputQueueDrop" trace source with the policy that dropped it.
+ *
+ * With "InputQueueScheduler" set to DRR the input queues are also batch queues,
+ * each holding a sub-queue per ingress connection served by deficit round robin
+ * (see `AcmeFlatDrrQueue`), so one busy neighbor cannot starve the others.
+ * SetIngressWeight gives a connection a larger share, and GetIngressWaits
+ * reports the input queue wait of each ingress.
+ *
+ * With "InterestRateLimit" set, each ingress connection has an
+ * `AcmeFlatTokenBucket` of that many Interests per second and
+ * "InterestBurstLimit" burst.  RouteInput checks an Interest against it before
+ * the Interest is queued, so an Interest flood from one neighbor does not take
+ * input queue space or FIB lookups from the others.  An exceeding Interest is
+ * dropped, or only flagged with "InterestRateLimitAction" Flag; either way it
+ * is reported by the "InterestRateLimited" trace source, and
+ * GetIngressRateLimits has the counts of each connection.
+ *
+ * With "MarkingTarget" set, a packet that waited in the input queue longer than
+ * that by the time it is routed meets congestion.  An Interest records it in
+ * its PIT entry, and the Content Object that satisfies the entry is marked; a
+ * Content Object is marked itself.  A marked Content Object is reported by the
+ * "CongestionMarked" trace source once for each connection it is sent to, and
+ * its packet is marked in an `AcmeFlatCongestionMarks`, so the forwarders
+ * downstream that share the marks (see SetCongestionMarks) and route that
+ * packet report it too.  Other copies of the Content Object, on other paths or
+ * from a content store, are not marked.  An `AcmeFlatRateController` connected
+ * to the trace on a consumer's node slows the consumer down before the queues
+ * drop.
+ *
+ * With "HotNames" set, the forwarder counts the name of each Interest it
+ * routes in an `AcmeFlatHeavyHitters` sketch of fixed size (see
+ * "HotNameSketchWidth" and "HotNameSketchDepth") and keeps that many of the
+ * most requested names, for cache sizing on runs with too many names to
+ * count one by one.  PrintForwardingStatistics lists them.
+ *
+ * With "FibFilterCountersPerRoute" set, the forwarder keeps a counting
+ * `AcmeFlatBloomFilter` of the digests of the FIB names, updated by every
+ * route added or removed.  An Interest whose name (or, for a longest prefix
+ * match FIB, every one of whose prefixes) misses the filter is dropped as having
+ * no route without a FIB lookup.  The stats count these drops as "filtered".
+ *
+ * With "NameTableCapacity" set, the forwarder interns the name of each
+ * packet and route in an `AcmeFlatNameTable` and gives the interned instance
+ * to the FIB, PIT and content store.  A name in several tables is stored once,
+ * and a table compares a packet's name to its entries by pointer.  The table
+ * keeps up to that many names no table uses before it retires the least
+ * recently seen.
+ *
+ * Work items and egress connection lists are recycled through free lists, so
+ * routing a packet does not allocate once the pools have grown.
+ *
+ * Per-packet logging can be compiled out (see acme-flat-packet-log.h).  The
+ * "SampledRoute" trace source reports 1 in "TraceSampleInterval" routed packets
+ * in any build:
+ * @code
+ * Config::SetDefault ("ns3::ccnx::AcmeFlatForwarder::TraceSampleInterval", UintegerValue (1000));
+ * Config::ConnectWithoutContext ("/NodeList/0/$ns3::ccnx::AcmeFlatForwarder/SampledRoute", MakeCallback (&MySink));
+ * @endcode
  *
  * It is provided as a simple example of adding a different forwarder to the
  * CCNx layer 3 module.
@@ -101,10 +222,257 @@ public:
 
   virtual bool RemoveRoute (Ptr<const ccnx::CCNxRoute> route);
 
+  /**
+   * Adds the routes of many CCNxRoutes at once, for example every producer
+   * prefix at startup.  The batch is digested, sorted and de-duplicated once and
+   * handed to the FIB, which sizes its tables for the whole batch.
+   *
+   * The routes of a repeated name become its next hops, as with AddRoute.  A
+   * repeated (name, connection) pair is counted as a duplicate.  Routes to
+   * localhost are skipped.
+   *
+   * @return The number of routes added
+   */
+  size_t AddRoutes (const std::vector<Ptr<const ccnx::CCNxRoute> > &routes);
+
+  /**
+   * The cost of the AddRoutes calls so far
+   */
+  typedef struct
+  {
+    uint64_t batches;
+    uint64_t routesAdded;
+    uint64_t duplicates;
+    int64_t wallClockMs;        //< total wall clock time spent in AddRoutes
+    size_t peakBytes;           //< the most FIB plus batch memory after a load
+  } BulkLoadReportType;
+
+  const BulkLoadReportType & GetBulkLoadReport (void) const;
+
+  /**
+   * The load of one core's input queue (see the "Cores" attribute)
+   */
+  typedef struct
+  {
+    uint64_t items;             //< work items dispatched to the core
+    uint64_t depth;             //< work items in the queue now, including the one in service
+    uint64_t peakDepth;
+    Time busy;                  //< total service time
+    Time depthTime;             //< integral of depth over time, for the mean depth
+    Time lastChange;            //< when depth last changed
+  } CoreStatsType;
+
+  /**
+   * @return The load of each core, empty unless "Cores" is set.  The counters
+   *         start when the forwarder is initialized.
+   */
+  const std::vector<CoreStatsType> & GetCoreStats (void) const;
+
+  /**
+   * How the pools of serviced work items and connection lists were used
+   */
+  typedef struct
+  {
+    uint64_t workItemHits;              //< work items taken from the pool
+    uint64_t workItemAllocations;       //< work items created because the pool had none free
+    uint64_t connectionListHits;        //< connection lists taken from the pool
+    uint64_t connectionListAllocations; //< connection lists created because the pool had none free
+  } PoolStatsType;
+
+  const PoolStatsType & GetPoolStats (void) const;
+
+  /**
+   * Sets the deficit round robin weight of an ingress connection, its share of
+   * the input queue servers when "InputQueueScheduler" is DRR.  The default is 1.
+   * May be called before or after the forwarder is initialized.
+   */
+  void SetIngressWeight (ccnx::CCNxConnection::ConnIdType connId, uint32_t weight);
+
+  typedef std::map<ccnx::CCNxConnection::ConnIdType, AcmeFlatLatencyHistogram> IngressWaitMapType;
+
+  /**
+   * @return The time packets of each ingress connection waited before their
+   *         service started.  Only recorded when "InputQueueScheduler" is DRR.
+   */
+  const IngressWaitMapType & GetIngressWaits (void) const;
+
+  /**
+   * What RouteInput does with an Interest that exceeds the rate limit of its ingress
+   */
+  typedef enum
+  {
+    RATE_LIMIT_DROP,            //< drop it before it is queued
+    RATE_LIMIT_FLAG             //< count and trace it, but route it
+  } RateLimitActionType;
+
+  typedef std::map<ccnx::CCNxConnection::ConnIdType, AcmeFlatTokenBucket> IngressRateLimitMapType;
+
+  /**
+   * @return The token bucket of each ingress connection that sent an Interest,
+   *         with its conforming and exceeding counts.  Empty unless
+   *         "InterestRateLimit" is set.
+   */
+  const IngressRateLimitMapType & GetIngressRateLimits (void) const;
+
+  /**
+   * @return The sketch of Interest names, empty unless "HotNames" is set
+   */
+  const AcmeFlatHeavyHitters & GetHotNames (void) const;
+
+  /**
+   * @return The filter of FIB names, empty unless "FibFilterCountersPerRoute" is set
+   */
+  const AcmeFlatBloomFilter & GetFibFilter (void) const;
+
+  /**
+   * @return The interned names, empty unless "NameTableCapacity" is set
+   */
+  const AcmeFlatNameTable & GetNameTable (void) const;
+
+  /**
+   * @return The operations performed by the FIB, PIT and content store so far
+   */
+  AcmeFlatOperationCounts GetOperations (void) const;
+
+  /**
+   * Removes every route to `connection`, for example when its link fails.  The
+   * cost is proportional to the number of routes removed, not the FIB size,
+   * except that a shared FIB (`AcmeFlatForwarderHelper::SetSharedFib`) is
+   * walked for its routes to `connection`.
+   *
+   * @return The number of routes removed
+   */
+  size_t RemoveRoutesForConnection (Ptr<ccnx::CCNxConnection> connection);
+
+  /**
+   * Tells the forwarder that the layer 3 protocol removed (or replaced) a
+   * connection.  The connections cached in FIB entries are resolved again on
+   * their next use.  Routes to the connection are not removed.
+   *
+   * The forwarder calls it itself from RemoveRoutesForConnection and when
+   * RemoveRoute takes the last route of a connection, as when a portal
+   * unregisters its anchors.  Whoever removes a connection with routes left,
+   * or gives its id to another connection, must call it.
+   *
+   * @param [in] connId The removed connection
+   */
+  void ConnectionRemoved (ccnx::CCNxConnection::ConnIdType connId);
+
+  /**
+   * @return The number of times a next hop's connection was looked up in the
+   *         layer 3 protocol rather than taken from the FIB entry
+   */
+  uint64_t GetNextHopResolutions (void) const;
+
+  /**
+   * Writes every route, sorted by name, in the text format of AcmeFlatFibWriter.
+   */
   virtual void PrintForwardingTable (Ptr<OutputStreamWrapper> streamWrapper) const;
 
+  /**
+   * Writes the routes selected by `writer` in its format.  Use this to dump a
+   * prefix, a sample, or a binary table of a large FIB.
+   *
+   * @return The number of routes written
+   */
+  uint64_t PrintForwardingTable (Ptr<OutputStreamWrapper> streamWrapper, const AcmeFlatFibWriter &writer) const;
+
   virtual void PrintForwardingStatistics (Ptr<OutputStreamWrapper> streamWrapper) const;
 
+  /**
+   * @return The packet counters and input latency histogram of this forwarder
+   */
+  const AcmeFlatForwarderStats & GetStats (void) const;
+
+  /**
+   * Signature of the "SampledRoute" trace source
+   *
+   * @param [in] packet The packet being sent (a cached Content Object on a content store hit)
+   * @param [in] ingress The connection the packet arrived on
+   * @param [in] routeError The routing result
+   * @param [in] egress The connections the packet is sent to (do not keep it, the list is reused)
+   */
+  typedef void (* SampledRouteTracedCallback)(Ptr<ccnx::CCNxPacket> packet, Ptr<ccnx::CCNxConnection> ingress,
+                                              ccnx::CCNxRoutingError::RoutingErrorType routeError,
+                                              Ptr<ccnx::CCNxConnectionList> egress);
+
+  /**
+   * Signature of the "InputQueueDrop" trace source
+   *
+   * @param [in] packet The dropped packet
+   * @param [in] ingress The connection the packet arrived on
+   * @param [in] policy The drop that removed it (TAIL_DROP for a full queue under CODEL)
+   */
+  typedef void (* InputQueueDropTracedCallback)(Ptr<ccnx::CCNxPacket> packet, Ptr<ccnx::CCNxConnection> ingress,
+                                                AcmeFlatBatchQueue::DropPolicyType policy);
+
+  /**
+   * Sets the congestion marks, shared with the other forwarders so a mark follows
+   * its Content Object packet downstream.  If none is set and "MarkingTarget" is,
+   * the forwarder creates its own in DoInitialize and marks only reach its own
+   * "CongestionMarked" trace.
+   */
+  void SetCongestionMarks (Ptr<AcmeFlatCongestionMarks> marks);
+
+  Ptr<AcmeFlatCongestionMarks> GetCongestionMarks (void) const;
+
+  /**
+   * @return The "MarkingTarget", zero if the forwarder does not mark
+   */
+  Time GetMarkingTarget (void) const;
+
+  /**
+   * Sets a FIB shared with other forwarders, of the same "FibType".  Must be
+   * called before the forwarder is initialized.  The forwarder reads the
+   * shared routes through an `AcmeFlatOverlayFib` and keeps the routes it
+   * changes in its own FIB.
+   */
+  void SetSharedFib (Ptr<AcmeFlatFib> fib);
+
+  /**
+   * Signature of the "CongestionMarked" trace source
+   *
+   * @param [in] packet The marked Content Object
+   * @param [in] egress A connection it is sent to
+   */
+  typedef void (* CongestionMarkedTracedCallback)(Ptr<ccnx::CCNxPacket> packet, Ptr<ccnx::CCNxConnection> egress);
+
+  /**
+   * Signature of the "InterestRateLimited" trace source
+   *
+   * @param [in] packet The Interest over the rate limit
+   * @param [in] ingress The connection the Interest arrived on
+   * @param [in] action Whether the Interest was dropped or only flagged
+   */
+  typedef void (* InterestRateLimitedTracedCallback)(Ptr<ccnx::CCNxPacket> packet, Ptr<ccnx::CCNxConnection> ingress,
+                                                     RateLimitActionType action);
+
+  /**
+   * Sets the content store.  Must be called before the forwarder is initialized,
+   * otherwise it creates a default (disabled) `AcmeFlatContentStore`.
+   *
+   * @param [in] contentStore The content store to use
+   */
+  void SetContentStore (Ptr<AcmeFlatContentStore> contentStore);
+
+  /**
+   * @return The content store
+   */
+  Ptr<AcmeFlatContentStore> GetContentStore (void) const;
+
+  /**
+   * Sets the strategy for multipath routes.  Must be called before the forwarder
+   * is initialized, otherwise it creates an `AcmeFlatHashStrategy`.
+   *
+   * @param [in] strategy The strategy to use
+   */
+  void SetStrategy (Ptr<AcmeFlatStrategy> strategy);
+
+  /**
+   * @return The strategy for multipath routes
+   */
+  Ptr<AcmeFlatStrategy> GetStrategy (void) const;
+
 protected:
   /**
    * Called when object life starts in the simulator
@@ -118,12 +486,14 @@ protected:
 
 private:
   /**
-   * Add a route by connection ID
+   * Add a route by connection ID.  If `name` is already routed, `connId` becomes
+   * one more of its next hops.
    * @param [in] connId
    * @param [in] name
-   * @return
+   * @param [in] cost The route cost, used by "MultipathWeighting"
+   * @return false if `connId` is localhost or already a next hop of `name`
    */
-  bool AddRoute (ccnx::CCNxConnection::ConnIdType connId, Ptr<const ccnx::CCNxName> name);
+  bool AddRoute (ccnx::CCNxConnection::ConnIdType connId, Ptr<const ccnx::CCNxName> name, uint32_t cost);
 
   /**
    * Remove a route by connection ID
@@ -135,33 +505,239 @@ private:
 
   /**
    * The common routing function called by RouteIn and RouteOut.
+   *
+   * @param [in] item The work item to route
+   * @param [in] egress The list to append the egress connections to
+   * @return The packet to send: the item's packet, or a Content Object from the content store
    */
-  virtual Ptr<ccnx::CCNxConnection> InnerReceive (Ptr<ccnx::CCNxStandardForwarderWorkItem> item);
+  virtual Ptr<ccnx::CCNxPacket> InnerReceive (Ptr<AcmeFlatWorkItem> item, Ptr<ccnx::CCNxConnectionList> egress);
 
   /**
    * Once receiving from a net device or local L4 protocol is resolved to
    * an ingress connection and the packet is decoded, call this function
    * for CCNx L3-level forwarding.
+   *
+   * Answers the Interest from the content store, aggregates it in the PIT, or
+   * forwards it by the FIB.  If `congested`, the PIT entry gets a congestion mark.
+   *
+   * @return The cached Content Object to return to `ingress`, or `packet`
    */
-  Ptr<ccnx::CCNxConnection> ForwardInterest (Ptr<ccnx::CCNxPacket> packet, Ptr<ccnx::CCNxConnection> ingress);
+  Ptr<ccnx::CCNxPacket> ForwardInterest (Ptr<ccnx::CCNxPacket> packet, Ptr<ccnx::CCNxConnection> ingress, uint64_t digest,
+                                         bool congested, Ptr<ccnx::CCNxConnectionList> egress);
 
   /**
    * Once receiving from a net device or local L4 protocol is resolved to
    * an ingress connection and the packet is decoded, call this function
    * for CCNx L3-level forwarding.
+   *
+   * Satisfies the PIT entry of the Content Object, caches it, and returns it
+   * to every pending ingress connection.
+   *
+   * @return true if an Interest of the satisfied PIT entry met congestion here
+   */
+  bool ForwardContentObject (Ptr<ccnx::CCNxPacket> packet, Ptr<ccnx::CCNxConnection> ingress, uint64_t digest,
+                             Ptr<ccnx::CCNxConnectionList> egress);
+
+  /**
+   * The type of FIB to create in DoInitialize.
+   *
+   * This value is set via the attribute "FibType".  The default is AcmeFlatMapFib.
+   */
+  TypeId m_fibType;
+
+  /**
+   * Maps a name to its next hops.  Exact match unless the FibType does longest
+   * prefix match.
+   */
+  Ptr<AcmeFlatFib> m_fib;
+
+  /**
+   * The FIB shared with other forwarders, or null
+   */
+  Ptr<AcmeFlatFib> m_sharedFib;
+
+  /**
+   * m_fib when there is a shared FIB, or null
+   */
+  Ptr<AcmeFlatOverlayFib> m_overlayFib;
+
+  /**
+   * Chooses the next hop of Interests on multipath routes
    */
-  Ptr<ccnx::CCNxConnection> ForwardContentObject (Ptr<ccnx::CCNxPacket> packet, Ptr<ccnx::CCNxConnection> ingress);
+  Ptr<AcmeFlatStrategy> m_strategy;
 
-  // a temporary fib for early testing.  Only has one mapping from a name
-  // to a connection id.  Only does exact match.
-  typedef std::map<Ptr<const ccnx::CCNxName>, ccnx::CCNxConnection::ConnIdType, ccnx::CCNxName::isLessPtrCCNxName> FibMapType;
+  /**
+   * @return The next hop `connId` of the route `name` matches, or null
+   */
+  AcmeFlatFib::NextHopType * LookupNextHop (Ptr<const ccnx::CCNxName> name, uint64_t digest,
+                                            ccnx::CCNxConnection::ConnIdType connId);
+
+  /**
+   * @return The connection of `nextHop`, using the cached one if it is from the current m_connectionEpoch
+   */
+  Ptr<ccnx::CCNxConnection> ResolveNextHop (AcmeFlatFib::NextHopType &nextHop);
+
+  /**
+   * The epoch of the connections cached in FIB entries.  Advanced by ConnectionRemoved.
+   */
+  uint64_t m_connectionEpoch;
+
+  /**
+   * The number of next hops resolved through m_ccnx (the others used their cached connection)
+   */
+  uint64_t m_nextHopResolutions;
+
+  BulkLoadReportType m_bulkLoad;
+
+  /**
+   * The names routed to each connection, kept in step with m_fib
+   */
+  AcmeFlatConnectionIndex m_connectionRoutes;
+
+  /**
+   * The counters per route of m_fibFilter, 0 for no filter.
+   *
+   * This value is set via the attribute "FibFilterCountersPerRoute".  The default is 0.
+   */
+  uint32_t m_fibFilterCountersPerRoute;
+
+  /**
+   * The digest of each name in m_fib, once per next hop
+   */
+  AcmeFlatBloomFilter m_fibFilter;
+
+  /**
+   * The prefix digests of the last name checked against m_fibFilter, kept to not allocate per Interest
+   */
+  std::vector<uint64_t> m_fibFilterDigests;
+
+  /**
+   * Adds a next hop of the name with `digest` to m_fibFilter, rebuilding it twice
+   * as large when it is over capacity.  Call after adding it to m_fib.
+   */
+  void FibFilterAdd (uint64_t digest);
+
+  /**
+   * Refills m_fibFilter from m_fib, with room for twice its next hops
+   */
+  void RebuildFibFilter (void);
+
+  /**
+   * Removes a next hop of the name with `digest` from m_fibFilter.  Call after
+   * removing it from m_fib.
+   */
+  void FibFilterRemove (uint64_t digest);
+
+  /**
+   * @return true if m_fibFilter shows that m_fib has no route for `name`
+   */
+  bool IsFilteredOut (const ccnx::CCNxName &name, uint64_t digest);
+
+  /**
+   * The number of unused names m_names keeps, 0 to not intern names.
+   *
+   * This value is set via the attribute "NameTableCapacity".  The default is 0.
+   */
+  uint32_t m_nameTableCapacity;
+
+  AcmeFlatNameTable m_names;
 
-  FibMapType m_fib;
+  /**
+   * @return The interned instance of `name`, or `name` if names are not interned
+   */
+  Ptr<const ccnx::CCNxName> InternName (Ptr<const ccnx::CCNxName> name, uint64_t digest);
+
+  /**
+   * The type of PIT to create in DoInitialize.
+   *
+   * This value is set via the attribute "PitType".  The default is AcmeFlatPit.
+   */
+  TypeId m_pitType;
+
+  /**
+   * The pending Interests, by name
+   */
+  Ptr<AcmeFlatPit> m_pit;
+
+  /**
+   * The cache of Content Objects
+   */
+  Ptr<AcmeFlatContentStore> m_contentStore;
+
+  /**
+   * Starts the expiry timer of a new PIT entry
+   */
+  void StartPitTimer (uint32_t handle);
+
+  /**
+   * Makes sure a simulator event is scheduled for the next tick of m_pitTimers
+   */
+  void SchedulePitTimerTick (void);
+
+  /**
+   * Simulator event: erases the expired PIT entries of the current tick and
+   * re-arms the timers of entries whose lifetime was extended
+   */
+  void PitTimerTick (void);
+
+  /**
+   * Called just before an expired PIT entry is erased.  Reports the timeout to
+   * m_strategy if the entry's Interest was timed.
+   */
+  void PitEntryExpired (uint32_t handle);
+
+  /**
+   * @return The first m_pitTimers tick at or after `time`
+   */
+  uint64_t GetPitTimerTick (Time time) const;
+
+  /**
+   * The expiry timers of PIT entries, by (handle, generation)
+   */
+  AcmeFlatTimerWheel m_pitTimers;
+
+  /**
+   * The length of one m_pitTimers tick.  PIT entries are erased up to one tick
+   * after they expire (Find already ignores them).
+   *
+   * This value is set via the attribute "PitTimerTick".  The default is 1 msec.
+   */
+  Time m_pitTimerTick;
+
+  /**
+   * The event for the next m_pitTimers tick
+   */
+  EventId m_pitTimerEvent;
+
+  /**
+   * The tick of m_pitTimerEvent, or AcmeFlatTimerWheel::Never if none is scheduled
+   */
+  uint64_t m_pitTimerEventTick;
+
+  /**
+   * Scratch list for PitTimerTick, kept to reuse its memory
+   */
+  std::vector<AcmeFlatTimerWheel::TimerType> m_expiredPitTimers;
+
+  /**
+   * The number of PIT timers started.  Scheduling each entry's expiry would cost this many simulator events.
+   */
+  uint64_t m_pitTimersStarted;
+
+  /**
+   * The number of simulator events scheduled for m_pitTimers
+   */
+  uint64_t m_pitTimerEvents;
+
+  /**
+   * The number of PIT entries erased by their timer
+   */
+  uint64_t m_pitEntriesExpired;
 
   /**
    * The storage type of the CCNxDelayQueue
    */
-  typedef ccnx::CCNxDelayQueue<ccnx::CCNxStandardForwarderWorkItem> DelayQueueType;
+  typedef ccnx::CCNxDelayQueue<AcmeFlatWorkItem> DelayQueueType;
 
   /**
    * Input queue used to simulate processing delay
@@ -174,14 +750,19 @@ private:
    * @param item [in] The work item being serviced
    * @return The service time of the work item
    */
-  Time GetServiceTime (Ptr<ccnx::CCNxStandardForwarderWorkItem> item);
+  Time GetServiceTime (Ptr<AcmeFlatWorkItem> item);
+
+  /**
+   * @return The layer delay of a work item: m_layerDelayConstant + m_layerDelaySlope * packetBytes
+   */
+  Time GetLayerDelay (Ptr<AcmeFlatWorkItem> item) const;
 
   /**
    * Callback from delay queue after a work item has waited its service time
    *
    * @param item [in] The work item to service
    */
-  void ServiceInputQueue (Ptr<ccnx::CCNxStandardForwarderWorkItem> item);
+  void ServiceInputQueue (Ptr<AcmeFlatWorkItem> item);
 
   /**
    * The layer delay is:
@@ -209,6 +790,271 @@ private:
    */
   unsigned m_layerDelayServers;
 
+  /**
+   * The number of simulated cores.  If 0, all work items share m_inputQueue
+   * and its m_layerDelayServers servers.  Otherwise each core has its own
+   * single-server queue (in m_coreQueues, or m_batchQueues in batch mode), and
+   * a work item goes to the core picked by its name digest, like RSS flow
+   * affinity on a NIC.
+   *
+   * This value is set via the attribute "Cores".  The default is 0.
+   */
+  uint32_t m_cores;
+
+  /**
+   * The input queues of the cores, when m_cores is not 0 and not in batch mode
+   */
+  std::vector<Ptr<DelayQueueType> > m_coreQueues;
+
+  std::vector<CoreStatsType> m_coreStats;
+
+  /**
+   * When the core queues were created, the start of the utilization and mean depth periods
+   */
+  Time m_coresStarted;
+
+  /**
+   * The most work items served as one batch.  With 0 or 1 the input queues are
+   * CCNxDelayQueues serving one item at a time (unless they are bounded); above
+   * 1 they are the AcmeFlatBatchQueues in m_batchQueues.
+   *
+   * This value is set via the attribute "BatchSize".  The default is 0.
+   */
+  uint32_t m_batchSize;
+
+  /**
+   * The fixed cost of a batch, on top of the layer delay of each of its items.
+   *
+   * This value is set via the attribute "BatchDelayConstant".  The default is 0.
+   */
+  Time m_batchDelayConstant;
+
+  /**
+   * In batch mode or with a bounded input queue, the input queue (one per core if m_cores is not 0)
+   */
+  std::vector<Ptr<AcmeFlatBatchQueue> > m_batchQueues;
+
+  /**
+   * Callback from a batch queue to compute the service time of a batch:
+   * m_batchDelayConstant plus the layer delay of each item
+   */
+  Time GetBatchServiceTime (const AcmeFlatBatchQueue::BatchType &batch);
+
+  /**
+   * The service time of each table probe, each name segment compared and each
+   * table insertion.  Set by the attributes "ProbeDelay", "SegmentCompareDelay"
+   * and "InsertionDelay".  The defaults are 0.
+   */
+  Time m_probeDelay;
+  Time m_segmentCompareDelay;
+  Time m_insertionDelay;
+
+  /**
+   * True if any per-operation delay is set, so work items are routed when their service starts
+   */
+  bool m_costModel;
+
+  /**
+   * The total service time charged for operations
+   */
+  Time m_operationsDelay;
+
+  /**
+   * Routes `item` now, keeping the result in the item for ServiceInputQueue
+   *
+   * @return The cost of the operations it took
+   */
+  Time RouteWorkItem (Ptr<AcmeFlatWorkItem> item);
+
+  /**
+   * The most work items waiting in each input queue, 0 for no limit.
+   *
+   * This value is set via the attribute "MaxInputQueueDepth".  The default is 0.
+   */
+  uint32_t m_maxInputQueueDepth;
+
+  /**
+   * How a bounded input queue drops.  Set by the attribute "InputQueueDropPolicy".  The default is TAIL_DROP.
+   */
+  AcmeFlatBatchQueue::DropPolicyType m_inputQueueDropPolicy;
+
+  /**
+   * The CoDel target sojourn time and interval.  Set by the attributes
+   * "CoDelTarget" and "CoDelInterval".  The defaults are 5 ms and 100 ms.
+   */
+  Time m_coDelTarget;
+  Time m_coDelInterval;
+
+  /**
+   * The input queue order.  Set by the attribute "InputQueueScheduler".  The default is FIFO.
+   */
+  AcmeFlatBatchQueue::SchedulerType m_inputQueueScheduler;
+
+  /**
+   * The DRR bytes per round for weight 1.  Set by the attribute "DrrQuantum".  The default is 1500.
+   */
+  uint32_t m_drrQuantum;
+
+  typedef std::map<ccnx::CCNxConnection::ConnIdType, uint32_t> IngressWeightMapType;
+
+  /**
+   * The weights given to SetIngressWeight, for queues created later
+   */
+  IngressWeightMapType m_ingressWeights;
+
+  IngressWaitMapType m_ingressWaits;
+
+  /**
+   * Callback from a bounded input queue for each work item it drops
+   */
+  void InputQueueDrop (Ptr<AcmeFlatWorkItem> item, AcmeFlatBatchQueue::DropPolicyType policy);
+
+  TracedCallback<Ptr<ccnx::CCNxPacket>, Ptr<ccnx::CCNxConnection>, AcmeFlatBatchQueue::DropPolicyType> m_inputQueueDropTrace;
+
+  /**
+   * The Interests per second admitted from each ingress connection, 0 for no limit.
+   *
+   * This value is set via the attribute "InterestRateLimit".  The default is 0.
+   */
+  double m_interestRateLimit;
+
+  /**
+   * The most Interests an ingress connection may send at once within its rate limit.
+   *
+   * This value is set via the attribute "InterestBurstLimit".  The default is 32.
+   */
+  uint32_t m_interestBurstLimit;
+
+  /**
+   * Set by the attribute "InterestRateLimitAction".  The default is RATE_LIMIT_DROP.
+   */
+  RateLimitActionType m_interestRateLimitAction;
+
+  /**
+   * The token buckets of the ingress connections, created on their first Interest
+   */
+  IngressRateLimitMapType m_ingressRateLimits;
+
+  /**
+   * Charges an Interest to the token bucket of its ingress.  Other packets always conform.
+   *
+   * @return false if the packet is over the rate limit and is to be dropped
+   */
+  bool ConformsToRateLimit (Ptr<ccnx::CCNxPacket> packet, Ptr<ccnx::CCNxConnection> ingress);
+
+  TracedCallback<Ptr<ccnx::CCNxPacket>, Ptr<ccnx::CCNxConnection>, RateLimitActionType> m_interestRateLimitedTrace;
+
+  /**
+   * The input queue sojourn time above which a packet meets congestion, 0 for never.
+   *
+   * This value is set via the attribute "MarkingTarget".  The default is 0.
+   */
+  Time m_markingTarget;
+
+  Ptr<AcmeFlatCongestionMarks> m_congestionMarks;
+
+  /**
+   * Sets the mark of the Content Object `packet` sent to `egress` in
+   * m_congestionMarks, and if `marked` fires m_congestionMarkedTrace for each egress
+   */
+  void MarkContentObject (Ptr<ccnx::CCNxPacket> packet, bool marked, Ptr<ccnx::CCNxConnectionList> egress);
+
+  TracedCallback<Ptr<ccnx::CCNxPacket>, Ptr<ccnx::CCNxConnection> > m_congestionMarkedTrace;
+
+  /**
+   * The number of most requested names to keep, 0 to not count names.  The
+   * sketch size is set by "HotNameSketchWidth" and "HotNameSketchDepth".
+   *
+   * This value is set via the attribute "HotNames".  The default is 0.
+   */
+  uint32_t m_hotNameCount;
+  uint32_t m_hotNameSketchWidth;
+  uint32_t m_hotNameSketchDepth;
+
+  /**
+   * The Interest name counts, sized in DoInitialize
+   */
+  AcmeFlatHeavyHitters m_hotNames;
+
+  /**
+   * Puts a work item on m_inputQueue, or on the queue of its core
+   */
+  void EnqueueWorkItem (Ptr<AcmeFlatWorkItem> item);
+
+  /**
+   * Accumulates m_coreStats[core].depthTime up to now and adds `delta` to its depth
+   */
+  void ChangeCoreDepth (uint32_t core, int64_t delta);
+
+  /**
+   * @return A work item from m_freeWorkItems, or a new one
+   */
+  Ptr<AcmeFlatWorkItem> AllocateWorkItem (Ptr<ccnx::CCNxPacket> packet,
+                                          Ptr<ccnx::CCNxConnection> ingressConnection,
+                                          Ptr<ccnx::CCNxConnection> egressConnection);
+
+  /**
+   * Returns a serviced work item to m_freeWorkItems
+   */
+  void ReleaseWorkItem (Ptr<AcmeFlatWorkItem> item);
+
+  /**
+   * @return An empty connection list from m_freeConnectionLists, or a new one
+   */
+  Ptr<ccnx::CCNxConnectionList> AllocateConnectionList (void);
+
+  /**
+   * Returns a connection list to m_freeConnectionLists once the route callback is done with it
+   */
+  void ReleaseConnectionList (Ptr<ccnx::CCNxConnectionList> connections);
+
+  /**
+   * Appends `connection` to `egress`, reusing a list node from m_spareEgressNodes
+   */
+  void AddEgress (Ptr<ccnx::CCNxConnectionList> egress, Ptr<ccnx::CCNxConnection> connection);
+
+  /**
+   * Empties `egress`, moving its list nodes to m_spareEgressNodes
+   */
+  void ClearEgress (Ptr<ccnx::CCNxConnectionList> egress);
+
+  /**
+   * Serviced work items.  An item is only reused if nothing else still holds a reference to it.
+   */
+  std::vector<Ptr<AcmeFlatWorkItem> > m_freeWorkItems;
+
+  /**
+   * Connection lists passed to the route callback.  A list is only reused if
+   * the callback did not keep a reference to it.
+   */
+  std::vector<Ptr<ccnx::CCNxConnectionList> > m_freeConnectionLists;
+
+  /**
+   * The list nodes of emptied connection lists (holding null connections)
+   */
+  ccnx::CCNxConnectionList m_spareEgressNodes;
+
+  /**
+   * How often m_freeWorkItems and m_freeConnectionLists were used
+   */
+  PoolStatsType m_poolStats;
+
+  /**
+   * Fire m_sampledRouteTrace for 1 in this many routed packets, 0 for never.
+   *
+   * This value is set via the attribute "TraceSampleInterval".  The default is 0.
+   */
+  uint32_t m_traceSampleInterval;
+
+  /**
+   * Packets routed since m_sampledRouteTrace last fired
+   */
+  uint32_t m_traceSampleCount;
+
+  TracedCallback<Ptr<ccnx::CCNxPacket>, Ptr<ccnx::CCNxConnection>,
+                 ccnx::CCNxRoutingError::RoutingErrorType, Ptr<ccnx::CCNxConnectionList> > m_sampledRouteTrace;
+
+  AcmeFlatForwarderStats m_stats;
 };
 }
 }
@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "acme-flat-hash-fib.h"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+#include "ns3/acme-flat-name-table.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+NS_LOG_COMPONENT_DEFINE ("AcmeFlatHashFib");
+NS_OBJECT_ENSURE_REGISTERED (AcmeFlatHashFib);
+
+static const uint32_t _defaultInitialCapacity = 1024;
+static const double _defaultMaxLoadFactor = 0.7;
+
+TypeId
+AcmeFlatHashFib::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ccnx::AcmeFlatHashFib")
+    .SetParent<AcmeFlatFib> ()
+    .SetGroupName ("CCNx")
+    .AddConstructor<AcmeFlatHashFib> ()
+    .AddAttribute ("InitialCapacity", "The number of table slots allocated with the first route (rounded up to a power of 2)",
+                   UintegerValue (_defaultInitialCapacity),
+                   MakeUintegerAccessor (&AcmeFlatHashFib::m_initialCapacity),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("MaxLoadFactor", "The fraction of occupied slots above which the table doubles",
+                   DoubleValue (_defaultMaxLoadFactor),
+                   MakeDoubleAccessor (&AcmeFlatHashFib::m_maxLoadFactor),
+                   MakeDoubleChecker<double> (0.1, 0.95))
+  ;
+  return tid;
+}
+
+AcmeFlatHashFib::AcmeFlatHashFib ()
+  : m_mask (0), m_count (0), m_initialCapacity (_defaultInitialCapacity), m_maxLoadFactor (_defaultMaxLoadFactor)
+{
+  // empty
+}
+
+AcmeFlatHashFib::~AcmeFlatHashFib ()
+{
+  // empty (use DoDispose)
+}
+
+void
+AcmeFlatHashFib::DoDispose (void)
+{
+  m_digests.clear ();
+  m_slots.clear ();
+  m_mask = 0;
+  m_count = 0;
+  AcmeFlatFib::DoDispose ();
+}
+
+bool
+AcmeFlatHashFib::Find (const CCNxName &name, uint64_t digest, size_t &index) const
+{
+  if (m_count == 0)
+    {
+      return false;
+    }
+
+  size_t i = digest & m_mask;
+  while (m_digests[i] != 0)
+    {
+      m_operations.probes++;
+      if (m_digests[i] == digest)
+        {
+          if (AcmeFlatNameTable::Equals (*m_slots[i].name, name, m_operations.segmentCompares))
+            {
+              index = i;
+              return true;
+            }
+        }
+      i = (i + 1) & m_mask;
+    }
+  m_operations.probes++;
+  return false;
+}
+
+void
+AcmeFlatHashFib::Insert (uint64_t digest, Ptr<const CCNxName> name, const NextHopType &nextHop)
+{
+  size_t i = digest & m_mask;
+  while (m_digests[i] != 0)
+    {
+      i = (i + 1) & m_mask;
+    }
+  m_digests[i] = digest;
+  m_slots[i].name = name;
+  m_slots[i].nextHop = nextHop;
+  m_count++;
+}
+
+void
+AcmeFlatHashFib::Erase (size_t index)
+{
+  m_digests[index] = 0;
+  m_slots[index] = SlotType ();
+  m_count--;
+
+  // Backward-shift: move up any entry whose home slot is not in (hole, j]
+  size_t hole = index;
+  size_t j = (index + 1) & m_mask;
+  while (m_digests[j] != 0)
+    {
+      size_t home = m_digests[j] & m_mask;
+      bool movable = (hole <= j) ? (home <= hole || home > j) : (home <= hole && home > j);
+      if (movable)
+        {
+          m_digests[hole] = m_digests[j];
+          m_slots[hole] = m_slots[j];
+          m_digests[j] = 0;
+          m_slots[j] = SlotType ();
+          hole = j;
+        }
+      j = (j + 1) & m_mask;
+    }
+}
+
+void
+AcmeFlatHashFib::Resize (size_t capacity)
+{
+  NS_LOG_FUNCTION (this << capacity);
+  NS_ASSERT_MSG ((capacity & (capacity - 1)) == 0, "Capacity must be a power of 2: " << capacity);
+
+  std::vector<uint64_t> oldDigests;
+  std::vector<SlotType> oldSlots;
+  oldDigests.swap (m_digests);
+  oldSlots.swap (m_slots);
+
+  m_digests.assign (capacity, 0);
+  m_slots.resize (capacity);
+  m_mask = capacity - 1;
+  m_count = 0;
+
+  for (size_t i = 0; i < oldDigests.size (); ++i)
+    {
+      if (oldDigests[i] != 0)
+        {
+          Insert (oldDigests[i], oldSlots[i].name, oldSlots[i].nextHop);
+        }
+    }
+}
+
+bool
+AcmeFlatHashFib::AddRoute (Ptr<const CCNxName> name, uint64_t digest, CCNxConnection::ConnIdType connId)
+{
+  NS_LOG_FUNCTION (this << name << connId);
+
+  size_t index;
+  if (Find (*name, digest, index))
+    {
+      return false;
+    }
+
+  if (m_digests.empty ())
+    {
+      size_t capacity = 1;
+      while (capacity < m_initialCapacity)
+        {
+          capacity <<= 1;
+        }
+      Resize (capacity);
+    }
+  else if (m_count + 1 > m_maxLoadFactor * m_digests.size ())
+    {
+      Resize (m_digests.size () << 1);
+    }
+
+  Insert (digest, name, MakeNextHop (connId));
+  m_operations.insertions++;
+  return true;
+}
+
+size_t
+AcmeFlatHashFib::AddRoutes (const std::vector<BulkRouteType> &routes)
+{
+  NS_LOG_FUNCTION (this << routes.size ());
+
+  size_t capacity = 1;
+  while (capacity < m_initialCapacity || capacity < m_digests.size ()
+         || m_count + routes.size () > m_maxLoadFactor * capacity)
+    {
+      capacity <<= 1;
+    }
+  if (capacity != m_digests.size ())
+    {
+      Resize (capacity);
+    }
+
+  size_t added = 0;
+  for (size_t i = 0; i < routes.size (); ++i)
+    {
+      size_t index;
+      if (!Find (*routes[i].name, routes[i].digest, index))
+        {
+          NextHopType nextHop = MakeNextHop (routes[i].connId);
+          nextHop.cost = routes[i].cost;
+          Insert (routes[i].digest, routes[i].name, nextHop);
+          m_operations.insertions++;
+          added++;
+        }
+    }
+  return added;
+}
+
+bool
+AcmeFlatHashFib::RemoveRoute (Ptr<const CCNxName> name, uint64_t digest, CCNxConnection::ConnIdType connId)
+{
+  NS_LOG_FUNCTION (this << name << connId);
+
+  size_t index;
+  if (!Find (*name, digest, index))
+    {
+      return false;
+    }
+
+  switch (RemoveNextHop (m_slots[index].nextHop, connId))
+    {
+    case ROUTE_EMPTY:
+      Erase (index);
+      return true;
+    case NEXT_HOP_REMOVED:
+      return true;
+    default:
+      return false;
+    }
+}
+
+bool
+AcmeFlatHashFib::Lookup (Ptr<const CCNxName> name, uint64_t digest, CCNxConnection::ConnIdType &connId) const
+{
+  size_t index;
+  if (Find (*name, digest, index))
+    {
+      connId = m_slots[index].nextHop.connId;
+      return true;
+    }
+  return false;
+}
+
+AcmeFlatFib::NextHopType *
+AcmeFlatHashFib::LookupNextHop (Ptr<const CCNxName> name, uint64_t digest)
+{
+  size_t index;
+  if (Find (*name, digest, index))
+    {
+      return &m_slots[index].nextHop;
+    }
+  return 0;
+}
+
+AcmeFlatFib::NextHopType *
+AcmeFlatHashFib::FindRoute (Ptr<const CCNxName> name, uint64_t digest)
+{
+  return LookupNextHop (name, digest);
+}
+
+bool
+AcmeFlatHashFib::IsExactMatch (void) const
+{
+  return true;
+}
+
+void
+AcmeFlatHashFib::GetRoutes (std::vector<RouteType> &routes) const
+{
+  routes.reserve (routes.size () + m_count);
+  for (size_t i = 0; i < m_slots.size (); ++i)
+    {
+      if (m_digests[i] != 0)
+        {
+          AppendRoutes (PeekPointer (m_slots[i].name), m_slots[i].nextHop, routes);
+        }
+    }
+}
+
+size_t
+AcmeFlatHashFib::GetSize (void) const
+{
+  return m_count;
+}
+
+size_t
+AcmeFlatHashFib::GetMemoryUsage (void) const
+{
+  return m_digests.capacity () * sizeof(uint64_t) + m_slots.capacity () * sizeof(SlotType) + GetNextHopMemoryUsage ();
+}
+
+size_t
+AcmeFlatHashFib::GetCapacity (void) const
+{
+  return m_digests.size ();
+}
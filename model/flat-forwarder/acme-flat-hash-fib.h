@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_ACMEFLATHASHFIB_H
+#define CCNS3SIM_ACMEFLATHASHFIB_H
+
+#include <vector>
+#include "ns3/acme-flat-fib.h"
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * An exact-match FIB in an open-addressing hash table keyed by `AcmeFlatNameDigest`.
+ *
+ * The table uses linear probing over a power-of-two array of digests, kept
+ * separate from the (name, connId) slots so a probe sequence only touches the
+ * digest array.  A full name comparison is only done when the digests match.
+ * Removal uses backward-shift deletion, so there are no tombstones and probe
+ * sequences stay short under route churn.
+ *
+ * The table doubles when it exceeds the maximum load factor.
+ */
+class AcmeFlatHashFib : public AcmeFlatFib
+{
+public:
+  static TypeId GetTypeId (void);
+
+  AcmeFlatHashFib ();
+  virtual ~AcmeFlatHashFib ();
+
+  virtual bool AddRoute (Ptr<const ccnx::CCNxName> name, uint64_t digest, ccnx::CCNxConnection::ConnIdType connId);
+
+  /**
+   * Grows the table once to hold the whole batch, then inserts each route.
+   */
+  virtual size_t AddRoutes (const std::vector<BulkRouteType> &routes);
+
+  virtual bool RemoveRoute (Ptr<const ccnx::CCNxName> name, uint64_t digest, ccnx::CCNxConnection::ConnIdType connId);
+
+  virtual bool Lookup (Ptr<const ccnx::CCNxName> name, uint64_t digest, ccnx::CCNxConnection::ConnIdType &connId) const;
+
+  virtual NextHopType * LookupNextHop (Ptr<const ccnx::CCNxName> name, uint64_t digest);
+
+  virtual NextHopType * FindRoute (Ptr<const ccnx::CCNxName> name, uint64_t digest);
+
+  virtual bool IsExactMatch (void) const;
+
+  virtual void GetRoutes (std::vector<RouteType> &routes) const;
+
+  virtual size_t GetSize (void) const;
+
+  virtual size_t GetMemoryUsage (void) const;
+
+  /**
+   * @return The number of slots in the table (a power of 2, or 0 before the first route)
+   */
+  size_t GetCapacity (void) const;
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  typedef struct
+  {
+    Ptr<const ccnx::CCNxName> name;
+    NextHopType nextHop;
+  } SlotType;
+
+  /**
+   * Finds the slot of `name`.
+   *
+   * @param [out] index The slot index if found
+   * @return true if found
+   */
+  bool Find (const ccnx::CCNxName &name, uint64_t digest, size_t &index) const;
+
+  /**
+   * Puts an entry in the first free slot of its probe sequence.  Does not check for duplicates.
+   */
+  void Insert (uint64_t digest, Ptr<const ccnx::CCNxName> name, const NextHopType &nextHop);
+
+  /**
+   * Empties the slot at `index` and shifts back any entries displaced past it.
+   */
+  void Erase (size_t index);
+
+  /**
+   * Re-allocates the table with `capacity` slots and re-inserts every entry.
+   *
+   * @param [in] capacity The new size (must be a power of 2)
+   */
+  void Resize (size_t capacity);
+
+  /**
+   * Digest of each slot, 0 means empty.
+   */
+  std::vector<uint64_t> m_digests;
+
+  std::vector<SlotType> m_slots;
+
+  size_t m_mask;
+  size_t m_count;
+
+  /**
+   * The capacity of the table when the first route is added.  Set by the "InitialCapacity" attribute.
+   */
+  uint32_t m_initialCapacity;
+
+  /**
+   * The fraction of occupied slots above which the table doubles.  Set by the "MaxLoadFactor" attribute.
+   */
+  double m_maxLoadFactor;
+};
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATHASHFIB_H
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <cmath>
+#include "acme-flat-hash-strategy.h"
+
+#include "ns3/log.h"
+#include "ns3/boolean.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+NS_LOG_COMPONENT_DEFINE ("AcmeFlatHashStrategy");
+NS_OBJECT_ENSURE_REGISTERED (AcmeFlatHashStrategy);
+
+TypeId
+AcmeFlatHashStrategy::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ccnx::AcmeFlatHashStrategy")
+    .SetParent<AcmeFlatStrategy> ()
+    .SetGroupName ("CCNx")
+    .AddConstructor<AcmeFlatHashStrategy> ()
+    .AddAttribute ("Weighting", "Weight the next hops of a route by 1 / (1 + cost) instead of evenly",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&AcmeFlatHashStrategy::m_weighting),
+                   MakeBooleanChecker ())
+  ;
+  return tid;
+}
+
+AcmeFlatHashStrategy::AcmeFlatHashStrategy ()
+  : m_weighting (false)
+{
+  // empty
+}
+
+AcmeFlatHashStrategy::~AcmeFlatHashStrategy ()
+{
+  // empty
+}
+
+AcmeFlatFib::NextHopType &
+AcmeFlatHashStrategy::SelectNextHop (AcmeFlatFib &fib, AcmeFlatFib::NextHopType &first, uint64_t digest,
+                                     CCNxConnection::ConnIdType ingressId)
+{
+  // Weighted rendezvous hashing: each next hop draws u in (0, 1) from (digest, connId)
+  // and scores -weight / ln(u).  The highest score wins, so removing a next hop only
+  // moves the names it had won.
+  AcmeFlatFib::NextHopType *best = &first;
+  double bestScore = -1.0;
+  size_t count = fib.GetNextHopCount (first);
+  for (size_t i = 0; i < count; ++i)
+    {
+      AcmeFlatFib::NextHopType &nextHop = fib.GetNextHop (first, i);
+      if (nextHop.connId == ingressId)
+        {
+          continue;
+        }
+
+      // splitmix64 finalizer
+      uint64_t h = digest ^ ((uint64_t) (nextHop.connId + 1) * 0x9e3779b97f4a7c15ULL);
+      h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+      h ^= h >> 31;
+
+      double u = ((h >> 11) + 0.5) / 9007199254740992.0;
+      double weight = m_weighting ? 1.0 / (1.0 + nextHop.cost) : 1.0;
+      double score = -weight / std::log (u);
+      if (score > bestScore)
+        {
+          bestScore = score;
+          best = &nextHop;
+        }
+    }
+  return *best;
+}
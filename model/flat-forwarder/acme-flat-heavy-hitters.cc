@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+#include <algorithm>
+#include "acme-flat-heavy-hitters.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+/**
+ * Odd multipliers for the multiplicative hash of each sketch row
+ */
+static const uint64_t _rowMultipliers[] = {
+  0x9E3779B97F4A7C15ULL, 0xC2B2AE3D27D4EB4FULL, 0x165667B19E3779F9ULL, 0xD6E8FEB86659FD93ULL,
+  0xFF51AFD7ED558CCDULL, 0xC4CEB9FE1A85EC53ULL, 0x94D049BB133111EBULL, 0xBF58476D1CE4E5B9ULL
+};
+
+static const uint32_t _maxDepth = sizeof (_rowMultipliers) / sizeof (_rowMultipliers[0]);
+
+/**
+ * A counter sticks at this value rather than wrap
+ */
+static const uint32_t _maxCount = 0xFFFFFFFF;
+
+static bool
+IsMoreFrequent (const AcmeFlatHeavyHitters::HitterType &a, const AcmeFlatHeavyHitters::HitterType &b)
+{
+  return a.count > b.count;
+}
+
+AcmeFlatHeavyHitters::AcmeFlatHeavyHitters (uint32_t width, uint32_t depth, uint32_t k)
+  : m_width (1), m_depth (std::max (1u, std::min (depth, _maxDepth))), m_k (k), m_index (2), m_total (0)
+{
+  while (m_width < width)
+    {
+      m_width <<= 1;
+    }
+  m_counters.assign (static_cast<size_t> (m_width) * m_depth, 0);
+  m_hitters.reserve (m_k);
+  m_heap.reserve (m_k);
+  m_positions.reserve (m_k);
+
+  // Never holds more than k names, so never grows
+  m_index.Reserve (m_k);
+}
+
+uint32_t
+AcmeFlatHeavyHitters::GetColumn (uint64_t digest, uint32_t row) const
+{
+  // The high bits of the product are the best mixed
+  return static_cast<uint32_t> (((digest * _rowMultipliers[row]) >> 32) & (m_width - 1));
+}
+
+void
+AcmeFlatHeavyHitters::Add (Ptr<const CCNxName> name, uint64_t digest)
+{
+  m_total++;
+
+  uint32_t estimate = _maxCount;
+  for (uint32_t row = 0; row < m_depth; ++row)
+    {
+      estimate = std::min (estimate, m_counters[row * m_width + GetColumn (digest, row)]);
+    }
+  if (estimate < _maxCount)
+    {
+      estimate++;
+    }
+
+  // Conservative update: raise only the counters below the new estimate
+  for (uint32_t row = 0; row < m_depth; ++row)
+    {
+      uint32_t &counter = m_counters[row * m_width + GetColumn (digest, row)];
+      counter = std::max (counter, estimate);
+    }
+
+  if (m_k == 0)
+    {
+      return;
+    }
+
+  // A name in the heap has a count of at least the root's, so a smaller
+  // estimate is neither in the heap nor going into it
+  if (m_heap.size () == m_k && estimate <= m_hitters[m_heap[0]].count)
+    {
+      return;
+    }
+
+  size_t position = m_index.Probe (digest);
+  uint32_t slot;
+  if (m_index.Next (digest, position, slot))
+    {
+      m_hitters[slot].count = estimate;
+      SiftDown (m_positions[slot]);
+    }
+  else if (m_heap.size () < m_k)
+    {
+      HitterType hitter = { name, digest, estimate };
+      slot = static_cast<uint32_t> (m_hitters.size ());
+      m_hitters.push_back (hitter);
+      m_heap.push_back (slot);
+      m_positions.push_back (slot);
+      m_index.Insert (digest, slot);
+      SiftUp (m_heap.size () - 1);
+    }
+  else
+    {
+      // The root's slot takes the new name
+      slot = m_heap[0];
+      m_index.Erase (m_hitters[slot].digest, slot);
+      HitterType hitter = { name, digest, estimate };
+      m_hitters[slot] = hitter;
+      m_index.Insert (digest, slot);
+      SiftDown (0);
+    }
+}
+
+uint64_t
+AcmeFlatHeavyHitters::Estimate (uint64_t digest) const
+{
+  uint32_t estimate = _maxCount;
+  for (uint32_t row = 0; row < m_depth; ++row)
+    {
+      estimate = std::min (estimate, m_counters[row * m_width + GetColumn (digest, row)]);
+    }
+  return estimate;
+}
+
+void
+AcmeFlatHeavyHitters::Swap (size_t a, size_t b)
+{
+  std::swap (m_heap[a], m_heap[b]);
+  m_positions[m_heap[a]] = static_cast<uint32_t> (a);
+  m_positions[m_heap[b]] = static_cast<uint32_t> (b);
+}
+
+void
+AcmeFlatHeavyHitters::SiftUp (size_t position)
+{
+  while (position > 0)
+    {
+      size_t parent = (position - 1) / 2;
+      if (m_hitters[m_heap[parent]].count <= m_hitters[m_heap[position]].count)
+        {
+          break;
+        }
+      Swap (parent, position);
+      position = parent;
+    }
+}
+
+void
+AcmeFlatHeavyHitters::SiftDown (size_t position)
+{
+  for (;;)
+    {
+      size_t smallest = position;
+      size_t left = 2 * position + 1;
+      size_t right = left + 1;
+      if (left < m_heap.size () && m_hitters[m_heap[left]].count < m_hitters[m_heap[smallest]].count)
+        {
+          smallest = left;
+        }
+      if (right < m_heap.size () && m_hitters[m_heap[right]].count < m_hitters[m_heap[smallest]].count)
+        {
+          smallest = right;
+        }
+      if (smallest == position)
+        {
+          break;
+        }
+      Swap (smallest, position);
+      position = smallest;
+    }
+}
+
+std::vector<AcmeFlatHeavyHitters::HitterType>
+AcmeFlatHeavyHitters::GetTopK (void) const
+{
+  std::vector<HitterType> top (m_hitters);
+  std::sort (top.begin (), top.end (), IsMoreFrequent);
+  return top;
+}
+
+uint64_t
+AcmeFlatHeavyHitters::GetTotal (void) const
+{
+  return m_total;
+}
+
+size_t
+AcmeFlatHeavyHitters::GetMemoryUsage (void) const
+{
+  return m_counters.capacity () * sizeof (uint32_t)
+         + m_hitters.capacity () * sizeof (HitterType)
+         + (m_heap.capacity () + m_positions.capacity ()) * sizeof (uint32_t)
+         + m_index.GetMemoryUsage ();
+}
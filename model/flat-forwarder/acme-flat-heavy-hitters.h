@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+#ifndef CCNS3SIM_ACMEFLATHEAVYHITTERS_H
+#define CCNS3SIM_ACMEFLATHEAVYHITTERS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "ns3/ptr.h"
+#include "ns3/ccnx-name.h"
+#include "ns3/acme-flat-digest-index.h"
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * Finds the most frequent names of a stream in fixed memory: a Count-Min
+ * sketch estimates the count of every name, and a min-heap keeps the `k`
+ * names with the highest estimates seen so far.
+ *
+ * The sketch has `depth` rows of `width` counters; a name counts in one
+ * counter per row, picked by its `AcmeFlatNameDigest`, and its estimate is the
+ * smallest of them.  Estimates never undercount.  With conservative update
+ * (only the counters at the minimum are raised) a name is overcounted by at
+ * most about total / width with high probability.
+ *
+ * Add costs `depth` counter updates.  Only a name whose estimate reaches the
+ * smallest count in the heap touches the heap, at O(log k).  The names kept
+ * stay in fixed slots found by an `AcmeFlatDigestIndex` sized for `k` up
+ * front, and the heap orders slot numbers, so replacing a name allocates
+ * nothing.  The memory is `width * depth` counters plus `k` names, whatever
+ * the number of distinct names.
+ */
+class AcmeFlatHeavyHitters
+{
+public:
+  /**
+   * @param [in] width The counters per sketch row (rounded up to a power of 2)
+   * @param [in] depth The sketch rows
+   * @param [in] k The number of names to keep (0 to only keep the sketch)
+   */
+  AcmeFlatHeavyHitters (uint32_t width = 4096, uint32_t depth = 4, uint32_t k = 10);
+
+  /**
+   * Counts one occurrence of `name`
+   *
+   * @param [in] name The name
+   * @param [in] digest The AcmeFlatNameDigest of `name`
+   */
+  void Add (Ptr<const ccnx::CCNxName> name, uint64_t digest);
+
+  /**
+   * @return The sketch estimate of the count of the name with `digest`
+   */
+  uint64_t Estimate (uint64_t digest) const;
+
+  typedef struct
+  {
+    Ptr<const ccnx::CCNxName> name;
+    uint64_t digest;
+    uint64_t count;             //< the estimate when the name was last counted
+  } HitterType;
+
+  /**
+   * @return The names kept, most frequent first
+   */
+  std::vector<HitterType> GetTopK (void) const;
+
+  /**
+   * @return The number of Add calls
+   */
+  uint64_t GetTotal (void) const;
+
+  /**
+   * @return The bytes of the sketch, the names kept, the heap and its index
+   */
+  size_t GetMemoryUsage (void) const;
+
+private:
+  uint32_t GetColumn (uint64_t digest, uint32_t row) const;
+
+  void SiftUp (size_t position);
+  void SiftDown (size_t position);
+  void Swap (size_t a, size_t b);
+
+  uint32_t m_width;
+  uint32_t m_depth;
+  uint32_t m_k;
+
+  /**
+   * The sketch, row by row
+   */
+  std::vector<uint32_t> m_counters;
+
+  /**
+   * The names kept, each in a slot it holds until it is replaced
+   */
+  std::vector<HitterType> m_hitters;
+
+  /**
+   * Min-heap of slots of m_hitters on count, so the root is the first to be replaced
+   */
+  std::vector<uint32_t> m_heap;
+
+  /**
+   * The position in m_heap of each slot
+   */
+  std::vector<uint32_t> m_positions;
+
+  /**
+   * The slot of each name kept, by digest
+   */
+  AcmeFlatDigestIndex m_index;
+
+  uint64_t m_total;
+};
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATHEAVYHITTERS_H
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "acme-flat-latency-histogram.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+
+const unsigned AcmeFlatLatencyHistogram::SubBucketBits;
+const unsigned AcmeFlatLatencyHistogram::SubBuckets;
+
+// Values below SubBuckets have a bucket each; every power of 2 above has SubBuckets
+static const unsigned _bucketCount = (64 - AcmeFlatLatencyHistogram::SubBucketBits + 1) * AcmeFlatLatencyHistogram::SubBuckets;
+
+/**
+ * @return The index of the highest set bit of a non-zero word
+ */
+static unsigned
+HighestBit (uint64_t word)
+{
+  unsigned bit = 0;
+  for (unsigned shift = 32; shift > 0; shift >>= 1)
+    {
+      if (word >> shift)
+        {
+          word >>= shift;
+          bit += shift;
+        }
+    }
+  return bit;
+}
+
+AcmeFlatLatencyHistogram::AcmeFlatLatencyHistogram ()
+  : m_counts (_bucketCount, 0), m_count (0), m_min (0), m_max (0), m_sum (0)
+{
+  // empty
+}
+
+unsigned
+AcmeFlatLatencyHistogram::GetBucket (uint64_t value)
+{
+  if (value < SubBuckets)
+    {
+      return (unsigned) value;
+    }
+  unsigned exponent = HighestBit (value);
+  unsigned mantissa = (unsigned) (value >> (exponent - SubBucketBits)) & (SubBuckets - 1);
+  return (exponent - SubBucketBits + 1) * SubBuckets + mantissa;
+}
+
+uint64_t
+AcmeFlatLatencyHistogram::GetBucketUpperBound (unsigned bucket)
+{
+  if (bucket < SubBuckets)
+    {
+      return bucket;
+    }
+  unsigned exponent = bucket / SubBuckets + SubBucketBits - 1;
+  uint64_t mantissa = bucket % SubBuckets;
+  uint64_t width = 1ULL << (exponent - SubBucketBits);
+  return ((SubBuckets + mantissa) << (exponent - SubBucketBits)) + width - 1;
+}
+
+void
+AcmeFlatLatencyHistogram::Record (Time latency)
+{
+  int64_t nanoseconds = latency.GetNanoSeconds ();
+  uint64_t value = nanoseconds > 0 ? (uint64_t) nanoseconds : 0;
+
+  m_counts[GetBucket (value)]++;
+  if (m_count == 0 || value < m_min)
+    {
+      m_min = value;
+    }
+  if (value > m_max)
+    {
+      m_max = value;
+    }
+  m_count++;
+  m_sum += value;
+}
+
+uint64_t
+AcmeFlatLatencyHistogram::GetCount (void) const
+{
+  return m_count;
+}
+
+Time
+AcmeFlatLatencyHistogram::GetMin (void) const
+{
+  return NanoSeconds (m_min);
+}
+
+Time
+AcmeFlatLatencyHistogram::GetMax (void) const
+{
+  return NanoSeconds (m_max);
+}
+
+Time
+AcmeFlatLatencyHistogram::GetMean (void) const
+{
+  return m_count > 0 ? NanoSeconds ((uint64_t) (m_sum / m_count)) : NanoSeconds (0);
+}
+
+Time
+AcmeFlatLatencyHistogram::GetPercentile (double percentile) const
+{
+  if (m_count == 0)
+    {
+      return NanoSeconds (0);
+    }
+
+  // The rank of the value at `percentile`, 1-based
+  uint64_t rank = (uint64_t) (percentile / 100.0 * m_count + 0.5);
+  rank = rank < 1 ? 1 : (rank > m_count ? m_count : rank);
+
+  uint64_t seen = 0;
+  for (unsigned bucket = 0; bucket < m_counts.size (); ++bucket)
+    {
+      seen += m_counts[bucket];
+      if (seen >= rank)
+        {
+          uint64_t bound = GetBucketUpperBound (bucket);
+          return NanoSeconds (bound < m_max ? bound : m_max);
+        }
+    }
+  return NanoSeconds (m_max);
+}
+
+void
+AcmeFlatLatencyHistogram::Clear (void)
+{
+  m_counts.assign (_bucketCount, 0);
+  m_count = 0;
+  m_min = 0;
+  m_max = 0;
+  m_sum = 0;
+}
+
+AcmeFlatLatencyHistogram &
+AcmeFlatLatencyHistogram::operator+= (const AcmeFlatLatencyHistogram &other)
+{
+  if (other.m_count == 0)
+    {
+      return *this;
+    }
+  for (unsigned bucket = 0; bucket < m_counts.size (); ++bucket)
+    {
+      m_counts[bucket] += other.m_counts[bucket];
+    }
+  if (m_count == 0 || other.m_min < m_min)
+    {
+      m_min = other.m_min;
+    }
+  if (other.m_max > m_max)
+    {
+      m_max = other.m_max;
+    }
+  m_count += other.m_count;
+  m_sum += other.m_sum;
+  return *this;
+}
+
+std::ostream &
+ns3::acme::operator<< (std::ostream &os, const AcmeFlatLatencyHistogram &histogram)
+{
+  os << "count " << histogram.GetCount ()
+     << " min " << histogram.GetMin ().GetNanoSeconds ()
+     << " mean " << histogram.GetMean ().GetNanoSeconds ()
+     << " p50 " << histogram.GetPercentile (50).GetNanoSeconds ()
+     << " p90 " << histogram.GetPercentile (90).GetNanoSeconds ()
+     << " p99 " << histogram.GetPercentile (99).GetNanoSeconds ()
+     << " p99.9 " << histogram.GetPercentile (99.9).GetNanoSeconds ()
+     << " max " << histogram.GetMax ().GetNanoSeconds ()
+     << " (ns)";
+  return os;
+}
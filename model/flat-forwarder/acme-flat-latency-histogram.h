@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_ACMEFLATLATENCYHISTOGRAM_H
+#define CCNS3SIM_ACMEFLATLATENCYHISTOGRAM_H
+
+#include <stdint.h>
+#include <vector>
+#include <ostream>
+#include "ns3/nstime.h"
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * A log-bucketed latency histogram in the style of HdrHistogram.  Values are
+ * nanoseconds.  Each power of 2 is split into `SubBuckets` linear buckets, so a
+ * recorded value is known to within 1/SubBuckets (12.5%) of itself over the
+ * whole range, in a fixed 4 KB of counts.
+ *
+ * `Record` is a few shifts and an increment.  Histograms from several nodes
+ * add with `operator+=`.
+ */
+class AcmeFlatLatencyHistogram
+{
+public:
+  /**
+   * log2 of the number of linear buckets per power of 2
+   */
+  static const unsigned SubBucketBits = 3;
+  static const unsigned SubBuckets = 1 << SubBucketBits;
+
+  AcmeFlatLatencyHistogram ();
+
+  /**
+   * Records one latency.  A negative time is recorded as 0.
+   */
+  void Record (Time latency);
+
+  /**
+   * @return The number of recorded values
+   */
+  uint64_t GetCount (void) const;
+
+  Time GetMin (void) const;
+  Time GetMax (void) const;
+  Time GetMean (void) const;
+
+  /**
+   * @param [in] percentile In [0, 100]
+   * @return The upper bound of the bucket holding the value at `percentile`, or 0 if empty
+   */
+  Time GetPercentile (double percentile) const;
+
+  void Clear (void);
+
+  AcmeFlatLatencyHistogram & operator+= (const AcmeFlatLatencyHistogram &other);
+
+private:
+  static unsigned GetBucket (uint64_t value);
+
+  /**
+   * @return The largest value that falls in `bucket`
+   */
+  static uint64_t GetBucketUpperBound (unsigned bucket);
+
+  std::vector<uint64_t> m_counts;
+  uint64_t m_count;
+  uint64_t m_min;
+  uint64_t m_max;
+  double m_sum;
+};
+
+/**
+ * Prints the count, min, mean, p50, p90, p99, p99.9 and max
+ */
+std::ostream & operator<< (std::ostream &os, const AcmeFlatLatencyHistogram &histogram);
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATLATENCYHISTOGRAM_H
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <algorithm>
+#include "acme-flat-map-fib.h"
+
+#include "ns3/log.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+NS_LOG_COMPONENT_DEFINE ("AcmeFlatMapFib");
+NS_OBJECT_ENSURE_REGISTERED (AcmeFlatMapFib);
+
+TypeId
+AcmeFlatMapFib::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ccnx::AcmeFlatMapFib")
+    .SetParent<AcmeFlatFib> ()
+    .SetGroupName ("CCNx")
+    .AddConstructor<AcmeFlatMapFib> ()
+  ;
+  return tid;
+}
+
+AcmeFlatMapFib::CountingIsLess::CountingIsLess (AcmeFlatOperationCounts *operations)
+  : m_operations (operations)
+{
+  // empty
+}
+
+bool
+AcmeFlatMapFib::CountingIsLess::operator() (const Ptr<const CCNxName> &a, const Ptr<const CCNxName> &b) const
+{
+  // One walk to the first different segment both orders and counts
+  size_t count = std::min (a->GetSegmentCount (), b->GetSegmentCount ());
+  size_t i = 0;
+  int order = 0;
+  while (i < count && order == 0)
+    {
+      Ptr<const CCNxNameSegment> x = a->GetSegment (i);
+      Ptr<const CCNxNameSegment> y = b->GetSegment (i);
+      order = static_cast<int> (x->GetType ()) - static_cast<int> (y->GetType ());
+      if (order == 0)
+        {
+          order = x->GetValue ().compare (y->GetValue ());
+        }
+      ++i;
+    }
+  if (m_operations)
+    {
+      m_operations->probes++;
+      m_operations->segmentCompares += i;
+    }
+  return order == 0 ? a->GetSegmentCount () < b->GetSegmentCount () : order < 0;
+}
+
+AcmeFlatMapFib::AcmeFlatMapFib ()
+  : m_fib (CountingIsLess (&m_operations))
+{
+  // empty
+}
+
+AcmeFlatMapFib::~AcmeFlatMapFib ()
+{
+  // empty (use DoDispose)
+}
+
+void
+AcmeFlatMapFib::DoDispose (void)
+{
+  m_fib.clear ();
+  AcmeFlatFib::DoDispose ();
+}
+
+bool
+AcmeFlatMapFib::AddRoute (Ptr<const CCNxName> name, uint64_t digest, CCNxConnection::ConnIdType connId)
+{
+  NS_LOG_FUNCTION (this << name << connId);
+  std::pair<FibMapType::iterator, bool> result = m_fib.insert (std::make_pair (name, MakeNextHop (connId)));
+  if (result.second)
+    {
+      m_operations.insertions++;
+    }
+  return result.second;
+}
+
+bool
+AcmeFlatMapFib::RemoveRoute (Ptr<const CCNxName> name, uint64_t digest, CCNxConnection::ConnIdType connId)
+{
+  NS_LOG_FUNCTION (this << name << connId);
+  FibMapType::iterator j = m_fib.find (name);
+  if (j == m_fib.end ())
+    {
+      return false;
+    }
+
+  switch (RemoveNextHop (j->second, connId))
+    {
+    case ROUTE_EMPTY:
+      m_fib.erase (j);
+      return true;
+    case NEXT_HOP_REMOVED:
+      return true;
+    default:
+      return false;
+    }
+}
+
+bool
+AcmeFlatMapFib::Lookup (Ptr<const CCNxName> name, uint64_t digest, CCNxConnection::ConnIdType &connId) const
+{
+  FibMapType::const_iterator i = m_fib.find (name);
+  if (i == m_fib.end ())
+    {
+      return false;
+    }
+  connId = i->second.connId;
+  return true;
+}
+
+AcmeFlatFib::NextHopType *
+AcmeFlatMapFib::LookupNextHop (Ptr<const CCNxName> name, uint64_t digest)
+{
+  FibMapType::iterator i = m_fib.find (name);
+  if (i == m_fib.end ())
+    {
+      return 0;
+    }
+  return &i->second;
+}
+
+AcmeFlatFib::NextHopType *
+AcmeFlatMapFib::FindRoute (Ptr<const CCNxName> name, uint64_t digest)
+{
+  return LookupNextHop (name, digest);
+}
+
+bool
+AcmeFlatMapFib::IsExactMatch (void) const
+{
+  return true;
+}
+
+void
+AcmeFlatMapFib::GetRoutes (std::vector<RouteType> &routes) const
+{
+  routes.reserve (routes.size () + m_fib.size ());
+  for (FibMapType::const_iterator i = m_fib.begin (); i != m_fib.end (); ++i)
+    {
+      AppendRoutes (PeekPointer (i->first), i->second, routes);
+    }
+}
+
+size_t
+AcmeFlatMapFib::GetSize (void) const
+{
+  return m_fib.size ();
+}
+
+size_t
+AcmeFlatMapFib::GetMemoryUsage (void) const
+{
+  // Each tree node also holds a color and three pointers
+  return m_fib.size () * (sizeof(FibMapType::value_type) + 4 * sizeof(void *)) + GetNextHopMemoryUsage ();
+}
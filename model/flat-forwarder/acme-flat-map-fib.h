@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_ACMEFLATMAPFIB_H
+#define CCNS3SIM_ACMEFLATMAPFIB_H
+
+#include <map>
+#include "ns3/acme-flat-fib.h"
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * The reference FIB: a `std::map` ordered by name.  Each lookup is O(log n)
+ * full name comparisons.  It ignores the name digest.
+ *
+ * This is the default "FibType" of `AcmeFlatForwarder`.
+ */
+class AcmeFlatMapFib : public AcmeFlatFib
+{
+public:
+  static TypeId GetTypeId (void);
+
+  AcmeFlatMapFib ();
+  virtual ~AcmeFlatMapFib ();
+
+  virtual bool AddRoute (Ptr<const ccnx::CCNxName> name, uint64_t digest, ccnx::CCNxConnection::ConnIdType connId);
+
+  virtual bool RemoveRoute (Ptr<const ccnx::CCNxName> name, uint64_t digest, ccnx::CCNxConnection::ConnIdType connId);
+
+  virtual bool Lookup (Ptr<const ccnx::CCNxName> name, uint64_t digest, ccnx::CCNxConnection::ConnIdType &connId) const;
+
+  virtual NextHopType * LookupNextHop (Ptr<const ccnx::CCNxName> name, uint64_t digest);
+
+  virtual NextHopType * FindRoute (Ptr<const ccnx::CCNxName> name, uint64_t digest);
+
+  virtual bool IsExactMatch (void) const;
+
+  virtual void GetRoutes (std::vector<RouteType> &routes) const;
+
+  virtual size_t GetSize (void) const;
+
+  virtual size_t GetMemoryUsage (void) const;
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /**
+   * Orders names by their first different segment (type, then value), a
+   * prefix first, counting each comparison as a probe and the segments up to
+   * the first difference as segment compares
+   */
+  class CountingIsLess
+  {
+  public:
+    CountingIsLess (AcmeFlatOperationCounts *operations = 0);
+    bool operator() (const Ptr<const ccnx::CCNxName> &a, const Ptr<const ccnx::CCNxName> &b) const;
+
+  private:
+    AcmeFlatOperationCounts *m_operations;
+  };
+
+  // Only has one mapping from a name to a connection id.  Only does exact match.
+  typedef std::map<Ptr<const ccnx::CCNxName>, NextHopType, CountingIsLess> FibMapType;
+
+  FibMapType m_fib;
+};
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATMAPFIB_H
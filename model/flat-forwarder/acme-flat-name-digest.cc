@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "acme-flat-name-digest.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+uint64_t
+AcmeFlatNameDigest::Compute (const CCNxName &name)
+{
+  uint64_t state = _fnvOffsetBasis;
+  for (size_t i = 0; i < name.GetSegmentCount (); ++i)
+    {
+      state = Update (state, *name.GetSegment (i));
+    }
+  return Finalize (state);
+}
+
+uint64_t
+AcmeFlatNameDigest::ComputeSegment (const CCNxNameSegment &segment)
+{
+  return Finalize (Update (_fnvOffsetBasis, segment));
+}
+
+void
+AcmeFlatNameDigest::ComputePrefixes (const CCNxName &name, std::vector<uint64_t> &digests)
+{
+  digests.resize (name.GetSegmentCount () + 1);
+  uint64_t state = _fnvOffsetBasis;
+  digests[0] = Finalize (state);
+  for (size_t i = 0; i < name.GetSegmentCount (); ++i)
+    {
+      state = Update (state, *name.GetSegment (i));
+      digests[i + 1] = Finalize (state);
+    }
+}
+
+uint64_t
+AcmeFlatNameDigest::Update (uint64_t state, const CCNxNameSegment &segment)
+{
+  const std::string &value = segment.GetValue ();
+  uint32_t type = static_cast<uint32_t> (segment.GetType ());
+  uint32_t length = static_cast<uint32_t> (value.size ());
+
+  // Include the TL so "a/bc" and "ab/c" do not collide
+  for (int shift = 0; shift < 32; shift += 8)
+    {
+      state = (state ^ ((type >> shift) & 0xFF)) * _fnvPrime;
+    }
+  for (int shift = 0; shift < 32; shift += 8)
+    {
+      state = (state ^ ((length >> shift) & 0xFF)) * _fnvPrime;
+    }
+
+  const unsigned char *p = reinterpret_cast<const unsigned char *> (value.data ());
+  for (uint32_t j = 0; j < length; ++j)
+    {
+      state = (state ^ p[j]) * _fnvPrime;
+    }
+  return state;
+}
+
+uint64_t
+AcmeFlatNameDigest::Finalize (uint64_t state)
+{
+  // murmur3 fmix64
+  state ^= state >> 33;
+  state *= 0xff51afd7ed558ccdULL;
+  state ^= state >> 33;
+  state *= 0xc4ceb9fe1a85ec53ULL;
+  state ^= state >> 33;
+  return state == 0 ? 1 : state;
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_ACMEFLATNAMEDIGEST_H
+#define CCNS3SIM_ACMEFLATNAMEDIGEST_H
+
+#include <stdint.h>
+#include <vector>
+#include "ns3/ccnx-name.h"
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * A 64-bit digest of a CCNxName used to index the forwarder's hash tables.
+ *
+ * The digest is computed once per name (once when a route is installed and once
+ * per packet) and carried alongside the name, so table probes compare integers and
+ * only fall back to a full segment-by-segment name comparison on a digest match.
+ *
+ * It is a FNV-1a hash over each segment's type, length, and value followed by a
+ * 64-bit finalizer so the low-order bits are usable as a table index.  The value
+ * 0 is never returned, so tables may use 0 to mark an empty slot.
+ */
+class AcmeFlatNameDigest
+{
+public:
+  /**
+   * Computes the digest of the whole name.
+   *
+   * @param [in] name The name to digest
+   * @return A non-zero 64-bit digest
+   */
+  static uint64_t Compute (const ccnx::CCNxName &name);
+
+  /**
+   * Computes the digest of a single name segment.
+   *
+   * @param [in] segment The segment to digest
+   * @return A non-zero 64-bit digest
+   */
+  static uint64_t ComputeSegment (const ccnx::CCNxNameSegment &segment);
+
+  /**
+   * Computes the digest of every prefix of the name in one pass over its segments.
+   *
+   * @param [in] name The name to digest
+   * @param [out] digests Replaced by the digests of the prefixes, shortest first.
+   *        `digests[i]` is the digest of the first `i` segments, so `digests[0]` is
+   *        that of the empty name and the last is `Compute (name)`.
+   */
+  static void ComputePrefixes (const ccnx::CCNxName &name, std::vector<uint64_t> &digests);
+
+private:
+  static const uint64_t _fnvOffsetBasis = 0xcbf29ce484222325ULL;
+  static const uint64_t _fnvPrime = 0x100000001b3ULL;
+
+  /**
+   * Mixes one name segment into the running FNV-1a state
+   */
+  static uint64_t Update (uint64_t state, const ccnx::CCNxNameSegment &segment);
+
+  /**
+   * Avalanche the running state into the final digest (never 0).
+   */
+  static uint64_t Finalize (uint64_t state);
+};
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATNAMEDIGEST_H
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "acme-flat-name-table.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+const uint32_t AcmeFlatNameTable::None;
+
+/**
+ * The names RetireOne looks at before giving up, so a table full of names in
+ * use does not cost a scan of the whole list per Intern
+ */
+static const unsigned _retireScan = 8;
+
+AcmeFlatNameTable::AcmeFlatNameTable (size_t capacity)
+  : m_capacity (capacity), m_head (None), m_tail (None), m_size (0), m_hits (0), m_retired (0)
+{
+  // empty
+}
+
+bool
+AcmeFlatNameTable::Equals (const CCNxName &a, const CCNxName &b, uint64_t &segmentCompares)
+{
+  if (&a == &b)
+    {
+      return true;
+    }
+  segmentCompares += a.GetSegmentCount ();
+  return a.Equals (b);
+}
+
+uint32_t
+AcmeFlatNameTable::Find (const CCNxName &name, uint64_t digest) const
+{
+  size_t position = m_index.Probe (digest);
+  uint32_t id;
+  while (m_index.Next (digest, position, id))
+    {
+      if (Equals (*m_entries[id].name, name, m_operations.segmentCompares))
+        {
+          return id;
+        }
+    }
+  return None;
+}
+
+uint32_t
+AcmeFlatNameTable::Intern (Ptr<const CCNxName> name, uint64_t digest)
+{
+  uint32_t id = Find (*name, digest);
+  if (id != None)
+    {
+      m_hits++;
+      if (id != m_head)
+        {
+          Unlink (id);
+          PushFront (id);
+        }
+      return id;
+    }
+
+  if (m_size >= m_capacity)
+    {
+      RetireOne ();
+    }
+
+  if (m_freeIds.empty ())
+    {
+      id = static_cast<uint32_t> (m_entries.size ());
+      m_entries.push_back (EntryType ());
+    }
+  else
+    {
+      id = m_freeIds.back ();
+      m_freeIds.pop_back ();
+    }
+
+  EntryType &entry = m_entries[id];
+  entry.name = name;
+  entry.digest = digest;
+  PushFront (id);
+  m_index.Insert (digest, id);
+  m_size++;
+  m_operations.insertions++;
+  return id;
+}
+
+bool
+AcmeFlatNameTable::RetireOne (void)
+{
+  for (unsigned i = 0; i < _retireScan && m_tail != None; ++i)
+    {
+      uint32_t id = m_tail;
+      EntryType &entry = m_entries[id];
+      Unlink (id);
+
+      // The table holds the only reference, so no other table has the name
+      if (entry.name->GetReferenceCount () == 1)
+        {
+          m_index.Erase (entry.digest, id);
+          entry.name = 0;
+          entry.digest = 0;
+          m_freeIds.push_back (id);
+          m_size--;
+          m_retired++;
+          return true;
+        }
+      PushFront (id);
+    }
+  return false;
+}
+
+void
+AcmeFlatNameTable::PushFront (uint32_t id)
+{
+  EntryType &entry = m_entries[id];
+  entry.prev = None;
+  entry.next = m_head;
+  if (m_head != None)
+    {
+      m_entries[m_head].prev = id;
+    }
+  m_head = id;
+  if (m_tail == None)
+    {
+      m_tail = id;
+    }
+}
+
+void
+AcmeFlatNameTable::Unlink (uint32_t id)
+{
+  EntryType &entry = m_entries[id];
+  if (entry.prev != None)
+    {
+      m_entries[entry.prev].next = entry.next;
+    }
+  else
+    {
+      m_head = entry.next;
+    }
+  if (entry.next != None)
+    {
+      m_entries[entry.next].prev = entry.prev;
+    }
+  else
+    {
+      m_tail = entry.prev;
+    }
+  entry.prev = None;
+  entry.next = None;
+}
+
+Ptr<const CCNxName>
+AcmeFlatNameTable::GetName (uint32_t id) const
+{
+  return m_entries[id].name;
+}
+
+size_t
+AcmeFlatNameTable::GetSize (void) const
+{
+  return m_size;
+}
+
+size_t
+AcmeFlatNameTable::GetCapacity (void) const
+{
+  return m_capacity;
+}
+
+uint64_t
+AcmeFlatNameTable::GetHits (void) const
+{
+  return m_hits;
+}
+
+uint64_t
+AcmeFlatNameTable::GetRetired (void) const
+{
+  return m_retired;
+}
+
+size_t
+AcmeFlatNameTable::GetMemoryUsage (void) const
+{
+  return m_entries.capacity () * sizeof(EntryType) + m_freeIds.capacity () * sizeof(uint32_t)
+         + m_index.GetMemoryUsage ();
+}
+
+AcmeFlatOperationCounts
+AcmeFlatNameTable::GetOperations (void) const
+{
+  AcmeFlatOperationCounts operations = m_operations;
+  operations.probes += m_index.GetProbes ();
+  return operations;
+}
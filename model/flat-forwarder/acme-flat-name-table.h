@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_ACMEFLATNAMETABLE_H
+#define CCNS3SIM_ACMEFLATNAMETABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "ns3/ptr.h"
+#include "ns3/ccnx-name.h"
+#include "ns3/acme-flat-digest-index.h"
+#include "ns3/acme-flat-operation-counts.h"
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * Interns names: the first time a name is seen it gets a dense id and the
+ * table keeps that `CCNxName` instance; every later copy of the name maps to
+ * the same id and instance.  A forwarder that gives the interned instance to
+ * its FIB, PIT and content store stores each name once, and the tables find
+ * a name equal to their entry by comparing pointers (see Equals) rather than
+ * segments.
+ *
+ * Names are keyed by their `AcmeFlatNameDigest` and verified segment by segment
+ * on a digest match, once per Intern.
+ *
+ * The table holds at most `capacity` names not in use.  A name is in use while
+ * anything other than the table holds a reference to its instance.  When an
+ * Intern of a new name finds the table full, it retires the least recently
+ * interned names not in use and reuses their ids.  Names in use are never
+ * retired, so the table may go over capacity while they fill it.
+ */
+class AcmeFlatNameTable
+{
+public:
+  static const uint32_t None = 0xFFFFFFFF;
+
+  /**
+   * @param [in] capacity The number of names to keep before retiring unused ones
+   */
+  AcmeFlatNameTable (size_t capacity = 65536);
+
+  /**
+   * Returns the id of `name`, adding it if it is new.
+   *
+   * @param [in] name The name
+   * @param [in] digest The AcmeFlatNameDigest of `name`
+   * @return The id of the name, valid until the name is retired
+   */
+  uint32_t Intern (Ptr<const ccnx::CCNxName> name, uint64_t digest);
+
+  /**
+   * @return The id of `name`, or None if it is not in the table.  Does not change its recency.
+   */
+  uint32_t Find (const ccnx::CCNxName &name, uint64_t digest) const;
+
+  /**
+   * @return The interned instance of the name with `id`
+   */
+  Ptr<const ccnx::CCNxName> GetName (uint32_t id) const;
+
+  /**
+   * @return The number of names in the table
+   */
+  size_t GetSize (void) const;
+
+  size_t GetCapacity (void) const;
+
+  /**
+   * @return The number of Interns that found the name in the table
+   */
+  uint64_t GetHits (void) const;
+
+  /**
+   * @return The number of names retired to make room
+   */
+  uint64_t GetRetired (void) const;
+
+  /**
+   * @return The bytes of the table, not counting the names
+   */
+  size_t GetMemoryUsage (void) const;
+
+  /**
+   * @return The operations the table has performed since it was created
+   */
+  AcmeFlatOperationCounts GetOperations (void) const;
+
+  /**
+   * Compares two names, at once if they are the same instance, as two interned
+   * copies of a name are.  Otherwise compares their segments and adds the count
+   * to `segmentCompares`.
+   *
+   * @return true if the names are equal
+   */
+  static bool Equals (const ccnx::CCNxName &a, const ccnx::CCNxName &b, uint64_t &segmentCompares);
+
+private:
+  typedef struct
+  {
+    Ptr<const ccnx::CCNxName> name;     //< null for a free id
+    uint64_t digest;
+    uint32_t prev;                      //< towards the most recently interned
+    uint32_t next;                      //< towards the least recently interned
+  } EntryType;
+
+  void PushFront (uint32_t id);
+  void Unlink (uint32_t id);
+
+  /**
+   * Retires the least recently interned name not in use, looking at a few
+   * names from the tail and moving the ones in use to the head
+   *
+   * @return true if a name was retired
+   */
+  bool RetireOne (void);
+
+  size_t m_capacity;
+  std::vector<EntryType> m_entries;
+  std::vector<uint32_t> m_freeIds;
+  AcmeFlatDigestIndex m_index;
+  uint32_t m_head;
+  uint32_t m_tail;
+  size_t m_size;
+  uint64_t m_hits;
+  uint64_t m_retired;
+  mutable AcmeFlatOperationCounts m_operations;
+};
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATNAMETABLE_H
@@ -0,0 +1,599 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "acme-flat-overlay-fib.h"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/ccnx-name-builder.h"
+#include "ns3/acme-flat-name-digest.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+NS_LOG_COMPONENT_DEFINE ("AcmeFlatOverlayFib");
+NS_OBJECT_ENSURE_REGISTERED (AcmeFlatOverlayFib);
+
+TypeId
+AcmeFlatOverlayFib::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ccnx::AcmeFlatOverlayFib")
+    .SetParent<AcmeFlatFib> ()
+    .SetGroupName ("CCNx")
+    .AddConstructor<AcmeFlatOverlayFib> ()
+  ;
+  return tid;
+}
+
+AcmeFlatOverlayFib::AcmeFlatOverlayFib ()
+  : m_shadowed (0), m_copies (0)
+{
+  // empty
+}
+
+AcmeFlatOverlayFib::~AcmeFlatOverlayFib ()
+{
+  // empty (use DoDispose)
+}
+
+void
+AcmeFlatOverlayFib::DoDispose (void)
+{
+  // The shared FIB belongs to the other forwarders too
+  m_shared = 0;
+  m_sharedStates.clear ();
+  m_tombstones.clear ();
+  if (m_local)
+    {
+      m_local->Dispose ();
+      m_local = 0;
+    }
+  AcmeFlatFib::DoDispose ();
+}
+
+void
+AcmeFlatOverlayFib::SetFibs (Ptr<AcmeFlatFib> shared, Ptr<AcmeFlatFib> local)
+{
+  NS_ASSERT_MSG (local->GetSize () == 0, "The private FIB must start empty");
+  NS_ASSERT_MSG (!shared || shared->IsExactMatch () == local->IsExactMatch (),
+                 "The shared and private FIBs must both be exact or longest prefix match");
+  m_shared = shared;
+  m_local = local;
+  m_sharedStates.clear ();
+  m_tombstones.clear ();
+  m_shadowed = 0;
+}
+
+Ptr<AcmeFlatFib>
+AcmeFlatOverlayFib::GetSharedFib (void) const
+{
+  return m_shared;
+}
+
+Ptr<AcmeFlatFib>
+AcmeFlatOverlayFib::GetLocalFib (void) const
+{
+  return m_local;
+}
+
+uint64_t
+AcmeFlatOverlayFib::GetCopies (void) const
+{
+  return m_copies;
+}
+
+size_t
+AcmeFlatOverlayFib::GetWithdrawnCount (void) const
+{
+  return m_tombstones.size ();
+}
+
+bool
+AcmeFlatOverlayFib::IsShared (const NextHopType &nextHop) const
+{
+  return !m_sharedStates.empty () && m_sharedStates.find (&nextHop) != m_sharedStates.end ();
+}
+
+void
+AcmeFlatOverlayFib::AddSharedState (const NextHopType &nextHop)
+{
+  NextHopStateType empty = { Ptr<CCNxConnection> (0), 0, 0, 0, Time (0) };
+  m_sharedStates.insert (std::make_pair (&nextHop, empty));
+}
+
+void
+AcmeFlatOverlayFib::ForgetSharedState (const NextHopType &first)
+{
+  if (!m_sharedStates.empty ())
+    {
+      size_t count = m_shared->GetNextHopCount (first);
+      for (size_t i = 0; i < count; ++i)
+        {
+          m_sharedStates.erase (&m_shared->GetNextHop (first, i));
+        }
+    }
+}
+
+bool
+AcmeFlatOverlayFib::HasSharedNextHop (const NextHopType &first, CCNxConnection::ConnIdType connId) const
+{
+  size_t count = m_shared->GetNextHopCount (first);
+  for (size_t i = 0; i < count; ++i)
+    {
+      if (m_shared->GetNextHop (first, i).connId == connId)
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+bool
+AcmeFlatOverlayFib::IsWithdrawn (const CCNxName &name, uint64_t digest) const
+{
+  std::pair<TombstoneMapType::const_iterator, TombstoneMapType::const_iterator> range = m_tombstones.equal_range (digest);
+  for (TombstoneMapType::const_iterator i = range.first; i != range.second; ++i)
+    {
+      if (i->second->Equals (name))
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+bool
+AcmeFlatOverlayFib::ClearWithdrawn (const CCNxName &name, uint64_t digest)
+{
+  std::pair<TombstoneMapType::iterator, TombstoneMapType::iterator> range = m_tombstones.equal_range (digest);
+  for (TombstoneMapType::iterator i = range.first; i != range.second; ++i)
+    {
+      if (i->second->Equals (name))
+        {
+          m_tombstones.erase (i);
+          return true;
+        }
+    }
+  return false;
+}
+
+void
+AcmeFlatOverlayFib::Withdraw (Ptr<const CCNxName> name, uint64_t digest, const NextHopType &first)
+{
+  ForgetSharedState (first);
+  m_tombstones.insert (std::make_pair (digest, name));
+  NS_LOG_DEBUG ("Withdrew shared route " << *name);
+}
+
+void
+AcmeFlatOverlayFib::CopyRoute (Ptr<const CCNxName> name, uint64_t digest, const NextHopType &first)
+{
+  size_t count = m_shared->GetNextHopCount (first);
+  for (size_t i = 0; i < count; ++i)
+    {
+      const NextHopType &nextHop = m_shared->GetNextHop (first, i);
+      m_local->AddNextHop (name, digest, nextHop.connId, nextHop.cost);
+    }
+
+  // The copy keeps the state this node built up on the shared next hops
+  if (!m_sharedStates.empty ())
+    {
+      NextHopType *copy = m_local->FindRoute (name, digest);
+      for (size_t i = 0; i < count; ++i)
+        {
+          SharedStateMapType::iterator state = m_sharedStates.find (&m_shared->GetNextHop (first, i));
+          if (state != m_sharedStates.end ())
+            {
+              m_local->GetNextHopState (m_local->GetNextHop (*copy, i)) = state->second;
+              m_sharedStates.erase (state);
+            }
+        }
+    }
+
+  m_shadowed++;
+  m_copies++;
+  NS_LOG_DEBUG ("Copied shared route " << *name);
+}
+
+bool
+AcmeFlatOverlayFib::CopyOnWrite (Ptr<const CCNxName> name, uint64_t digest, CCNxConnection::ConnIdType connId)
+{
+  if (!m_shared || m_local->FindRoute (name, digest))
+    {
+      return true;
+    }
+
+  if (!m_tombstones.empty () && ClearWithdrawn (*name, digest))
+    {
+      // The route about to be added hides the shared one instead
+      m_shadowed++;
+      return true;
+    }
+
+  NextHopType *shared = m_shared->FindRoute (name, digest);
+  if (shared)
+    {
+      if (HasSharedNextHop (*shared, connId))
+        {
+          return false;
+        }
+      CopyRoute (name, digest, *shared);
+    }
+  return true;
+}
+
+AcmeFlatFib::NextHopType *
+AcmeFlatOverlayFib::Match (Ptr<const CCNxName> name, uint64_t digest, Ptr<const CCNxName> &routeName, bool &shared) const
+{
+  shared = false;
+  NextHopType *local = m_local->LookupRoute (name, digest, routeName);
+  if (!m_shared)
+    {
+      return local;
+    }
+
+  // The shared route must be longer to win; an equal one is shadowed by the private copy
+  size_t localLength = local ? routeName->GetSegmentCount () : 0;
+  Ptr<const CCNxName> sharedName;
+  NextHopType *first = m_shared->LookupRoute (name, digest, sharedName);
+  while (first && (!local || sharedName->GetSegmentCount () > localLength))
+    {
+      if (m_tombstones.empty ()
+          || !IsWithdrawn (*sharedName, sharedName->GetSegmentCount () == name->GetSegmentCount () ? digest : AcmeFlatNameDigest::Compute (*sharedName)))
+        {
+          routeName = sharedName;
+          shared = true;
+          return first;
+        }
+
+      // Withdrawn on this node, so a shorter shared route may match instead
+      if (m_shared->IsExactMatch () || sharedName->GetSegmentCount () == 0)
+        {
+          break;
+        }
+      CCNxNameBuilder builder;
+      for (size_t i = 0; i + 1 < sharedName->GetSegmentCount (); ++i)
+        {
+          builder.Append (sharedName->GetSegment (i));
+        }
+      Ptr<const CCNxName> prefix = builder.CreateName ();
+      first = m_shared->LookupRoute (prefix, AcmeFlatNameDigest::Compute (*prefix), sharedName);
+    }
+  return local;
+}
+
+AcmeFlatFib::NextHopType *
+AcmeFlatOverlayFib::Resolve (Ptr<const CCNxName> name, uint64_t digest, Ptr<const CCNxName> &routeName)
+{
+  bool shared;
+  NextHopType *first = Match (name, digest, routeName, shared);
+  if (shared)
+    {
+      AddSharedState (*first);
+    }
+  return first;
+}
+
+bool
+AcmeFlatOverlayFib::AddNextHop (Ptr<const CCNxName> name, uint64_t digest, CCNxConnection::ConnIdType connId, uint32_t cost)
+{
+  if (!CopyOnWrite (name, digest, connId))
+    {
+      return false;
+    }
+  return m_local->AddNextHop (name, digest, connId, cost);
+}
+
+size_t
+AcmeFlatOverlayFib::GetNextHopCount (const NextHopType &first) const
+{
+  return IsShared (first) ? m_shared->GetNextHopCount (first) : m_local->GetNextHopCount (first);
+}
+
+AcmeFlatFib::NextHopType &
+AcmeFlatOverlayFib::GetNextHop (NextHopType &first, size_t i)
+{
+  if (IsShared (first))
+    {
+      NextHopType &nextHop = m_shared->GetNextHop (first, i);
+      AddSharedState (nextHop);
+      return nextHop;
+    }
+  return m_local->GetNextHop (first, i);
+}
+
+const AcmeFlatFib::NextHopType &
+AcmeFlatOverlayFib::GetNextHop (const NextHopType &first, size_t i) const
+{
+  return IsShared (first) ? m_shared->GetNextHop (first, i) : m_local->GetNextHop (first, i);
+}
+
+AcmeFlatFib::NextHopStateType &
+AcmeFlatOverlayFib::GetNextHopState (NextHopType &nextHop)
+{
+  if (!m_sharedStates.empty ())
+    {
+      SharedStateMapType::iterator state = m_sharedStates.find (&nextHop);
+      if (state != m_sharedStates.end ())
+        {
+          return state->second;
+        }
+    }
+  return m_local->GetNextHopState (nextHop);
+}
+
+const AcmeFlatFib::NextHopStateType &
+AcmeFlatOverlayFib::PeekNextHopState (const NextHopType &nextHop) const
+{
+  if (!m_sharedStates.empty ())
+    {
+      SharedStateMapType::const_iterator state = m_sharedStates.find (&nextHop);
+      if (state != m_sharedStates.end ())
+        {
+          return state->second;
+        }
+    }
+  return m_local->PeekNextHopState (nextHop);
+}
+
+bool
+AcmeFlatOverlayFib::AddRoute (Ptr<const CCNxName> name, uint64_t digest, CCNxConnection::ConnIdType connId)
+{
+  if (m_shared && !m_local->FindRoute (name, digest))
+    {
+      if (!m_tombstones.empty () && ClearWithdrawn (*name, digest))
+        {
+          m_shadowed++;
+        }
+      else if (m_shared->FindRoute (name, digest))
+        {
+          return false;
+        }
+    }
+  return m_local->AddRoute (name, digest, connId);
+}
+
+bool
+AcmeFlatOverlayFib::RemoveRoute (Ptr<const CCNxName> name, uint64_t digest, CCNxConnection::ConnIdType connId)
+{
+  if (m_shared && !m_local->FindRoute (name, digest) && (m_tombstones.empty () || !IsWithdrawn (*name, digest)))
+    {
+      NextHopType *shared = m_shared->FindRoute (name, digest);
+      if (shared)
+        {
+          if (!HasSharedNextHop (*shared, connId))
+            {
+              return false;
+            }
+          if (m_shared->GetNextHopCount (*shared) == 1)
+            {
+              // The whole route goes, so there is nothing to copy
+              Withdraw (name, digest, *shared);
+              return true;
+            }
+          CopyRoute (name, digest, *shared);
+        }
+    }
+
+  if (!m_local->RemoveRoute (name, digest, connId))
+    {
+      return false;
+    }
+  if (m_shared && !m_local->FindRoute (name, digest))
+    {
+      NextHopType *shared = m_shared->FindRoute (name, digest);
+      if (shared)
+        {
+          // The private copy is gone, and the shared route must not show through
+          m_shadowed--;
+          Withdraw (name, digest, *shared);
+        }
+    }
+  return true;
+}
+
+bool
+AcmeFlatOverlayFib::Lookup (Ptr<const CCNxName> name, uint64_t digest, CCNxConnection::ConnIdType &connId) const
+{
+  Ptr<const CCNxName> routeName;
+  bool shared;
+  const NextHopType *first = Match (name, digest, routeName, shared);
+  if (!first)
+    {
+      return false;
+    }
+  connId = first->connId;
+  return true;
+}
+
+AcmeFlatFib::NextHopType *
+AcmeFlatOverlayFib::LookupNextHop (Ptr<const CCNxName> name, uint64_t digest)
+{
+  Ptr<const CCNxName> routeName;
+  return Resolve (name, digest, routeName);
+}
+
+AcmeFlatFib::NextHopType *
+AcmeFlatOverlayFib::LookupRoute (Ptr<const CCNxName> name, uint64_t digest, Ptr<const CCNxName> &routeName)
+{
+  return Resolve (name, digest, routeName);
+}
+
+AcmeFlatFib::NextHopType *
+AcmeFlatOverlayFib::FindRoute (Ptr<const CCNxName> name, uint64_t digest)
+{
+  NextHopType *first = m_local->FindRoute (name, digest);
+  if (!first && m_shared && (m_tombstones.empty () || !IsWithdrawn (*name, digest)))
+    {
+      first = m_shared->FindRoute (name, digest);
+      if (first)
+        {
+          AddSharedState (*first);
+        }
+    }
+  return first;
+}
+
+bool
+AcmeFlatOverlayFib::IsExactMatch (void) const
+{
+  return m_local->IsExactMatch ();
+}
+
+size_t
+AcmeFlatOverlayFib::GetSharedRoutes (CCNxConnection::ConnIdType connId, std::vector<BulkRouteType> &routes) const
+{
+  if (!m_shared)
+    {
+      return 0;
+    }
+
+  std::vector<RouteType> shared;
+  m_shared->GetRoutes (shared);
+  size_t count = 0;
+  for (size_t i = 0; i < shared.size (); ++i)
+    {
+      if (shared[i].connId == connId)
+        {
+          Ptr<const CCNxName> name (shared[i].name);
+          uint64_t digest = AcmeFlatNameDigest::Compute (*name);
+          if (m_tombstones.empty () || !IsWithdrawn (*name, digest))
+            {
+              BulkRouteType route = { name, digest, connId, shared[i].cost };
+              routes.push_back (route);
+              count++;
+            }
+        }
+    }
+  return count;
+}
+
+void
+AcmeFlatOverlayFib::GetRoutes (std::vector<RouteType> &routes) const
+{
+  m_local->GetRoutes (routes);
+  if (m_shared)
+    {
+      std::vector<RouteType> shared;
+      m_shared->GetRoutes (shared);
+      routes.reserve (routes.size () + shared.size ());
+
+      // The next hops of a route are listed together
+      size_t i = 0;
+      while (i < shared.size ())
+        {
+          size_t end = i + 1;
+          while (end < shared.size () && shared[end].name == shared[i].name)
+            {
+              end++;
+            }
+
+          Ptr<const CCNxName> name (shared[i].name);
+          bool changed = m_shadowed > 0 || !m_tombstones.empty () || !m_sharedStates.empty ();
+          uint64_t digest = changed ? AcmeFlatNameDigest::Compute (*name) : 0;
+          bool hidden = (m_shadowed > 0 && m_local->FindRoute (name, digest))
+            || (!m_tombstones.empty () && IsWithdrawn (*name, digest));
+          if (!hidden)
+            {
+              const NextHopType *first = m_sharedStates.empty () ? 0 : m_shared->FindRoute (name, digest);
+              for (size_t j = i; j < end; ++j)
+                {
+                  RouteType route = shared[j];
+                  if (first)
+                    {
+                      // This node's counters, not the shared FIB's
+                      const NextHopStateType &state = PeekNextHopState (m_shared->GetNextHop (*first, j - i));
+                      route.packets = state.packets;
+                      route.bytes = state.bytes;
+                    }
+                  routes.push_back (route);
+                }
+            }
+          i = end;
+        }
+    }
+}
+
+size_t
+AcmeFlatOverlayFib::GetSize (void) const
+{
+  size_t size = m_local->GetSize ();
+  if (m_shared)
+    {
+      size += m_shared->GetSize () - m_shadowed - m_tombstones.size ();
+    }
+  return size;
+}
+
+size_t
+AcmeFlatOverlayFib::GetMemoryUsage (void) const
+{
+  // Each tree node also holds a color and three pointers
+  return m_local->GetMemoryUsage ()
+    + m_sharedStates.size () * (sizeof(SharedStateMapType::value_type) + 4 * sizeof(void *))
+    + m_tombstones.size () * (sizeof(TombstoneMapType::value_type) + 4 * sizeof(void *));
+}
+
+AcmeFlatOperationCounts
+AcmeFlatOverlayFib::GetOperations (void) const
+{
+  AcmeFlatOperationCounts operations = m_operations + m_local->GetOperations ();
+  if (m_shared)
+    {
+      operations += m_shared->GetOperations ();
+    }
+  return operations;
+}
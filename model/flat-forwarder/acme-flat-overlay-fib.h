@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_ACMEFLATOVERLAYFIB_H
+#define CCNS3SIM_ACMEFLATOVERLAYFIB_H
+
+#include <vector>
+#include <map>
+#include "ns3/acme-flat-fib.h"
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * A FIB made of a shared FIB that several forwarders read and a private FIB
+ * of this forwarder's own routes, as installed by
+ * `AcmeFlatForwarderHelper::SetSharedFib`.  Nodes with the same routes then
+ * hold one copy of them.
+ *
+ * The overlay never modifies the shared FIB.  A lookup returns the longer
+ * match of the two FIBs, and hands out the shared route itself if it wins.
+ * The per-node state of its next hops (the cached connection, the counters
+ * and the RTT) is kept in a side table of this overlay, keyed by next hop, so
+ * routes are not copied to be used.
+ *
+ * A shared route is copied into the private FIB only when this forwarder
+ * changes it (copy on write): adding a next hop to it, or removing one of
+ * several.  The copy takes over the side table state and shadows the shared
+ * route.  Removing the last next hop of a shared route, or of its copy,
+ * records a tombstone that hides the shared route on this node, so a longest
+ * prefix lookup falls back to a shorter route.  Adding the route again clears
+ * the tombstone.  The private FIB therefore holds only this node's changes.
+ *
+ * The shared FIB must be of the same kind (exact or longest prefix match) as
+ * the private one, and must not change once attached, as the overlay keeps
+ * pointers to its next hops.
+ */
+class AcmeFlatOverlayFib : public AcmeFlatFib
+{
+public:
+  static TypeId GetTypeId (void);
+
+  AcmeFlatOverlayFib ();
+  virtual ~AcmeFlatOverlayFib ();
+
+  /**
+   * @param [in] shared The read-only FIB shared with other forwarders
+   * @param [in] local The private FIB, empty
+   */
+  void SetFibs (Ptr<AcmeFlatFib> shared, Ptr<AcmeFlatFib> local);
+
+  /**
+   * @return The shared FIB
+   */
+  Ptr<AcmeFlatFib> GetSharedFib (void) const;
+
+  /**
+   * @return The private FIB
+   */
+  Ptr<AcmeFlatFib> GetLocalFib (void) const;
+
+  /**
+   * @return The number of shared routes copied into the private FIB
+   */
+  uint64_t GetCopies (void) const;
+
+  /**
+   * @return The number of shared routes this node has withdrawn
+   */
+  size_t GetWithdrawnCount (void) const;
+
+  /**
+   * Appends a route for each shared route through `connId` that this node has
+   * not withdrawn, whether or not it was copied.  The forwarder only indexes
+   * the routes it added, so it removes these too when the connection goes
+   * away.  Walks the whole shared FIB.
+   *
+   * @return The number of routes appended
+   */
+  size_t GetSharedRoutes (ccnx::CCNxConnection::ConnIdType connId, std::vector<BulkRouteType> &routes) const;
+
+  virtual bool AddNextHop (Ptr<const ccnx::CCNxName> name, uint64_t digest, ccnx::CCNxConnection::ConnIdType connId, uint32_t cost);
+
+  virtual size_t GetNextHopCount (const NextHopType &first) const;
+  virtual NextHopType & GetNextHop (NextHopType &first, size_t i);
+  virtual const NextHopType & GetNextHop (const NextHopType &first, size_t i) const;
+
+  virtual NextHopStateType & GetNextHopState (NextHopType &nextHop);
+  virtual const NextHopStateType & PeekNextHopState (const NextHopType &nextHop) const;
+
+  virtual bool AddRoute (Ptr<const ccnx::CCNxName> name, uint64_t digest, ccnx::CCNxConnection::ConnIdType connId);
+
+  /**
+   * Withdraws a shared route with a tombstone when its last next hop goes.
+   */
+  virtual bool RemoveRoute (Ptr<const ccnx::CCNxName> name, uint64_t digest, ccnx::CCNxConnection::ConnIdType connId);
+
+  virtual bool Lookup (Ptr<const ccnx::CCNxName> name, uint64_t digest, ccnx::CCNxConnection::ConnIdType &connId) const;
+
+  virtual NextHopType * LookupNextHop (Ptr<const ccnx::CCNxName> name, uint64_t digest);
+
+  virtual NextHopType * LookupRoute (Ptr<const ccnx::CCNxName> name, uint64_t digest, Ptr<const ccnx::CCNxName> &routeName);
+
+  /**
+   * Does not copy a shared route.
+   */
+  virtual NextHopType * FindRoute (Ptr<const ccnx::CCNxName> name, uint64_t digest);
+
+  virtual bool IsExactMatch (void) const;
+
+  virtual void GetRoutes (std::vector<RouteType> &routes) const;
+
+  virtual size_t GetSize (void) const;
+
+  /**
+   * @return The bytes of the private FIB, the side table and the tombstones.
+   *         The shared FIB is not counted.
+   */
+  virtual size_t GetMemoryUsage (void) const;
+
+  /**
+   * Includes the lookups of other forwarders in the shared FIB, so only the
+   * difference across a packet is meaningful.
+   */
+  virtual AcmeFlatOperationCounts GetOperations (void) const;
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /**
+   * @param [out] routeName The name of the route found
+   * @param [out] shared true if the route is from m_shared
+   * @return The first next hop of the longer match of `name` in the two FIBs,
+   *         skipping withdrawn shared routes, or null
+   */
+  NextHopType * Match (Ptr<const ccnx::CCNxName> name, uint64_t digest, Ptr<const ccnx::CCNxName> &routeName, bool &shared) const;
+
+  /**
+   * Like Match, but enters a shared next hop in m_sharedStates
+   */
+  NextHopType * Resolve (Ptr<const ccnx::CCNxName> name, uint64_t digest, Ptr<const ccnx::CCNxName> &routeName);
+
+  /**
+   * Prepares the private FIB for a change to the route `name` that has no copy
+   * yet: clears its tombstone, or copies the shared route.
+   *
+   * @return false if `connId` is already a next hop of the shared route
+   */
+  bool CopyOnWrite (Ptr<const ccnx::CCNxName> name, uint64_t digest, ccnx::CCNxConnection::ConnIdType connId);
+
+  /**
+   * Copies every next hop of the shared route `first` of `name` into m_local,
+   * with its state from m_sharedStates
+   */
+  void CopyRoute (Ptr<const ccnx::CCNxName> name, uint64_t digest, const NextHopType &first);
+
+  /**
+   * Hides the shared route `first` of `name` with a tombstone
+   */
+  void Withdraw (Ptr<const ccnx::CCNxName> name, uint64_t digest, const NextHopType &first);
+
+  /**
+   * @return true if `connId` is a next hop of the shared route `first`
+   */
+  bool HasSharedNextHop (const NextHopType &first, ccnx::CCNxConnection::ConnIdType connId) const;
+
+  /**
+   * @return true if `name` has a tombstone
+   */
+  bool IsWithdrawn (const ccnx::CCNxName &name, uint64_t digest) const;
+
+  /**
+   * Removes the tombstone of `name`
+   *
+   * @return true if there was one
+   */
+  bool ClearWithdrawn (const ccnx::CCNxName &name, uint64_t digest);
+
+  /**
+   * Drops the side table state of the next hops of the shared route `first`
+   */
+  void ForgetSharedState (const NextHopType &first);
+
+  /**
+   * @return true if `nextHop` belongs to m_shared
+   */
+  bool IsShared (const NextHopType &nextHop) const;
+
+  /**
+   * Enters `nextHop` of m_shared in m_sharedStates, if it is not there yet
+   */
+  void AddSharedState (const NextHopType &nextHop);
+
+  Ptr<AcmeFlatFib> m_shared;
+  Ptr<AcmeFlatFib> m_local;
+
+  /**
+   * The state of the shared next hops this node has been handed, by next hop.
+   * Being in the table is what marks a next hop as shared.
+   */
+  typedef std::map<const NextHopType *, NextHopStateType> SharedStateMapType;
+  SharedStateMapType m_sharedStates;
+
+  /**
+   * The names of the withdrawn shared routes, by AcmeFlatNameDigest
+   */
+  typedef std::multimap<uint64_t, Ptr<const ccnx::CCNxName> > TombstoneMapType;
+  TombstoneMapType m_tombstones;
+
+  /**
+   * The number of routes of m_local that shadow a route of m_shared
+   */
+  size_t m_shadowed;
+
+  uint64_t m_copies;
+};
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATOVERLAYFIB_H
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_ACMEFLATPACKETLOG_H
+#define CCNS3SIM_ACMEFLATPACKETLOG_H
+
+#include "ns3/log.h"
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * Logging on the per-packet path of `AcmeFlatForwarder` and its tables.
+ *
+ * These wrap NS_LOG_FUNCTION, NS_LOG_INFO and NS_LOG_DEBUG.  When
+ * ACME_FLAT_FORWARDER_NO_PACKET_LOG is defined they compile to nothing, so a
+ * debug build with logging enabled does not pay a level check (or evaluate
+ * arguments) per packet.  It is defined by "./waf configure --disable-acme-packet-log"
+ * and in optimized builds.  Use the "TraceSampleInterval" attribute of
+ * `AcmeFlatForwarder` to follow some packets when it is defined.
+ *
+ * Logging outside the per-packet path (routes, timers, configuration) uses NS_LOG directly.
+ */
+#ifdef ACME_FLAT_FORWARDER_NO_PACKET_LOG
+#define ACME_FLAT_PACKET_LOG_FUNCTION(parameters)
+#define ACME_FLAT_PACKET_LOG_INFO(msg)
+#define ACME_FLAT_PACKET_LOG_DEBUG(msg)
+#else
+#define ACME_FLAT_PACKET_LOG_FUNCTION(parameters) NS_LOG_FUNCTION (parameters)
+#define ACME_FLAT_PACKET_LOG_INFO(msg) NS_LOG_INFO (msg)
+#define ACME_FLAT_PACKET_LOG_DEBUG(msg) NS_LOG_DEBUG (msg)
+#endif
+
+#endif //CCNS3SIM_ACMEFLATPACKETLOG_H
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "acme-flat-pit.h"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/acme-flat-packet-log.h"
+#include "ns3/acme-flat-name-table.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+NS_LOG_COMPONENT_DEFINE ("AcmeFlatPit");
+NS_OBJECT_ENSURE_REGISTERED (AcmeFlatPit);
+
+static const Time _defaultLifetime = Seconds (4);
+
+const uint32_t AcmeFlatPit::None;
+
+TypeId
+AcmeFlatPit::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ccnx::AcmeFlatPit")
+    .SetParent<Object> ()
+    .SetGroupName ("CCNx")
+    .AddConstructor<AcmeFlatPit> ()
+    .AddAttribute ("DefaultLifetime", "How long a PIT entry lives after its last Interest",
+                   TimeValue (_defaultLifetime),
+                   MakeTimeAccessor (&AcmeFlatPit::m_defaultLifetime),
+                   MakeTimeChecker ())
+  ;
+  return tid;
+}
+
+AcmeFlatPit::AcmeFlatPit ()
+  : m_defaultLifetime (_defaultLifetime)
+{
+  // empty
+}
+
+AcmeFlatPit::~AcmeFlatPit ()
+{
+  // empty (use DoDispose)
+}
+
+void
+AcmeFlatPit::DoDispose (void)
+{
+  m_entries.clear ();
+  m_freeEntries.clear ();
+  m_index.Clear ();
+  m_expired = Callback<void, uint32_t> ();
+  Object::DoDispose ();
+}
+
+uint32_t
+AcmeFlatPit::Find (const CCNxName &name, uint64_t digest, Time now)
+{
+  size_t position = m_index.Probe (digest);
+  uint32_t handle;
+  while (m_index.Next (digest, position, handle))
+    {
+      if (AcmeFlatNameTable::Equals (*m_entries[handle].name, name, m_operations.segmentCompares))
+        {
+          if (m_entries[handle].expiry <= now)
+            {
+              ACME_FLAT_PACKET_LOG_DEBUG ("Expired PIT entry " << name);
+              if (!m_expired.IsNull ())
+                {
+                  m_expired (handle);
+                }
+              Erase (handle);
+              return None;
+            }
+          return handle;
+        }
+    }
+  return None;
+}
+
+uint32_t
+AcmeFlatPit::Insert (Ptr<const CCNxName> name, uint64_t digest, Time now)
+{
+  uint32_t handle;
+  if (m_freeEntries.empty ())
+    {
+      handle = static_cast<uint32_t> (m_entries.size ());
+      m_entries.push_back (EntryType ());
+    }
+  else
+    {
+      handle = m_freeEntries.back ();
+      m_freeEntries.pop_back ();
+    }
+
+  EntryType &entry = m_entries[handle];
+  entry.name = name;
+  entry.digest = digest;
+  entry.generation++;
+  entry.expiry = now + m_defaultLifetime;
+  entry.ingress.clear ();
+  entry.hasEgress = false;
+  entry.congestionMark = false;
+  m_index.Insert (digest, handle);
+  m_operations.insertions++;
+  return handle;
+}
+
+uint32_t
+AcmeFlatPit::GetGeneration (uint32_t handle) const
+{
+  return m_entries[handle].generation;
+}
+
+bool
+AcmeFlatPit::GetExpiry (uint32_t handle, uint32_t generation, Time &expiry) const
+{
+  const EntryType &entry = m_entries[handle];
+  if (entry.digest == 0 || entry.generation != generation)
+    {
+      return false;
+    }
+  expiry = entry.expiry;
+  return true;
+}
+
+bool
+AcmeFlatPit::AddIngress (uint32_t handle, CCNxConnection::ConnIdType ingress, Time now)
+{
+  EntryType &entry = m_entries[handle];
+  entry.expiry = now + m_defaultLifetime;
+  for (IngressListType::const_iterator i = entry.ingress.begin (); i != entry.ingress.end (); ++i)
+    {
+      if (*i == ingress)
+        {
+          return false;
+        }
+    }
+  entry.ingress.push_back (ingress);
+  return true;
+}
+
+const AcmeFlatPit::IngressListType &
+AcmeFlatPit::GetIngress (uint32_t handle) const
+{
+  return m_entries[handle].ingress;
+}
+
+void
+AcmeFlatPit::SetEgress (uint32_t handle, CCNxConnection::ConnIdType egress, Time now)
+{
+  EntryType &entry = m_entries[handle];
+  entry.hasEgress = true;
+  entry.egress = egress;
+  entry.sent = now;
+}
+
+void
+AcmeFlatPit::ClearEgress (uint32_t handle)
+{
+  m_entries[handle].hasEgress = false;
+}
+
+bool
+AcmeFlatPit::GetEgress (uint32_t handle, CCNxConnection::ConnIdType &egress, Time &sent) const
+{
+  const EntryType &entry = m_entries[handle];
+  if (entry.hasEgress)
+    {
+      egress = entry.egress;
+      sent = entry.sent;
+    }
+  return entry.hasEgress;
+}
+
+void
+AcmeFlatPit::SetCongestionMark (uint32_t handle)
+{
+  m_entries[handle].congestionMark = true;
+}
+
+bool
+AcmeFlatPit::HasCongestionMark (uint32_t handle) const
+{
+  return m_entries[handle].congestionMark;
+}
+
+Ptr<const CCNxName>
+AcmeFlatPit::GetName (uint32_t handle) const
+{
+  return m_entries[handle].name;
+}
+
+uint64_t
+AcmeFlatPit::GetDigest (uint32_t handle) const
+{
+  return m_entries[handle].digest;
+}
+
+void
+AcmeFlatPit::SetExpiredCallback (Callback<void, uint32_t> expired)
+{
+  m_expired = expired;
+}
+
+void
+AcmeFlatPit::Erase (uint32_t handle)
+{
+  EntryType &entry = m_entries[handle];
+  NS_ASSERT_MSG (entry.digest != 0, "Erase of a free PIT entry " << handle);
+  m_index.Erase (entry.digest, handle);
+  entry.name = 0;
+  entry.digest = 0;
+  m_freeEntries.push_back (handle);
+}
+
+size_t
+AcmeFlatPit::GetSize (void) const
+{
+  return m_entries.size () - m_freeEntries.size ();
+}
+
+AcmeFlatOperationCounts
+AcmeFlatPit::GetOperations (void) const
+{
+  AcmeFlatOperationCounts operations = m_operations;
+  operations.probes += m_index.GetProbes ();
+  return operations;
+}
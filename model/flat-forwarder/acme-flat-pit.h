@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_ACMEFLATPIT_H
+#define CCNS3SIM_ACMEFLATPIT_H
+
+#include <vector>
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/callback.h"
+#include "ns3/ccnx-name.h"
+#include "ns3/ccnx-connection.h"
+#include "ns3/acme-flat-digest-index.h"
+#include "ns3/acme-flat-operation-counts.h"
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * The Pending Interest Table of `AcmeFlatForwarder`.  An entry records the
+ * ingress connections of the Interests pending on one name, so the matching
+ * Content Object can be returned on the reverse path and duplicate Interests
+ * from other connections are aggregated instead of forwarded.
+ *
+ * Matching is by exact name only; KeyId and ContentObjectHash restrictions
+ * are not used.
+ *
+ * The table is built for high churn.  Entries live in a pool (a vector with a
+ * free list) and are addressed by a 32-bit handle, so insert and erase are O(1)
+ * and do not allocate once the pool has grown.  An `AcmeFlatDigestIndex` on the
+ * `AcmeFlatNameDigest` finds the entry of a name.
+ *
+ * Entries expire `DefaultLifetime` after their last Interest.  `Find` erases an
+ * expired entry when it is next looked up.  The owner reclaims entries that are
+ * never looked up again: a handle is reused after `Erase`, so the owner keeps the
+ * (handle, generation) pair from `Insert` and checks it with `GetExpiry`.
+ * `AcmeFlatForwarder` does this with an `AcmeFlatTimerWheel`.
+ *
+ * An entry can also record where and when its Interest was forwarded
+ * (`SetEgress`), so the owner can time the round trip, and whether one of its
+ * Interests met congestion (`SetCongestionMark`).
+ */
+class AcmeFlatPit : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+
+  AcmeFlatPit ();
+  virtual ~AcmeFlatPit ();
+
+  /**
+   * The handle of "no entry"
+   */
+  static const uint32_t None = 0xFFFFFFFF;
+
+  typedef std::vector<ccnx::CCNxConnection::ConnIdType> IngressListType;
+
+  /**
+   * Finds the live entry for `name`.  An expired entry is erased and not returned.
+   *
+   * @param [in] name The name to look up
+   * @param [in] digest The AcmeFlatNameDigest of `name`
+   * @param [in] now The current simulation time
+   * @return The entry handle or `None`
+   */
+  uint32_t Find (const ccnx::CCNxName &name, uint64_t digest, Time now);
+
+  /**
+   * Creates an entry for `name` with no ingress connections.  The caller must
+   * have checked that there is no live entry (see `Find`).
+   *
+   * @param [in] name The name of the pending Interest
+   * @param [in] digest The AcmeFlatNameDigest of `name`
+   * @param [in] now The current simulation time
+   * @return The handle of the new entry
+   */
+  uint32_t Insert (Ptr<const ccnx::CCNxName> name, uint64_t digest, Time now);
+
+  /**
+   * @return The generation of the entry, which changes each time its handle is reused
+   */
+  uint32_t GetGeneration (uint32_t handle) const;
+
+  /**
+   * Gets the expiry time of an entry if it is still the same entry.
+   *
+   * @param [in] handle The entry
+   * @param [in] generation The generation of the entry when the caller saw it
+   * @param [out] expiry The time the entry expires
+   * @return false if the entry was erased (and perhaps reused) since
+   */
+  bool GetExpiry (uint32_t handle, uint32_t generation, Time &expiry) const;
+
+  /**
+   * Records an Interest from `ingress` on the entry and extends its lifetime.
+   *
+   * @param [in] handle The entry
+   * @param [in] ingress The connection the Interest arrived on
+   * @param [in] now The current simulation time
+   * @return true if `ingress` is new to the entry, false if it is a retransmission
+   */
+  bool AddIngress (uint32_t handle, ccnx::CCNxConnection::ConnIdType ingress, Time now);
+
+  /**
+   * @return The ingress connections of the entry
+   */
+  const IngressListType & GetIngress (uint32_t handle) const;
+
+  /**
+   * Records that the Interest of the entry was forwarded to `egress` at `now`,
+   * replacing any earlier record.
+   */
+  void SetEgress (uint32_t handle, ccnx::CCNxConnection::ConnIdType egress, Time now);
+
+  /**
+   * Forgets the egress record of the entry, for example because the Interest was
+   * retransmitted and the round trip can no longer be timed.
+   */
+  void ClearEgress (uint32_t handle);
+
+  /**
+   * @param [in] handle The entry
+   * @param [out] egress The connection the Interest was forwarded to
+   * @param [out] sent When it was forwarded
+   * @return false if the entry has no egress record
+   */
+  bool GetEgress (uint32_t handle, ccnx::CCNxConnection::ConnIdType &egress, Time &sent) const;
+
+  /**
+   * Records that an Interest of the entry met congestion, so the Content Object
+   * that satisfies it is marked (see "MarkingTarget" of `AcmeFlatForwarder`)
+   */
+  void SetCongestionMark (uint32_t handle);
+
+  /**
+   * @return true if SetCongestionMark was called since the entry was inserted
+   */
+  bool HasCongestionMark (uint32_t handle) const;
+
+  /**
+   * @return The name of the entry
+   */
+  Ptr<const ccnx::CCNxName> GetName (uint32_t handle) const;
+
+  /**
+   * @return The AcmeFlatNameDigest of the entry's name
+   */
+  uint64_t GetDigest (uint32_t handle) const;
+
+  /**
+   * Sets a callback that `Find` calls with the handle of an expired entry just
+   * before erasing it.
+   */
+  void SetExpiredCallback (Callback<void, uint32_t> expired);
+
+  /**
+   * Removes the entry and returns its slot to the pool
+   */
+  void Erase (uint32_t handle);
+
+  /**
+   * @return The number of entries in the table (including expired entries not yet reclaimed)
+   */
+  size_t GetSize (void) const;
+
+  /**
+   * @return The operations the table has performed since it was created, for the
+   * cost model of `AcmeFlatForwarder`
+   */
+  AcmeFlatOperationCounts GetOperations (void) const;
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  typedef struct
+  {
+    Ptr<const ccnx::CCNxName> name;
+    uint64_t digest;            //< 0 when the slot is free
+    uint32_t generation;
+    Time expiry;
+    IngressListType ingress;    //< keeps its capacity when the slot is reused
+    bool hasEgress;
+    ccnx::CCNxConnection::ConnIdType egress;
+    Time sent;
+    bool congestionMark;
+  } EntryType;
+
+  std::vector<EntryType> m_entries;
+
+  /**
+   * Free list of handles in m_entries
+   */
+  std::vector<uint32_t> m_freeEntries;
+
+  /**
+   * Name digest -> entry handle
+   */
+  AcmeFlatDigestIndex m_index;
+
+  /**
+   * Segment compares and insertions; the probes are counted by m_index
+   */
+  AcmeFlatOperationCounts m_operations;
+
+  Callback<void, uint32_t> m_expired;
+
+  /**
+   * How long an entry lives after its last Interest.  Set by the "DefaultLifetime" attribute.
+   */
+  Time m_defaultLifetime;
+};
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATPIT_H
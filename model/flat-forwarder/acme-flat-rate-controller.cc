@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <algorithm>
+#include "acme-flat-rate-controller.h"
+
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/simulator.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+NS_LOG_COMPONENT_DEFINE ("AcmeFlatRateController");
+NS_OBJECT_ENSURE_REGISTERED (AcmeFlatRateController);
+
+static const double _defaultDecreaseFactor = 0.5;
+static const double _defaultIncreaseStep = 1.0;
+static const Time _defaultReactionInterval = MilliSeconds (100);
+static const Time _defaultMaxInterval = Seconds (10);
+
+TypeId
+AcmeFlatRateController::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ccnx::AcmeFlatRateController")
+    .SetParent<Object> ()
+    .SetGroupName ("CCNx")
+    .AddConstructor<AcmeFlatRateController> ()
+    .AddAttribute ("DecreaseFactor", "The rate is multiplied by this on a congestion mark",
+                   DoubleValue (_defaultDecreaseFactor),
+                   MakeDoubleAccessor (&AcmeFlatRateController::m_decreaseFactor),
+                   MakeDoubleChecker<double> (0, 1))
+    .AddAttribute ("IncreaseStep", "The Interests per second added each ReactionInterval without a mark",
+                   DoubleValue (_defaultIncreaseStep),
+                   MakeDoubleAccessor (&AcmeFlatRateController::m_increaseStep),
+                   MakeDoubleChecker<double> (0))
+    .AddAttribute ("ReactionInterval", "The least time between rate cuts, and the period of the increase",
+                   TimeValue (_defaultReactionInterval),
+                   MakeTimeAccessor (&AcmeFlatRateController::m_reactionInterval),
+                   MakeTimeChecker (NanoSeconds (1)))
+    .AddAttribute ("MaxInterval", "The longest request interval the controller sets",
+                   TimeValue (_defaultMaxInterval),
+                   MakeTimeAccessor (&AcmeFlatRateController::m_maxInterval),
+                   MakeTimeChecker (NanoSeconds (1)))
+  ;
+  return tid;
+}
+
+AcmeFlatRateController::AcmeFlatRateController ()
+  : m_decreaseFactor (_defaultDecreaseFactor), m_increaseStep (_defaultIncreaseStep),
+  m_reactionInterval (_defaultReactionInterval), m_maxInterval (_defaultMaxInterval),
+  m_maxRate (0), m_rate (0), m_lastDecrease (Seconds (-1)), m_lastMark (Seconds (-1)),
+  m_marks (0), m_decreases (0)
+{
+  // empty
+}
+
+AcmeFlatRateController::~AcmeFlatRateController ()
+{
+  // empty (use DoDispose)
+}
+
+void
+AcmeFlatRateController::DoDispose (void)
+{
+  Simulator::Cancel (m_increaseEvent);
+  m_consumer = 0;
+  m_prefix = 0;
+  Object::DoDispose ();
+}
+
+void
+AcmeFlatRateController::SetConsumer (Ptr<Object> consumer, Ptr<const CCNxName> prefix, Time interval,
+                                     std::string attribute)
+{
+  NS_ASSERT_MSG (interval.IsStrictlyPositive (), "The request interval must be positive");
+  m_consumer = consumer;
+  m_prefix = prefix;
+  m_attribute = attribute;
+  m_maxRate = 1.0 / interval.GetSeconds ();
+  m_rate = m_maxRate;
+}
+
+bool
+AcmeFlatRateController::IsConsumerName (const CCNxName &name) const
+{
+  if (!m_prefix)
+    {
+      return true;
+    }
+  if (name.GetSegmentCount () < m_prefix->GetSegmentCount ())
+    {
+      return false;
+    }
+  for (size_t i = 0; i < m_prefix->GetSegmentCount (); ++i)
+    {
+      if (!name.GetSegment (i)->Equals (*m_prefix->GetSegment (i)))
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+AcmeFlatRateController::CongestionMarked (Ptr<CCNxPacket> packet, Ptr<CCNxConnection> egress)
+{
+  if (m_maxRate <= 0 || !IsConsumerName (*packet->GetMessage ()->GetName ()))
+    {
+      return;
+    }
+
+  Time now = Simulator::Now ();
+  m_marks++;
+  m_lastMark = now;
+
+  // Marks of the Interests already sent at the old rate come in for about a
+  // round trip after a cut, so only one cut per reaction interval
+  if (m_decreases > 0 && now - m_lastDecrease < m_reactionInterval)
+    {
+      return;
+    }
+  m_decreases++;
+  m_lastDecrease = now;
+  SetRate (m_rate * m_decreaseFactor);
+  NS_LOG_INFO ("Congestion mark, request interval now " << GetInterval ());
+
+  if (!m_increaseEvent.IsRunning ())
+    {
+      m_increaseEvent = Simulator::Schedule (m_reactionInterval, &AcmeFlatRateController::Increase, this);
+    }
+}
+
+void
+AcmeFlatRateController::Increase (void)
+{
+  if (Simulator::Now () - m_lastMark >= m_reactionInterval)
+    {
+      SetRate (m_rate + m_increaseStep);
+    }
+
+  // Stop once back at the configured rate; the next mark restarts it
+  if (m_rate < m_maxRate)
+    {
+      m_increaseEvent = Simulator::Schedule (m_reactionInterval, &AcmeFlatRateController::Increase, this);
+    }
+}
+
+void
+AcmeFlatRateController::SetRate (double rate)
+{
+  m_rate = std::max (std::min (rate, m_maxRate), 1.0 / m_maxInterval.GetSeconds ());
+  if (m_consumer)
+    {
+      m_consumer->SetAttribute (m_attribute, TimeValue (GetInterval ()));
+    }
+}
+
+Time
+AcmeFlatRateController::GetInterval (void) const
+{
+  return m_rate > 0 ? Seconds (1.0 / m_rate) : m_maxInterval;
+}
+
+uint64_t
+AcmeFlatRateController::GetMarks (void) const
+{
+  return m_marks;
+}
+
+uint64_t
+AcmeFlatRateController::GetDecreases (void) const
+{
+  return m_decreases;
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+#ifndef CCNS3SIM_ACMEFLATRATECONTROLLER_H
+#define CCNS3SIM_ACMEFLATRATECONTROLLER_H
+
+#include <string>
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/ccnx-name.h"
+#include "ns3/ccnx-packet.h"
+#include "ns3/ccnx-connection.h"
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * Adapts the Interest rate of a consumer to the congestion marks of the
+ * Content Objects it receives (see "MarkingTarget" of `AcmeFlatForwarder`).
+ * The rate follows additive increase, multiplicative decrease: a mark cuts it
+ * by "DecreaseFactor", at most once per "ReactionInterval", and each
+ * ReactionInterval without a mark adds "IncreaseStep" Interests per second, up
+ * to the consumer's configured rate.
+ *
+ * The controller writes the rate to the consumer as its request interval
+ * attribute.  Connect it to the "CongestionMarked" trace source of the
+ * forwarder on the consumer's node:
+ * @code
+ * Ptr<AcmeFlatRateController> controller = CreateObject<AcmeFlatRateController> ();
+ * controller->SetConsumer (consumerApps.Get (0), repo->GetRepositoryPrefix (), MilliSeconds (50));
+ * consumerNode->GetObject<AcmeFlatForwarder> ()->TraceConnectWithoutContext (
+ *   "CongestionMarked", MakeCallback (&AcmeFlatRateController::CongestionMarked, controller));
+ * @endcode
+ */
+class AcmeFlatRateController : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+
+  AcmeFlatRateController ();
+  virtual ~AcmeFlatRateController ();
+
+  /**
+   * @param [in] consumer The object whose request interval the controller sets (may be null)
+   * @param [in] prefix Only Content Objects under this prefix are the consumer's (null for all)
+   * @param [in] interval The consumer's configured request interval, its fastest rate
+   * @param [in] attribute The name of the consumer's request interval attribute
+   */
+  void SetConsumer (Ptr<Object> consumer, Ptr<const ccnx::CCNxName> prefix, Time interval,
+                    std::string attribute = "RequestInterval");
+
+  /**
+   * Sink of the "CongestionMarked" trace source of `AcmeFlatForwarder`
+   */
+  void CongestionMarked (Ptr<ccnx::CCNxPacket> packet, Ptr<ccnx::CCNxConnection> egress);
+
+  /**
+   * @return The request interval the controller has set
+   */
+  Time GetInterval (void) const;
+
+  /**
+   * @return The number of marks received for the consumer
+   */
+  uint64_t GetMarks (void) const;
+
+  /**
+   * @return The number of times the rate was cut
+   */
+  uint64_t GetDecreases (void) const;
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /**
+   * @return true if `name` is under m_prefix
+   */
+  bool IsConsumerName (const ccnx::CCNxName &name) const;
+
+  /**
+   * Simulator event: adds IncreaseStep to the rate if there was no mark in the last ReactionInterval
+   */
+  void Increase (void);
+
+  /**
+   * Sets m_rate, clamped to the configured rate and "MaxInterval", and gives it to the consumer
+   */
+  void SetRate (double rate);
+
+  double m_decreaseFactor;
+  double m_increaseStep;
+  Time m_reactionInterval;
+  Time m_maxInterval;
+
+  Ptr<Object> m_consumer;
+  Ptr<const ccnx::CCNxName> m_prefix;
+  std::string m_attribute;
+
+  /**
+   * The configured rate and the current rate, in Interests per second
+   */
+  double m_maxRate;
+  double m_rate;
+
+  Time m_lastDecrease;
+  Time m_lastMark;
+  EventId m_increaseEvent;
+
+  uint64_t m_marks;
+  uint64_t m_decreases;
+};
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATRATECONTROLLER_H
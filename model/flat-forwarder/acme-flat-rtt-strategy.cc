@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <algorithm>
+#include "acme-flat-rtt-strategy.h"
+
+#include "ns3/log.h"
+#include "ns3/double.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+NS_LOG_COMPONENT_DEFINE ("AcmeFlatRttStrategy");
+NS_OBJECT_ENSURE_REGISTERED (AcmeFlatRttStrategy);
+
+static const double _defaultExplorationFraction = 0.05;
+static const double _defaultGain = 0.125;
+
+TypeId
+AcmeFlatRttStrategy::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ccnx::AcmeFlatRttStrategy")
+    .SetParent<AcmeFlatStrategy> ()
+    .SetGroupName ("CCNx")
+    .AddConstructor<AcmeFlatRttStrategy> ()
+    .AddAttribute ("ExplorationFraction", "The fraction of Interests sent to a next hop other than the fastest",
+                   DoubleValue (_defaultExplorationFraction),
+                   MakeDoubleAccessor (&AcmeFlatRttStrategy::m_explorationFraction),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+    .AddAttribute ("Gain", "The weight of a new sample in the smoothed round trip time",
+                   DoubleValue (_defaultGain),
+                   MakeDoubleAccessor (&AcmeFlatRttStrategy::m_gain),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+  ;
+  return tid;
+}
+
+AcmeFlatRttStrategy::AcmeFlatRttStrategy ()
+  : m_explorationFraction (_defaultExplorationFraction), m_gain (_defaultGain),
+  m_random (CreateObject<UniformRandomVariable> ()), m_explorations (0), m_samples (0)
+{
+  // empty
+}
+
+AcmeFlatRttStrategy::~AcmeFlatRttStrategy ()
+{
+  // empty (use DoDispose)
+}
+
+void
+AcmeFlatRttStrategy::DoDispose (void)
+{
+  m_random = 0;
+  AcmeFlatStrategy::DoDispose ();
+}
+
+int64_t
+AcmeFlatRttStrategy::AssignStreams (int64_t stream)
+{
+  m_random->SetStream (stream);
+  return 1;
+}
+
+AcmeFlatFib::NextHopType &
+AcmeFlatRttStrategy::SelectNextHop (AcmeFlatFib &fib, AcmeFlatFib::NextHopType &first, uint64_t digest,
+                                    CCNxConnection::ConnIdType ingressId)
+{
+  // The fastest next hop, an unmeasured one (rtt 0) counting as fastest
+  AcmeFlatFib::NextHopType *best = 0;
+  size_t candidates = 0;
+  size_t count = fib.GetNextHopCount (first);
+  for (size_t i = 0; i < count; ++i)
+    {
+      AcmeFlatFib::NextHopType &nextHop = fib.GetNextHop (first, i);
+      if (nextHop.connId != ingressId)
+        {
+          candidates++;
+          if (!best || fib.PeekNextHopState (nextHop).rtt < fib.PeekNextHopState (*best).rtt)
+            {
+              best = &nextHop;
+            }
+        }
+    }
+
+  if (!best)
+    {
+      return first;
+    }
+
+  if (candidates > 1 && m_explorationFraction > 0.0 && m_random->GetValue () < m_explorationFraction)
+    {
+      // One of the other candidates, uniformly
+      uint32_t skip = m_random->GetInteger (0, static_cast<uint32_t> (candidates - 2));
+      for (size_t i = 0; i < count; ++i)
+        {
+          AcmeFlatFib::NextHopType &nextHop = fib.GetNextHop (first, i);
+          if (nextHop.connId != ingressId && &nextHop != best && skip-- == 0)
+            {
+              m_explorations++;
+              return nextHop;
+            }
+        }
+    }
+  return *best;
+}
+
+bool
+AcmeFlatRttStrategy::IsMeasuring (void) const
+{
+  return true;
+}
+
+void
+AcmeFlatRttStrategy::ReportRtt (AcmeFlatFib &fib, AcmeFlatFib::NextHopType &nextHop, Time rtt)
+{
+  NS_LOG_FUNCTION (this << nextHop.connId << rtt);
+  Update (fib, nextHop, rtt);
+}
+
+void
+AcmeFlatRttStrategy::ReportTimeout (AcmeFlatFib &fib, AcmeFlatFib::NextHopType &nextHop, Time elapsed)
+{
+  NS_LOG_FUNCTION (this << nextHop.connId << elapsed);
+  Update (fib, nextHop, elapsed);
+}
+
+void
+AcmeFlatRttStrategy::Update (AcmeFlatFib &fib, AcmeFlatFib::NextHopType &nextHop, Time sample)
+{
+  m_samples++;
+  AcmeFlatFib::NextHopStateType &state = fib.GetNextHopState (nextHop);
+  int64_t measured = std::max<int64_t> (sample.GetTimeStep (), 1);
+  int64_t rtt = state.rtt.GetTimeStep ();
+  if (rtt == 0)
+    {
+      rtt = measured;
+    }
+  else
+    {
+      int64_t step = static_cast<int64_t> (m_gain * (measured - rtt));
+      rtt = std::max<int64_t> (rtt + step, 1);
+    }
+  state.rtt = TimeStep (rtt);
+}
+
+uint64_t
+AcmeFlatRttStrategy::GetExplorations (void) const
+{
+  return m_explorations;
+}
+
+uint64_t
+AcmeFlatRttStrategy::GetSamples (void) const
+{
+  return m_samples;
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_ACMEFLATRTTSTRATEGY_H
+#define CCNS3SIM_ACMEFLATRTTSTRATEGY_H
+
+#include "ns3/random-variable-stream.h"
+#include "ns3/acme-flat-strategy.h"
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * Sends Interests to the next hop with the lowest smoothed round trip time.
+ * Each next hop of a route keeps its own estimate, so the estimate is per
+ * (prefix, egress connection).  A next hop that has not been measured yet is
+ * tried first.
+ *
+ * A fraction of Interests ("ExplorationFraction") goes to one of the other
+ * next hops, chosen at random, so a next hop that got faster is noticed.  A
+ * timeout counts as a sample of the time the Interest waited, which pushes a
+ * next hop that stopped answering behind the others.
+ *
+ * The estimate is an exponentially weighted moving average with gain "Gain":
+ * rtt += Gain * (sample - rtt).
+ *
+ * Example:
+ * @code
+ * {
+ *     AcmeFlatForwarderHelper flatHelper;
+ *     flatHelper.SetStrategyType (AcmeFlatRttStrategy::GetTypeId ());
+ *     flatHelper.SetStrategyAttribute ("ExplorationFraction", DoubleValue (0.1));
+ * }
+ * @endcode
+ */
+class AcmeFlatRttStrategy : public AcmeFlatStrategy
+{
+public:
+  static TypeId GetTypeId (void);
+
+  AcmeFlatRttStrategy ();
+  virtual ~AcmeFlatRttStrategy ();
+
+  virtual AcmeFlatFib::NextHopType & SelectNextHop (AcmeFlatFib &fib, AcmeFlatFib::NextHopType &first, uint64_t digest,
+                                                    ccnx::CCNxConnection::ConnIdType ingressId);
+
+  virtual bool IsMeasuring (void) const;
+
+  virtual void ReportRtt (AcmeFlatFib &fib, AcmeFlatFib::NextHopType &nextHop, Time rtt);
+
+  virtual void ReportTimeout (AcmeFlatFib &fib, AcmeFlatFib::NextHopType &nextHop, Time elapsed);
+
+  /**
+   * Assigns a fixed random variable stream number to the exploration draws
+   *
+   * @param stream The first stream number to use
+   * @return The number of streams used (1)
+   */
+  int64_t AssignStreams (int64_t stream);
+
+  /**
+   * @return The number of Interests sent to a next hop other than the fastest
+   */
+  uint64_t GetExplorations (void) const;
+
+  /**
+   * @return The number of round trip times and timeouts reported
+   */
+  uint64_t GetSamples (void) const;
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /**
+   * Folds `sample` into the estimate of `nextHop`
+   */
+  void Update (AcmeFlatFib &fib, AcmeFlatFib::NextHopType &nextHop, Time sample);
+
+  /**
+   * The fraction of Interests sent to a next hop other than the fastest.
+   *
+   * This value is set via the attribute "ExplorationFraction".  The default is 0.05.
+   */
+  double m_explorationFraction;
+
+  /**
+   * The weight of a new sample in the moving average.
+   *
+   * This value is set via the attribute "Gain".  The default is 0.125.
+   */
+  double m_gain;
+
+  Ptr<UniformRandomVariable> m_random;
+
+  uint64_t m_explorations;
+  uint64_t m_samples;
+};
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATRTTSTRATEGY_H
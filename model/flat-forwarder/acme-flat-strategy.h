@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_ACMEFLATSTRATEGY_H
+#define CCNS3SIM_ACMEFLATSTRATEGY_H
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/acme-flat-fib.h"
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * Abstract forwarding strategy of `AcmeFlatForwarder`: chooses which next hop
+ * of a multipath route an Interest goes to.  Single-path routes do not consult
+ * the strategy.
+ *
+ * A strategy that returns true from IsMeasuring is told how each Interest it
+ * placed on a multipath route turned out: the round trip time when the Content
+ * Object comes back on the chosen next hop (ReportRtt), or the time waited when
+ * the PIT entry expires (ReportTimeout).  A retransmitted Interest is not timed.
+ * The strategy keeps what it learns in the `rtt` of the next hop's state (see
+ * `AcmeFlatFib::GetNextHopState`).
+ *
+ * The implementation is set with `AcmeFlatForwarderHelper::SetStrategyType`.
+ * The default is `AcmeFlatHashStrategy`.
+ */
+class AcmeFlatStrategy : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+
+  AcmeFlatStrategy ();
+  virtual ~AcmeFlatStrategy ();
+
+  /**
+   * Chooses the next hop of an Interest.
+   *
+   * @param [in] fib The FIB of the route
+   * @param [in] first The first next hop of a route with more than one next hop
+   * @param [in] digest The AcmeFlatNameDigest of the Interest name
+   * @param [in] ingressId The connection the Interest arrived on
+   * @return A next hop of the route other than `ingressId`, or `first` if there is none
+   */
+  virtual AcmeFlatFib::NextHopType & SelectNextHop (AcmeFlatFib &fib, AcmeFlatFib::NextHopType &first, uint64_t digest,
+                                                    ccnx::CCNxConnection::ConnIdType ingressId) = 0;
+
+  /**
+   * @return true if the forwarder should call ReportRtt and ReportTimeout.  The default is false.
+   */
+  virtual bool IsMeasuring (void) const;
+
+  /**
+   * A Content Object came back on `nextHop` of `fib` `rtt` after its Interest
+   * was sent there.  The default does nothing.
+   */
+  virtual void ReportRtt (AcmeFlatFib &fib, AcmeFlatFib::NextHopType &nextHop, Time rtt);
+
+  /**
+   * An Interest sent to `nextHop` of `fib` `elapsed` ago expired without a
+   * Content Object.  The default does nothing.
+   */
+  virtual void ReportTimeout (AcmeFlatFib &fib, AcmeFlatFib::NextHopType &nextHop, Time elapsed);
+};
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATSTRATEGY_H
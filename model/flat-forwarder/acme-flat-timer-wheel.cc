@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "acme-flat-timer-wheel.h"
+
+#include "ns3/assert.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+
+const unsigned AcmeFlatTimerWheel::SlotBits;
+const unsigned AcmeFlatTimerWheel::SlotsPerLevel;
+const unsigned AcmeFlatTimerWheel::Levels;
+const uint64_t AcmeFlatTimerWheel::Never;
+const uint32_t AcmeFlatTimerWheel::_none;
+
+static const uint64_t _slotMask = AcmeFlatTimerWheel::SlotsPerLevel - 1;
+
+/**
+ * @return The index of the lowest set bit of a non-zero word
+ */
+static unsigned
+LowestBit (uint64_t word)
+{
+  unsigned bit = 0;
+  while ((word & 1) == 0)
+    {
+      word >>= 1;
+      bit++;
+    }
+  return bit;
+}
+
+AcmeFlatTimerWheel::AcmeFlatTimerWheel ()
+  : m_slots (Levels * SlotsPerLevel, _none), m_now (0), m_count (0)
+{
+  for (unsigned level = 0; level < Levels; ++level)
+    {
+      m_occupancy[level] = 0;
+    }
+}
+
+void
+AcmeFlatTimerWheel::Place (uint32_t index)
+{
+  uint64_t tick = m_nodes[index].tick;
+
+  // The lowest level whose current block contains the tick.  The top level is
+  // circular and also holds ticks in the next top block.
+  unsigned level = 0;
+  while (level < Levels - 1 && (tick >> (SlotBits * (level + 1))) != (m_now >> (SlotBits * (level + 1))))
+    {
+      level++;
+    }
+
+  unsigned slot = (tick >> (SlotBits * level)) & _slotMask;
+  uint32_t &head = m_slots[level * SlotsPerLevel + slot];
+  m_nodes[index].next = head;
+  head = index;
+  m_occupancy[level] |= (1ULL << slot);
+}
+
+void
+AcmeFlatTimerWheel::Insert (uint64_t tick, uint32_t handle, uint32_t generation)
+{
+  if (tick <= m_now)
+    {
+      tick = m_now + 1;
+    }
+
+  // Beyond the top level: fire at the end of the wheel's range
+  const uint64_t range = 1ULL << (SlotBits * Levels);
+  if (tick - m_now >= range)
+    {
+      tick = m_now + range - 1;
+    }
+
+  uint32_t index;
+  if (m_freeNodes.empty ())
+    {
+      index = static_cast<uint32_t> (m_nodes.size ());
+      m_nodes.push_back (NodeType ());
+    }
+  else
+    {
+      index = m_freeNodes.back ();
+      m_freeNodes.pop_back ();
+    }
+
+  m_nodes[index].tick = tick;
+  m_nodes[index].timer.handle = handle;
+  m_nodes[index].timer.generation = generation;
+  Place (index);
+  m_count++;
+}
+
+void
+AcmeFlatTimerWheel::Cascade (unsigned level, unsigned slot)
+{
+  uint32_t index = m_slots[level * SlotsPerLevel + slot];
+  m_slots[level * SlotsPerLevel + slot] = _none;
+  m_occupancy[level] &= ~(1ULL << slot);
+
+  while (index != _none)
+    {
+      uint32_t next = m_nodes[index].next;
+      Place (index);
+      index = next;
+    }
+}
+
+void
+AcmeFlatTimerWheel::Expire (std::vector<TimerType> &expired)
+{
+  // At a block boundary of level L, bring down the level L slot of the new block
+  for (unsigned level = Levels - 1; level > 0; --level)
+    {
+      if ((m_now & ((1ULL << (SlotBits * level)) - 1)) == 0)
+        {
+          unsigned slot = (m_now >> (SlotBits * level)) & _slotMask;
+          if (m_occupancy[level] & (1ULL << slot))
+            {
+              Cascade (level, slot);
+            }
+        }
+    }
+
+  unsigned slot = m_now & _slotMask;
+  if (m_occupancy[0] & (1ULL << slot))
+    {
+      uint32_t index = m_slots[slot];
+      m_slots[slot] = _none;
+      m_occupancy[0] &= ~(1ULL << slot);
+
+      while (index != _none)
+        {
+          NS_ASSERT_MSG (m_nodes[index].tick == m_now, "Timer in the wrong slot");
+          expired.push_back (m_nodes[index].timer);
+          m_freeNodes.push_back (index);
+          m_count--;
+          index = m_nodes[index].next;
+        }
+    }
+}
+
+void
+AcmeFlatTimerWheel::Advance (uint64_t tick, std::vector<TimerType> &expired)
+{
+  if (m_count == 0)
+    {
+      if (tick > m_now)
+        {
+          m_now = tick;
+        }
+      return;
+    }
+
+  while (m_now < tick)
+    {
+      if (m_count == 0)
+        {
+          m_now = tick;
+          break;
+        }
+
+      // Jump to the next occupied level 0 slot or the next block boundary
+      uint64_t next = m_now + 1;
+      unsigned offset = next & _slotMask;
+      if (offset != 0)
+        {
+          uint64_t pending = m_occupancy[0] >> offset;
+          next = (pending != 0) ? next + LowestBit (pending) : (m_now | _slotMask) + 1;
+        }
+      m_now = (next < tick) ? next : tick;
+      Expire (expired);
+    }
+}
+
+uint64_t
+AcmeFlatTimerWheel::GetNextTick (void) const
+{
+  if (m_count == 0)
+    {
+      return Never;
+    }
+
+  // Occupied slots of a lower level L are all after the current slot of level
+  // L, and the earliest one is due (or cascades) at the start of its block.
+  uint64_t best = Never;
+  for (unsigned level = 0; level < Levels - 1; ++level)
+    {
+      unsigned offset = ((m_now >> (SlotBits * level)) & _slotMask) + 1;
+      if (offset >= SlotsPerLevel)
+        {
+          continue;
+        }
+      uint64_t pending = m_occupancy[level] >> offset;
+      if (pending != 0)
+        {
+          unsigned slot = offset + LowestBit (pending);
+          uint64_t block = (m_now >> (SlotBits * (level + 1))) << (SlotBits * (level + 1));
+          uint64_t tick = block | (static_cast<uint64_t> (slot) << (SlotBits * level));
+          if (tick < best)
+            {
+              best = tick;
+            }
+        }
+    }
+
+  // The top level wraps: a slot at or before the current one is in the next top block
+  const unsigned top = Levels - 1;
+  if (m_occupancy[top] != 0)
+    {
+      unsigned current = (m_now >> (SlotBits * top)) & _slotMask;
+      uint64_t block = (m_now >> (SlotBits * Levels)) << (SlotBits * Levels);
+      uint64_t after = (current + 1 < SlotsPerLevel) ? (m_occupancy[top] >> (current + 1)) : 0;
+      unsigned slot;
+      if (after != 0)
+        {
+          slot = current + 1 + LowestBit (after);
+        }
+      else
+        {
+          slot = LowestBit (m_occupancy[top]);
+          block += 1ULL << (SlotBits * Levels);
+        }
+      uint64_t tick = block | (static_cast<uint64_t> (slot) << (SlotBits * top));
+      if (tick < best)
+        {
+          best = tick;
+        }
+    }
+
+  NS_ASSERT_MSG (best != Never, "Pending timers but no occupied slot");
+  return best;
+}
+
+uint64_t
+AcmeFlatTimerWheel::GetCurrentTick (void) const
+{
+  return m_now;
+}
+
+size_t
+AcmeFlatTimerWheel::GetSize (void) const
+{
+  return m_count;
+}
+
+void
+AcmeFlatTimerWheel::Clear (void)
+{
+  m_nodes.clear ();
+  m_freeNodes.clear ();
+  m_slots.assign (m_slots.size (), _none);
+  for (unsigned level = 0; level < Levels; ++level)
+    {
+      m_occupancy[level] = 0;
+    }
+  m_count = 0;
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_ACMEFLATTIMERWHEEL_H
+#define CCNS3SIM_ACMEFLATTIMERWHEEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * A hierarchical timing wheel of integer ticks.  Each timer carries a 32-bit
+ * handle and generation chosen by the caller (e.g. a PIT entry and its reuse
+ * count), so a stale timer can be recognized and ignored when it fires.
+ *
+ * There are `Levels` wheels of `SlotsPerLevel` slots.  Level L holds the timers
+ * due in the current block of 64^(L+1) ticks (the top level wraps around), and
+ * its slots are cascaded into the lower levels as the wheel reaches them.  Insert is O(1), and `Advance`
+ * skips empty level 0 slots with a per-level occupancy bitmap.  Timers are
+ * pooled nodes on intrusive slot lists, so there is no per-timer allocation in
+ * steady state.
+ *
+ * The wheel does not schedule anything.  The owner runs one simulator event at
+ * `GetNextTick`, calls `Advance`, and reschedules, so many timers that fall in
+ * the same slot cost one event.
+ *
+ * A timer further out than the wheel's range (64^4 ticks) fires at the end of
+ * the range; the caller should check its own deadline and re-insert it.
+ */
+class AcmeFlatTimerWheel
+{
+public:
+  static const unsigned SlotBits = 6;
+  static const unsigned SlotsPerLevel = 1 << SlotBits;
+  static const unsigned Levels = 4;
+
+  /**
+   * `GetNextTick` of an empty wheel
+   */
+  static const uint64_t Never = ~0ULL;
+
+  typedef struct
+  {
+    uint32_t handle;
+    uint32_t generation;
+  } TimerType;
+
+  AcmeFlatTimerWheel ();
+
+  /**
+   * Adds a timer.  A tick that is not after the current tick fires on the next tick.
+   *
+   * @param [in] tick The tick at which the timer fires
+   * @param [in] handle The caller's handle
+   * @param [in] generation The caller's generation of `handle`
+   */
+  void Insert (uint64_t tick, uint32_t handle, uint32_t generation);
+
+  /**
+   * Moves the current tick up to `tick` and appends every timer that fired to `expired`.
+   *
+   * @param [in] tick The new current tick (ignored if not after the current tick)
+   * @param [out] expired The timers due on or before `tick`
+   */
+  void Advance (uint64_t tick, std::vector<TimerType> &expired);
+
+  /**
+   * @return The next tick at which `Advance` has work to do, or `Never` if the wheel is empty
+   */
+  uint64_t GetNextTick (void) const;
+
+  uint64_t GetCurrentTick (void) const;
+
+  /**
+   * @return The number of pending timers
+   */
+  size_t GetSize (void) const;
+
+  void Clear (void);
+
+private:
+  static const uint32_t _none = 0xFFFFFFFF;
+
+  typedef struct
+  {
+    uint64_t tick;
+    TimerType timer;
+    uint32_t next;
+  } NodeType;
+
+  /**
+   * Links node `index` into the slot for its tick
+   */
+  void Place (uint32_t index);
+
+  /**
+   * Re-places every timer in a slot of level `level` into the lower levels
+   */
+  void Cascade (unsigned level, unsigned slot);
+
+  /**
+   * Processes the current tick: cascades at block boundaries and fires level 0
+   */
+  void Expire (std::vector<TimerType> &expired);
+
+  std::vector<NodeType> m_nodes;
+  std::vector<uint32_t> m_freeNodes;
+
+  /**
+   * Head node of each slot, Levels * SlotsPerLevel
+   */
+  std::vector<uint32_t> m_slots;
+
+  /**
+   * Bit s of m_occupancy[L] is set if slot s of level L is not empty
+   */
+  uint64_t m_occupancy[Levels];
+
+  uint64_t m_now;
+  size_t m_count;
+};
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATTIMERWHEEL_H
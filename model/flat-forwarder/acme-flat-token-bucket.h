@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+#ifndef CCNS3SIM_ACMEFLATTOKENBUCKET_H
+#define CCNS3SIM_ACMEFLATTOKENBUCKET_H
+
+#include <stdint.h>
+#include "ns3/nstime.h"
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * A token bucket that admits `rate` packets per second on average and bursts
+ * of up to `burst` packets.  It is refilled lazily: each Consume adds the
+ * tokens earned since the previous call, so a bucket costs no simulator events
+ * however many connections have one.
+ *
+ * The bucket starts full.
+ */
+class AcmeFlatTokenBucket
+{
+public:
+  /**
+   * @param [in] rate The tokens added per second
+   * @param [in] burst The most tokens the bucket holds
+   */
+  AcmeFlatTokenBucket (double rate = 0, double burst = 1);
+
+  /**
+   * Refills the bucket up to `now` and takes one token if there is one
+   *
+   * @param [in] now The current simulation time, not earlier than the previous call
+   * @return true if a token was taken (the packet conforms)
+   */
+  bool Consume (Time now);
+
+  /**
+   * @return The tokens in the bucket at `now`, without changing it
+   */
+  double GetTokens (Time now) const;
+
+  /**
+   * @return The number of Consume calls that took a token
+   */
+  uint64_t GetConforming (void) const;
+
+  /**
+   * @return The number of Consume calls that found the bucket empty
+   */
+  uint64_t GetExceeding (void) const;
+
+private:
+  double Refill (Time now) const;
+
+  double m_rate;
+  double m_burst;
+  double m_tokens;
+  Time m_lastRefill;
+  uint64_t m_conforming;
+  uint64_t m_exceeding;
+};
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATTOKENBUCKET_H
@@ -0,0 +1,535 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "acme-flat-trie-fib.h"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/acme-flat-name-digest.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+NS_LOG_COMPONENT_DEFINE ("AcmeFlatTrieFib");
+NS_OBJECT_ENSURE_REGISTERED (AcmeFlatTrieFib);
+
+/**
+ * Do not bother compacting a segment pool smaller than this
+ */
+static const size_t _minCompactLabels = 1024;
+
+const uint32_t AcmeFlatTrieFib::_none;
+const uint32_t AcmeFlatTrieFib::_root;
+
+TypeId
+AcmeFlatTrieFib::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ccnx::AcmeFlatTrieFib")
+    .SetParent<AcmeFlatFib> ()
+    .SetGroupName ("CCNx")
+    .AddConstructor<AcmeFlatTrieFib> ()
+  ;
+  return tid;
+}
+
+AcmeFlatTrieFib::AcmeFlatTrieFib ()
+  : m_labelGarbage (0), m_routeCount (0)
+{
+  AllocateNode (0, 0);
+}
+
+AcmeFlatTrieFib::~AcmeFlatTrieFib ()
+{
+  // empty (use DoDispose)
+}
+
+void
+AcmeFlatTrieFib::DoDispose (void)
+{
+  m_nodes.clear ();
+  m_freeNodes.clear ();
+  m_labels.clear ();
+  m_edges.Clear ();
+  m_labelGarbage = 0;
+  m_routeCount = 0;
+  AllocateNode (0, 0);
+  AcmeFlatFib::DoDispose ();
+}
+
+uint64_t
+AcmeFlatTrieFib::EdgeKey (uint32_t parent, uint64_t segmentDigest)
+{
+  // segmentDigest is already finalized, so the low-order bits stay well mixed
+  uint64_t key = segmentDigest ^ ((static_cast<uint64_t> (parent) + 1) * 0x9e3779b97f4a7c15ULL);
+  return key == 0 ? 1 : key;
+}
+
+bool
+AcmeFlatTrieFib::SegmentEquals (const CCNxNameSegment &a, const CCNxNameSegment &b) const
+{
+  m_operations.segmentCompares++;
+  return a.GetType () == b.GetType () && a.GetValue () == b.GetValue ();
+}
+
+uint32_t
+AcmeFlatTrieFib::AllocateNode (uint32_t labelStart, uint32_t labelLength)
+{
+  uint32_t index;
+  if (m_freeNodes.empty ())
+    {
+      index = static_cast<uint32_t> (m_nodes.size ());
+      m_nodes.push_back (NodeType ());
+    }
+  else
+    {
+      index = m_freeNodes.back ();
+      m_freeNodes.pop_back ();
+    }
+
+  NodeType &node = m_nodes[index];
+  node.parent = _none;
+  node.firstChild = _none;
+  node.nextSibling = _none;
+  node.prevSibling = _none;
+  node.nextHop = MakeNextHop (0);
+  node.routeName = 0;
+  node.hasRoute = false;
+  node.inUse = true;
+  node.labelStart = 0;
+  node.labelLength = 0;
+  node.labelDigest = 0;
+  if (labelLength > 0)
+    {
+      SetLabel (index, labelStart, labelLength);
+    }
+  return index;
+}
+
+void
+AcmeFlatTrieFib::FreeNode (uint32_t index)
+{
+  NS_ASSERT_MSG (index != _root, "Cannot free the root");
+  m_labelGarbage += m_nodes[index].labelLength;
+  m_nodes[index].inUse = false;
+  m_nodes[index].labelLength = 0;
+  m_freeNodes.push_back (index);
+}
+
+void
+AcmeFlatTrieFib::SetLabel (uint32_t index, uint32_t labelStart, uint32_t labelLength)
+{
+  NodeType &node = m_nodes[index];
+  NS_ASSERT_MSG (node.parent == _none, "SetLabel on a linked node");
+  node.labelStart = labelStart;
+  node.labelLength = labelLength;
+  node.labelDigest = AcmeFlatNameDigest::ComputeSegment (*m_labels[labelStart]);
+}
+
+void
+AcmeFlatTrieFib::LinkChild (uint32_t parent, uint32_t child)
+{
+  NodeType &node = m_nodes[child];
+  node.parent = parent;
+  node.prevSibling = _none;
+  node.nextSibling = m_nodes[parent].firstChild;
+  if (node.nextSibling != _none)
+    {
+      m_nodes[node.nextSibling].prevSibling = child;
+    }
+  m_nodes[parent].firstChild = child;
+  m_edges.Insert (EdgeKey (parent, node.labelDigest), child);
+}
+
+void
+AcmeFlatTrieFib::UnlinkChild (uint32_t child)
+{
+  NodeType &node = m_nodes[child];
+  m_edges.Erase (EdgeKey (node.parent, node.labelDigest), child);
+
+  if (node.prevSibling != _none)
+    {
+      m_nodes[node.prevSibling].nextSibling = node.nextSibling;
+    }
+  else
+    {
+      m_nodes[node.parent].firstChild = node.nextSibling;
+    }
+  if (node.nextSibling != _none)
+    {
+      m_nodes[node.nextSibling].prevSibling = node.prevSibling;
+    }
+  node.parent = _none;
+  node.prevSibling = _none;
+  node.nextSibling = _none;
+}
+
+uint32_t
+AcmeFlatTrieFib::FindChild (uint32_t parent, const CCNxNameSegment &segment, uint64_t segmentDigest) const
+{
+  uint64_t key = EdgeKey (parent, segmentDigest);
+  size_t position = m_edges.Probe (key);
+  uint32_t child;
+  while (m_edges.Next (key, position, child))
+    {
+      const NodeType &node = m_nodes[child];
+      if (node.parent == parent && node.labelDigest == segmentDigest
+          && SegmentEquals (*m_labels[node.labelStart], segment))
+        {
+          return child;
+        }
+    }
+  return _none;
+}
+
+uint32_t
+AcmeFlatTrieFib::Walk (const CCNxName &name, bool exact) const
+{
+  const size_t count = name.GetSegmentCount ();
+  uint32_t index = _root;
+  uint32_t best = m_nodes[_root].hasRoute ? _root : _none;
+  size_t depth = 0;
+
+  while (depth < count)
+    {
+      Ptr<const CCNxNameSegment> segment = name.GetSegment (depth);
+      uint32_t child = FindChild (index, *segment, AcmeFlatNameDigest::ComputeSegment (*segment));
+      if (child == _none)
+        {
+          break;
+        }
+
+      // The first segment matched in FindChild, check the rest of the edge label
+      const NodeType &node = m_nodes[child];
+      if (depth + node.labelLength > count)
+        {
+          break;
+        }
+      uint32_t j = 1;
+      while (j < node.labelLength && SegmentEquals (*m_labels[node.labelStart + j], *name.GetSegment (depth + j)))
+        {
+          ++j;
+        }
+      if (j < node.labelLength)
+        {
+          break;
+        }
+
+      index = child;
+      depth += node.labelLength;
+      if (node.hasRoute)
+        {
+          best = child;
+        }
+    }
+
+  if (exact)
+    {
+      return depth == count ? index : _none;
+    }
+  return best;
+}
+
+bool
+AcmeFlatTrieFib::AddRoute (Ptr<const CCNxName> name, uint64_t digest, CCNxConnection::ConnIdType connId)
+{
+  NS_LOG_FUNCTION (this << name << connId);
+
+  const size_t count = name->GetSegmentCount ();
+  uint32_t index = _root;
+  size_t depth = 0;
+
+  while (depth < count)
+    {
+      Ptr<const CCNxNameSegment> segment = name->GetSegment (depth);
+      uint32_t child = FindChild (index, *segment, AcmeFlatNameDigest::ComputeSegment (*segment));
+      if (child == _none)
+        {
+          // New leaf holding the rest of the name as its label
+          uint32_t labelStart = static_cast<uint32_t> (m_labels.size ());
+          for (size_t i = depth; i < count; ++i)
+            {
+              m_labels.push_back (name->GetSegment (i));
+            }
+          uint32_t leaf = AllocateNode (labelStart, static_cast<uint32_t> (count - depth));
+          LinkChild (index, leaf);
+          index = leaf;
+          depth = count;
+          break;
+        }
+
+      // Match as much of the edge label as the name has
+      uint32_t labelStart = m_nodes[child].labelStart;
+      uint32_t labelLength = m_nodes[child].labelLength;
+      uint32_t j = 1;
+      while (j < labelLength && depth + j < count
+             && SegmentEquals (*m_labels[labelStart + j], *name->GetSegment (depth + j)))
+        {
+          ++j;
+        }
+
+      if (j < labelLength)
+        {
+          // Split the edge after j segments: index -> middle -> child
+          UnlinkChild (child);
+          uint32_t middle = AllocateNode (labelStart, j);
+          SetLabel (child, labelStart + j, labelLength - j);
+          LinkChild (index, middle);
+          LinkChild (middle, child);
+          child = middle;
+        }
+
+      index = child;
+      depth += j;
+    }
+
+  if (m_nodes[index].hasRoute)
+    {
+      return false;
+    }
+
+  m_nodes[index].hasRoute = true;
+  m_nodes[index].nextHop = MakeNextHop (connId);
+  m_nodes[index].routeName = name;
+  m_routeCount++;
+  m_operations.insertions++;
+  return true;
+}
+
+bool
+AcmeFlatTrieFib::RemoveRoute (Ptr<const CCNxName> name, uint64_t digest, CCNxConnection::ConnIdType connId)
+{
+  NS_LOG_FUNCTION (this << name << connId);
+
+  uint32_t index = Walk (*name, true);
+  if (index == _none || !m_nodes[index].hasRoute)
+    {
+      return false;
+    }
+
+  RemoveNextHopResultType result = RemoveNextHop (m_nodes[index].nextHop, connId);
+  if (result != ROUTE_EMPTY)
+    {
+      return result == NEXT_HOP_REMOVED;
+    }
+
+  m_nodes[index].hasRoute = false;
+  m_nodes[index].nextHop = MakeNextHop (0);
+  m_nodes[index].routeName = 0;
+  m_routeCount--;
+  Prune (index);
+
+  if (m_labelGarbage > _minCompactLabels && m_labelGarbage * 2 > m_labels.size ())
+    {
+      CompactLabels ();
+    }
+  return true;
+}
+
+void
+AcmeFlatTrieFib::Prune (uint32_t index)
+{
+  while (index != _root && !m_nodes[index].hasRoute)
+    {
+      uint32_t parent = m_nodes[index].parent;
+      uint32_t child = m_nodes[index].firstChild;
+
+      if (child == _none)
+        {
+          // A leaf without a route leads nowhere
+          UnlinkChild (index);
+          FreeNode (index);
+          index = parent;
+          continue;
+        }
+
+      if (m_nodes[child].nextSibling == _none)
+        {
+          // A single-child chain: merge the two labels into the child
+          uint32_t labelStart = static_cast<uint32_t> (m_labels.size ());
+          uint32_t upper = m_nodes[index].labelLength;
+          uint32_t lower = m_nodes[child].labelLength;
+          for (uint32_t i = 0; i < upper; ++i)
+            {
+              m_labels.push_back (m_labels[m_nodes[index].labelStart + i]);
+            }
+          for (uint32_t i = 0; i < lower; ++i)
+            {
+              m_labels.push_back (m_labels[m_nodes[child].labelStart + i]);
+            }
+          m_labelGarbage += lower;
+
+          UnlinkChild (child);
+          UnlinkChild (index);
+          FreeNode (index);
+          SetLabel (child, labelStart, upper + lower);
+          LinkChild (parent, child);
+        }
+      // The parent's child count did not change
+      break;
+    }
+}
+
+void
+AcmeFlatTrieFib::CompactLabels (void)
+{
+  NS_LOG_FUNCTION (this << m_labels.size () << m_labelGarbage);
+
+  std::vector<Ptr<const CCNxNameSegment> > labels;
+  labels.reserve (m_labels.size () - m_labelGarbage);
+  for (size_t i = 0; i < m_nodes.size (); ++i)
+    {
+      NodeType &node = m_nodes[i];
+      if (node.inUse && node.labelLength > 0)
+        {
+          uint32_t labelStart = static_cast<uint32_t> (labels.size ());
+          for (uint32_t j = 0; j < node.labelLength; ++j)
+            {
+              labels.push_back (m_labels[node.labelStart + j]);
+            }
+          node.labelStart = labelStart;
+        }
+    }
+  m_labels.swap (labels);
+  m_labelGarbage = 0;
+}
+
+bool
+AcmeFlatTrieFib::Lookup (Ptr<const CCNxName> name, uint64_t digest, CCNxConnection::ConnIdType &connId) const
+{
+  uint32_t index = Walk (*name, false);
+  if (index == _none)
+    {
+      return false;
+    }
+  connId = m_nodes[index].nextHop.connId;
+  return true;
+}
+
+AcmeFlatFib::NextHopType *
+AcmeFlatTrieFib::LookupNextHop (Ptr<const CCNxName> name, uint64_t digest)
+{
+  uint32_t index = Walk (*name, false);
+  if (index == _none)
+    {
+      return 0;
+    }
+  return &m_nodes[index].nextHop;
+}
+
+AcmeFlatFib::NextHopType *
+AcmeFlatTrieFib::LookupRoute (Ptr<const CCNxName> name, uint64_t digest, Ptr<const CCNxName> &routeName)
+{
+  uint32_t index = Walk (*name, false);
+  if (index == _none)
+    {
+      return 0;
+    }
+  routeName = m_nodes[index].routeName;
+  return &m_nodes[index].nextHop;
+}
+
+AcmeFlatFib::NextHopType *
+AcmeFlatTrieFib::FindRoute (Ptr<const CCNxName> name, uint64_t digest)
+{
+  uint32_t index = Walk (*name, true);
+  if (index == _none || !m_nodes[index].hasRoute)
+    {
+      return 0;
+    }
+  return &m_nodes[index].nextHop;
+}
+
+void
+AcmeFlatTrieFib::GetRoutes (std::vector<RouteType> &routes) const
+{
+  routes.reserve (routes.size () + m_routeCount);
+  for (size_t i = 0; i < m_nodes.size (); ++i)
+    {
+      const NodeType &node = m_nodes[i];
+      if (node.inUse && node.hasRoute)
+        {
+          AppendRoutes (PeekPointer (node.routeName), node.nextHop, routes);
+        }
+    }
+}
+
+size_t
+AcmeFlatTrieFib::GetSize (void) const
+{
+  return m_routeCount;
+}
+
+size_t
+AcmeFlatTrieFib::GetMemoryUsage (void) const
+{
+  return m_nodes.capacity () * sizeof(NodeType) + m_freeNodes.capacity () * sizeof(uint32_t)
+         + m_labels.capacity () * sizeof(Ptr<const CCNxNameSegment>) + m_edges.GetMemoryUsage ()
+         + GetNextHopMemoryUsage ();
+}
+
+AcmeFlatOperationCounts
+AcmeFlatTrieFib::GetOperations (void) const
+{
+  AcmeFlatOperationCounts operations = m_operations;
+  operations.probes += m_edges.GetProbes ();
+  return operations;
+}
+
+size_t
+AcmeFlatTrieFib::GetNodeCount (void) const
+{
+  return m_nodes.size () - m_freeNodes.size ();
+}
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_ACMEFLATTRIEFIB_H
+#define CCNS3SIM_ACMEFLATTRIEFIB_H
+
+#include <vector>
+#include "ns3/acme-flat-fib.h"
+#include "ns3/acme-flat-digest-index.h"
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * A longest-prefix-match FIB in a path-compressed name segment trie.
+ *
+ * A few prefix routes (e.g. `ccnx:/name=acm/name=icn/name=000001`) serve every
+ * name below them, and a lookup costs O(name depth) no matter how many routes
+ * there are.
+ *
+ * Layout: nodes live in one contiguous vector and refer to each other by 32-bit
+ * index, so there is no per-node heap allocation.  The edge label of a node (one
+ * or more segments, because single-child chains are collapsed) is a range in a
+ * shared segment pool; splitting an edge only splits the range.  Child lookup is
+ * a single probe of one trie-wide `AcmeFlatDigestIndex` keyed on (parent index,
+ * segment digest), so wide nodes with millions of children stay O(1).
+ *
+ * Removing a route prunes nodes that no longer lead to a route and re-collapses
+ * single-child chains.  The segment pool is compacted when more than half of it
+ * is unreferenced.
+ */
+class AcmeFlatTrieFib : public AcmeFlatFib
+{
+public:
+  static TypeId GetTypeId (void);
+
+  AcmeFlatTrieFib ();
+  virtual ~AcmeFlatTrieFib ();
+
+  virtual bool AddRoute (Ptr<const ccnx::CCNxName> name, uint64_t digest, ccnx::CCNxConnection::ConnIdType connId);
+
+  virtual bool RemoveRoute (Ptr<const ccnx::CCNxName> name, uint64_t digest, ccnx::CCNxConnection::ConnIdType connId);
+
+  /**
+   * Longest prefix match of `name`.
+   */
+  virtual bool Lookup (Ptr<const ccnx::CCNxName> name, uint64_t digest, ccnx::CCNxConnection::ConnIdType &connId) const;
+
+  virtual NextHopType * LookupNextHop (Ptr<const ccnx::CCNxName> name, uint64_t digest);
+
+  virtual NextHopType * LookupRoute (Ptr<const ccnx::CCNxName> name, uint64_t digest, Ptr<const ccnx::CCNxName> &routeName);
+
+  virtual NextHopType * FindRoute (Ptr<const ccnx::CCNxName> name, uint64_t digest);
+
+  virtual void GetRoutes (std::vector<RouteType> &routes) const;
+
+  virtual size_t GetSize (void) const;
+
+  virtual size_t GetMemoryUsage (void) const;
+
+  /**
+   * Counts a probe for each slot of the edge index examined
+   */
+  virtual AcmeFlatOperationCounts GetOperations (void) const;
+
+  /**
+   * @return The number of trie nodes in use (including the root)
+   */
+  size_t GetNodeCount (void) const;
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  static const uint32_t _none = 0xFFFFFFFF;
+  static const uint32_t _root = 0;
+
+  typedef struct
+  {
+    uint32_t parent;
+    uint32_t firstChild;
+    uint32_t nextSibling;
+    uint32_t prevSibling;
+    uint32_t labelStart;        //< first segment of the edge label in m_labels
+    uint32_t labelLength;       //< 0 only for the root
+    uint64_t labelDigest;       //< AcmeFlatNameDigest::ComputeSegment of the first label segment
+    NextHopType nextHop;
+    Ptr<const ccnx::CCNxName> routeName;  //< the full name of the route, for GetRoutes
+    bool hasRoute;
+    bool inUse;                 //< false while the node is on m_freeNodes
+  } NodeType;
+
+  /**
+   * @return The child of `parent` whose edge label begins with `segment`, or _none
+   */
+  uint32_t FindChild (uint32_t parent, const ccnx::CCNxNameSegment &segment, uint64_t segmentDigest) const;
+
+  /**
+   * Walks the trie along `name`.
+   *
+   * @param [in] exact If true, return the node for exactly `name`; otherwise the deepest node with a route
+   * @return The node index, or _none
+   */
+  uint32_t Walk (const ccnx::CCNxName &name, bool exact) const;
+
+  /**
+   * @return The index of an unlinked node with the given label and no route
+   */
+  uint32_t AllocateNode (uint32_t labelStart, uint32_t labelLength);
+
+  void FreeNode (uint32_t index);
+
+  void LinkChild (uint32_t parent, uint32_t child);
+
+  void UnlinkChild (uint32_t child);
+
+  /**
+   * Removes `index` if it no longer leads to a route, or collapses it into its
+   * only child.  Repeats up the tree.
+   */
+  void Prune (uint32_t index);
+
+  /**
+   * Gives `index` the new label [labelStart, labelStart + labelLength).  The node must be unlinked.
+   */
+  void SetLabel (uint32_t index, uint32_t labelStart, uint32_t labelLength);
+
+  /**
+   * Rewrites m_labels keeping only the ranges referenced by live nodes
+   */
+  void CompactLabels (void);
+
+  /**
+   * Compares two segments, counting it in m_operations
+   */
+  bool SegmentEquals (const ccnx::CCNxNameSegment &a, const ccnx::CCNxNameSegment &b) const;
+
+  static uint64_t EdgeKey (uint32_t parent, uint64_t segmentDigest);
+
+  std::vector<NodeType> m_nodes;
+
+  /**
+   * Free list of node indices in m_nodes
+   */
+  std::vector<uint32_t> m_freeNodes;
+
+  /**
+   * The segment pool holding every edge label
+   */
+  std::vector<Ptr<const ccnx::CCNxNameSegment> > m_labels;
+
+  /**
+   * The number of segments in m_labels no longer referenced by a node
+   */
+  size_t m_labelGarbage;
+
+  /**
+   * (parent, first segment digest) -> child node index
+   */
+  AcmeFlatDigestIndex m_edges;
+
+  size_t m_routeCount;
+};
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATTRIEFIB_H
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "acme-flat-work-item.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+AcmeFlatWorkItem::AcmeFlatWorkItem ()
+  : m_routeError (CCNxRoutingError::CCNxRoutingError_NoError), m_nameDigest (0), m_core (0)
+{
+  // empty
+}
+
+void
+AcmeFlatWorkItem::Reset (Ptr<CCNxPacket> packet, Ptr<CCNxConnection> ingress, Ptr<CCNxConnection> egress,
+                         Time arrivalTime)
+{
+  m_packet = packet;
+  m_ingress = ingress;
+  m_egress = egress;
+  m_routeError = CCNxRoutingError::CCNxRoutingError_NoError;
+  m_arrivalTime = arrivalTime;
+  m_nameDigest = 0;
+  m_core = 0;
+  m_routedPacket = 0;
+  m_connections = 0;
+}
+
+void
+AcmeFlatWorkItem::Clear (void)
+{
+  m_packet = 0;
+  m_ingress = 0;
+  m_egress = 0;
+  m_routedPacket = 0;
+  m_connections = 0;
+}
+
+Ptr<CCNxPacket>
+AcmeFlatWorkItem::GetPacket (void) const
+{
+  return m_packet;
+}
+
+Ptr<CCNxConnection>
+AcmeFlatWorkItem::GetIngressConnection (void) const
+{
+  return m_ingress;
+}
+
+Ptr<CCNxConnection>
+AcmeFlatWorkItem::GetEgressConnection (void) const
+{
+  return m_egress;
+}
+
+void
+AcmeFlatWorkItem::SetRouteError (CCNxRoutingError::RoutingErrorType routeError)
+{
+  m_routeError = routeError;
+}
+
+CCNxRoutingError::RoutingErrorType
+AcmeFlatWorkItem::GetRouteError (void) const
+{
+  return m_routeError;
+}
+
+Time
+AcmeFlatWorkItem::GetArrivalTime (void) const
+{
+  return m_arrivalTime;
+}
+
+void
+AcmeFlatWorkItem::SetNameDigest (uint64_t digest)
+{
+  m_nameDigest = digest;
+}
+
+uint64_t
+AcmeFlatWorkItem::GetNameDigest (void) const
+{
+  return m_nameDigest;
+}
+
+void
+AcmeFlatWorkItem::SetCore (uint32_t core)
+{
+  m_core = core;
+}
+
+uint32_t
+AcmeFlatWorkItem::GetCore (void) const
+{
+  return m_core;
+}
+
+void
+AcmeFlatWorkItem::SetRoutedPacket (Ptr<CCNxPacket> packet)
+{
+  m_routedPacket = packet;
+}
+
+Ptr<CCNxPacket>
+AcmeFlatWorkItem::GetRoutedPacket (void) const
+{
+  return m_routedPacket;
+}
+
+void
+AcmeFlatWorkItem::SetConnectionsList (Ptr<CCNxConnectionList> connections)
+{
+  m_connections = connections;
+}
+
+Ptr<CCNxConnectionList>
+AcmeFlatWorkItem::GetConnectionsList (void) const
+{
+  return m_connections;
+}
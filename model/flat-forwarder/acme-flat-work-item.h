@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_ACMEFLATWORKITEM_H
+#define CCNS3SIM_ACMEFLATWORKITEM_H
+
+#include "ns3/simple-ref-count.h"
+#include "ns3/ccnx-packet.h"
+#include "ns3/ccnx-connection.h"
+#include "ns3/ccnx-standard-forwarder-work-item.h"
+#include "ns3/nstime.h"
+
+namespace ns3 {
+namespace acme {
+
+/**
+ * @ingroup flat-forwarder
+ *
+ * A packet waiting in the input queue of `AcmeFlatForwarder`.  It carries the
+ * same state as `CCNxStandardForwarderWorkItem`, but can be reset so the
+ * forwarder recycles work items through a free list instead of allocating one
+ * per packet.
+ */
+class AcmeFlatWorkItem : public SimpleRefCount<AcmeFlatWorkItem>
+{
+public:
+  AcmeFlatWorkItem ();
+
+  /**
+   * Sets the packet and connections of a new (or recycled) work item and clears its route error.
+   *
+   * @param [in] packet The packet to route
+   * @param [in] ingress The connection the packet arrived on
+   * @param [in] egress The connection the user asked to send on, or null
+   * @param [in] arrivalTime The time the packet entered the input queue
+   */
+  void Reset (Ptr<ccnx::CCNxPacket> packet, Ptr<ccnx::CCNxConnection> ingress, Ptr<ccnx::CCNxConnection> egress,
+              Time arrivalTime);
+
+  /**
+   * Drops the references to the packet and connections, so a free work item
+   * does not keep them alive
+   */
+  void Clear (void);
+
+  Ptr<ccnx::CCNxPacket> GetPacket (void) const;
+  Ptr<ccnx::CCNxConnection> GetIngressConnection (void) const;
+  Ptr<ccnx::CCNxConnection> GetEgressConnection (void) const;
+
+  void SetRouteError (ccnx::CCNxRoutingError::RoutingErrorType routeError);
+  ccnx::CCNxRoutingError::RoutingErrorType GetRouteError (void) const;
+
+  Time GetArrivalTime (void) const;
+
+  /**
+   * Keeps the AcmeFlatNameDigest of the packet's name if it was computed before
+   * the item was queued.  Reset sets it to 0 (not computed).
+   */
+  void SetNameDigest (uint64_t digest);
+  uint64_t GetNameDigest (void) const;
+
+  /**
+   * The core whose input queue holds the item, when the forwarder has per-core queues
+   */
+  void SetCore (uint32_t core);
+  uint32_t GetCore (void) const;
+
+  /**
+   * Keeps the outcome of routing the item when the forwarder routes it before
+   * its service time is up (see "ProbeDelay" in `AcmeFlatForwarder`): the packet
+   * to send and its egress connections.  Reset and Clear drop them; a null
+   * connection list means the item has not been routed.
+   */
+  void SetRoutedPacket (Ptr<ccnx::CCNxPacket> packet);
+  Ptr<ccnx::CCNxPacket> GetRoutedPacket (void) const;
+
+  void SetConnectionsList (Ptr<ccnx::CCNxConnectionList> connections);
+  Ptr<ccnx::CCNxConnectionList> GetConnectionsList (void) const;
+
+private:
+  Ptr<ccnx::CCNxPacket> m_packet;
+  Ptr<ccnx::CCNxConnection> m_ingress;
+  Ptr<ccnx::CCNxConnection> m_egress;
+  ccnx::CCNxRoutingError::RoutingErrorType m_routeError;
+  Time m_arrivalTime;
+  uint64_t m_nameDigest;
+  uint32_t m_core;
+  Ptr<ccnx::CCNxPacket> m_routedPacket;
+  Ptr<ccnx::CCNxConnectionList> m_connections;
+};
+
+}
+}
+
+#endif //CCNS3SIM_ACMEFLATWORKITEM_H
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/acme-flat-batch-queue.h"
+
+#include "../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+
+namespace TestSuiteAcmeFlatBatchQueue {
+
+static std::vector<size_t> _batchSizes;
+static std::vector<Time> _dequeueTimes;
+
+/**
+ * 10 usec per batch plus 1 usec per item
+ */
+static Time
+ServiceTime (const AcmeFlatBatchQueue::BatchType &batch)
+{
+  _batchSizes.push_back (batch.size ());
+  return MicroSeconds (10 + batch.size ());
+}
+
+static void
+Dequeue (Ptr<AcmeFlatWorkItem> item)
+{
+  _dequeueTimes.push_back (Simulator::Now ());
+}
+
+static std::vector<Time> _dequeueArrivals;
+static std::vector<AcmeFlatBatchQueue::DropPolicyType> _drops;
+
+static void
+DequeueArrival (Ptr<AcmeFlatWorkItem> item)
+{
+  _dequeueArrivals.push_back (item->GetArrivalTime ());
+}
+
+static void
+Drop (Ptr<AcmeFlatWorkItem> item, AcmeFlatBatchQueue::DropPolicyType policy)
+{
+  _drops.push_back (policy);
+}
+
+static void
+EnqueueMany (Ptr<AcmeFlatBatchQueue> queue, unsigned count)
+{
+  for (unsigned i = 0; i < count; ++i)
+    {
+      queue->Enqueue (Create<AcmeFlatWorkItem> ());
+    }
+}
+
+/**
+ * Enqueues `count` items whose arrival times are 0, 1, 2, ... usec, to tell them apart
+ */
+static void
+EnqueueNumbered (Ptr<AcmeFlatBatchQueue> queue, unsigned count)
+{
+  for (unsigned i = 0; i < count; ++i)
+    {
+      Ptr<AcmeFlatWorkItem> item = Create<AcmeFlatWorkItem> ();
+      item->Reset (Ptr<ccnx::CCNxPacket> (), Ptr<ccnx::CCNxConnection> (), Ptr<ccnx::CCNxConnection> (), MicroSeconds (i));
+      queue->Enqueue (item);
+    }
+}
+
+BeginTest (Enqueue_Batches)
+{
+  _batchSizes.clear ();
+  _dequeueTimes.clear ();
+  Ptr<AcmeFlatBatchQueue> queue = Create<AcmeFlatBatchQueue> (1, 4, MakeCallback (&ServiceTime), MakeCallback (&Dequeue));
+
+  // The first item starts a batch of its own; the rest wait for the server
+  Simulator::Schedule (Seconds (0), &EnqueueMany, queue, 10);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (_batchSizes.size (), 4, "Wrong number of batches");
+  NS_TEST_EXPECT_MSG_EQ (_batchSizes[0], 1, "The first batch should not wait to fill");
+  NS_TEST_EXPECT_MSG_EQ (_batchSizes[1], 4, "Batch should be full");
+  NS_TEST_EXPECT_MSG_EQ (_batchSizes[2], 4, "Batch should be full");
+  NS_TEST_EXPECT_MSG_EQ (_batchSizes[3], 1, "Last batch should take the remainder");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetBatches (), 4, "Wrong batch count");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetBatchedItems (), 10, "Wrong item count");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetSize (), 0, "Queue should be empty");
+
+  // Batches end at 11, 11 + 14, 25 + 14 and 39 + 11 usec
+  NS_TEST_EXPECT_MSG_EQ (_dequeueTimes.size (), 10, "Every item should be dequeued");
+  NS_TEST_EXPECT_MSG_EQ (_dequeueTimes[0], MicroSeconds (11), "Wrong dequeue time");
+  NS_TEST_EXPECT_MSG_EQ (_dequeueTimes[4], MicroSeconds (25), "Items of a batch leave together");
+  NS_TEST_EXPECT_MSG_EQ (_dequeueTimes[8], MicroSeconds (39), "Wrong dequeue time");
+  NS_TEST_EXPECT_MSG_EQ (_dequeueTimes[9], MicroSeconds (50), "Wrong dequeue time");
+}
+EndTest ()
+
+BeginTest (Enqueue_Servers)
+{
+  _batchSizes.clear ();
+  _dequeueTimes.clear ();
+  Ptr<AcmeFlatBatchQueue> queue = Create<AcmeFlatBatchQueue> (2, 8, MakeCallback (&ServiceTime), MakeCallback (&Dequeue));
+
+  // Two servers take the first two items as two batches, the next 6 go together
+  Simulator::Schedule (Seconds (0), &EnqueueMany, queue, 8);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (_batchSizes.size (), 3, "Wrong number of batches");
+  NS_TEST_EXPECT_MSG_EQ (_batchSizes[2], 6, "The waiting items should form one batch");
+  NS_TEST_EXPECT_MSG_EQ (_dequeueTimes[7], MicroSeconds (27), "Wrong dequeue time");
+}
+EndTest ()
+
+BeginTest (SetLimit_TailDrop)
+{
+  _dequeueArrivals.clear ();
+  _drops.clear ();
+  Ptr<AcmeFlatBatchQueue> queue = Create<AcmeFlatBatchQueue> (1, 1, MakeCallback (&ServiceTime), MakeCallback (&DequeueArrival));
+  queue->SetLimit (3, AcmeFlatBatchQueue::TAIL_DROP, MakeCallback (&Drop));
+
+  // Item 0 goes to the server, 1 to 3 wait and the rest find the queue full
+  Simulator::Schedule (Seconds (0), &EnqueueNumbered, queue, 10);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (queue->GetDrops (), 6, "Wrong drop count");
+  NS_TEST_EXPECT_MSG_EQ (_drops.size (), 6, "Every drop should be reported");
+  NS_TEST_EXPECT_MSG_EQ (_drops[0], AcmeFlatBatchQueue::TAIL_DROP, "Wrong drop policy");
+  NS_TEST_EXPECT_MSG_EQ (_dequeueArrivals.size (), 4, "Wrong dequeue count");
+  NS_TEST_EXPECT_MSG_EQ (_dequeueArrivals[3], MicroSeconds (3), "The newest items should be dropped");
+}
+EndTest ()
+
+BeginTest (SetLimit_HeadDrop)
+{
+  _dequeueArrivals.clear ();
+  _drops.clear ();
+  Ptr<AcmeFlatBatchQueue> queue = Create<AcmeFlatBatchQueue> (1, 1, MakeCallback (&ServiceTime), MakeCallback (&DequeueArrival));
+  queue->SetLimit (3, AcmeFlatBatchQueue::HEAD_DROP, MakeCallback (&Drop));
+
+  Simulator::Schedule (Seconds (0), &EnqueueNumbered, queue, 10);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (queue->GetDrops (), 6, "Wrong drop count");
+  NS_TEST_EXPECT_MSG_EQ (_drops[0], AcmeFlatBatchQueue::HEAD_DROP, "Wrong drop policy");
+  NS_TEST_EXPECT_MSG_EQ (_dequeueArrivals.size (), 4, "Wrong dequeue count");
+  NS_TEST_EXPECT_MSG_EQ (_dequeueArrivals[0], MicroSeconds (0), "The item in service should stay");
+  NS_TEST_EXPECT_MSG_EQ (_dequeueArrivals[1], MicroSeconds (7), "The oldest waiting items should be dropped");
+  NS_TEST_EXPECT_MSG_EQ (_dequeueArrivals[3], MicroSeconds (9), "Wrong last item");
+}
+EndTest ()
+
+BeginTest (SetLimit_CoDel)
+{
+  _dequeueArrivals.clear ();
+  _drops.clear ();
+  Ptr<AcmeFlatBatchQueue> queue = Create<AcmeFlatBatchQueue> (1, 1, MakeCallback (&ServiceTime), MakeCallback (&DequeueArrival));
+  queue->SetLimit (0, AcmeFlatBatchQueue::CODEL, MakeCallback (&Drop));
+  queue->SetCoDel (MicroSeconds (20), MicroSeconds (100));
+
+  // 11 usec per item: the sojourn time passes the target with the third item,
+  // and CoDel waits an interval before it starts dropping
+  Simulator::Schedule (Seconds (0), &EnqueueMany, queue, 100);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_GT (queue->GetDrops (), 0, "A standing queue should be dropped from");
+  NS_TEST_EXPECT_MSG_LT (queue->GetDrops (), 90, "CoDel should not drop everything");
+  NS_TEST_EXPECT_MSG_EQ (_dequeueArrivals.size () + _drops.size (), 100, "Every item is dequeued or dropped");
+  NS_TEST_EXPECT_MSG_GT (_dequeueArrivals.size (), 10, "The items before the first interval should be served");
+  NS_TEST_EXPECT_MSG_EQ (_drops[0], AcmeFlatBatchQueue::CODEL, "Wrong drop policy");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for AcmeFlatBatchQueue
+ */
+static class TestSuiteAcmeFlatBatchQueue : public TestSuite
+{
+public:
+  TestSuiteAcmeFlatBatchQueue () : TestSuite ("acme-flat-batch-queue", UNIT)
+  {
+    AddTestCase (new Enqueue_Batches (), TestCase::QUICK);
+    AddTestCase (new Enqueue_Servers (), TestCase::QUICK);
+    AddTestCase (new SetLimit_TailDrop (), TestCase::QUICK);
+    AddTestCase (new SetLimit_HeadDrop (), TestCase::QUICK);
+    AddTestCase (new SetLimit_CoDel (), TestCase::QUICK);
+  }
+} g_TestSuiteAcmeFlatBatchQueue;
+
+} // namespace TestSuiteAcmeFlatBatchQueue
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <stdio.h>
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/acme-flat-bloom-filter.h"
+#include "ns3/acme-flat-name-digest.h"
+
+#include "../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+namespace TestSuiteAcmeFlatBloomFilter {
+
+static uint64_t
+MakeDigest (const char *prefix, unsigned i)
+{
+  char buffer[64];
+  sprintf (buffer, "ccnx:/name=%s/name=%u", prefix, i);
+  return AcmeFlatNameDigest::Compute (CCNxName (buffer));
+}
+
+BeginTest (Constructor)
+{
+  AcmeFlatBloomFilter filter (1000, 8);
+  NS_TEST_EXPECT_MSG_EQ (filter.GetCount (), 0, "Wrong count");
+  NS_TEST_EXPECT_MSG_EQ (filter.GetCapacity (), 1000, "Wrong capacity");
+  NS_TEST_EXPECT_MSG_EQ (filter.GetHashCount (), 5, "Wrong hash count");
+  NS_TEST_EXPECT_MSG_EQ (filter.GetMemoryUsage (), 8000, "Wrong memory usage");
+  NS_TEST_EXPECT_MSG_EQ (filter.MayContain (MakeDigest ("route", 0)), false, "An empty filter should contain nothing");
+}
+EndTest ()
+
+BeginTest (Add_MayContain)
+{
+  AcmeFlatBloomFilter filter (1000, 8);
+  for (unsigned i = 0; i < 1000; ++i)
+    {
+      filter.Add (MakeDigest ("route", i));
+    }
+  NS_TEST_EXPECT_MSG_EQ (filter.GetCount (), 1000, "Wrong count");
+
+  for (unsigned i = 0; i < 1000; ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (filter.MayContain (MakeDigest ("route", i)), true, "No false negatives, name " << i);
+    }
+
+  unsigned passed = 0;
+  for (unsigned i = 0; i < 10000; ++i)
+    {
+      passed += filter.MayContain (MakeDigest ("other", i));
+    }
+  NS_TEST_EXPECT_MSG_LT (passed, 500, "Too many false positives");
+}
+EndTest ()
+
+BeginTest (Remove)
+{
+  AcmeFlatBloomFilter filter (100, 8);
+  for (unsigned i = 0; i < 100; ++i)
+    {
+      filter.Add (MakeDigest ("route", i));
+    }
+  for (unsigned i = 0; i < 100; i += 2)
+    {
+      filter.Remove (MakeDigest ("route", i));
+    }
+  NS_TEST_EXPECT_MSG_EQ (filter.GetCount (), 50, "Wrong count");
+
+  unsigned removedPassed = 0;
+  for (unsigned i = 0; i < 100; ++i)
+    {
+      bool present = filter.MayContain (MakeDigest ("route", i));
+      if (i % 2)
+        {
+          NS_TEST_EXPECT_MSG_EQ (present, true, "Removing others should not remove name " << i);
+        }
+      else
+        {
+          removedPassed += present;
+        }
+    }
+  NS_TEST_EXPECT_MSG_LT (removedPassed, 10, "Removed names should mostly be gone");
+
+  for (unsigned i = 1; i < 100; i += 2)
+    {
+      filter.Remove (MakeDigest ("route", i));
+    }
+  for (unsigned i = 0; i < 100; ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (filter.MayContain (MakeDigest ("route", i)), false, "An emptied filter should contain nothing");
+    }
+}
+EndTest ()
+
+BeginTest (Add_Saturates)
+{
+  AcmeFlatBloomFilter filter (10, 8);
+  uint64_t digest = MakeDigest ("route", 0);
+  for (unsigned i = 0; i < 300; ++i)
+    {
+      filter.Add (digest);
+    }
+  for (unsigned i = 0; i < 299; ++i)
+    {
+      filter.Remove (digest);
+    }
+  NS_TEST_EXPECT_MSG_EQ (filter.MayContain (digest), true, "A saturated counter should not wrap or drain");
+  NS_TEST_EXPECT_MSG_EQ (filter.GetCount (), 1, "Wrong count");
+}
+EndTest ()
+
+BeginTest (ComputePrefixes)
+{
+  CCNxName name ("ccnx:/name=a/name=b/name=c");
+  std::vector<uint64_t> digests;
+  AcmeFlatNameDigest::ComputePrefixes (name, digests);
+  NS_TEST_EXPECT_MSG_EQ (digests.size (), 4, "Wrong prefix count");
+  NS_TEST_EXPECT_MSG_NE (digests[0], digests[1], "The empty prefix should have its own digest");
+  NS_TEST_EXPECT_MSG_EQ (digests[1], AcmeFlatNameDigest::Compute (CCNxName ("ccnx:/name=a")), "Wrong prefix 1");
+  NS_TEST_EXPECT_MSG_EQ (digests[2], AcmeFlatNameDigest::Compute (CCNxName ("ccnx:/name=a/name=b")), "Wrong prefix 2");
+  NS_TEST_EXPECT_MSG_EQ (digests[3], AcmeFlatNameDigest::Compute (name), "Wrong full name");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for AcmeFlatBloomFilter
+ */
+static class TestSuiteAcmeFlatBloomFilter : public TestSuite
+{
+public:
+  TestSuiteAcmeFlatBloomFilter () : TestSuite ("acme-flat-bloom-filter", UNIT)
+  {
+    AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new Add_MayContain (), TestCase::QUICK);
+    AddTestCase (new Remove (), TestCase::QUICK);
+    AddTestCase (new Add_Saturates (), TestCase::QUICK);
+    AddTestCase (new ComputePrefixes (), TestCase::QUICK);
+  }
+} g_TestSuiteAcmeFlatBloomFilter;
+
+} // namespace TestSuiteAcmeFlatBloomFilter
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "ns3/test.h"
+#include "ns3/ccnx-content-object.h"
+#include "ns3/acme-flat-congestion-marks.h"
+
+#include "../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+namespace TestSuiteAcmeFlatCongestionMarks {
+
+static Ptr<CCNxPacket>
+CreateContentObject (std::string uri)
+{
+  Ptr<CCNxContentObject> object = Create<CCNxContentObject> (Create<CCNxName> (uri));
+  return CCNxPacket::CreateFromMessage (object);
+}
+
+BeginTest (Constructor)
+{
+  Ptr<AcmeFlatCongestionMarks> marks = CreateObject<AcmeFlatCongestionMarks> ();
+  NS_TEST_EXPECT_MSG_EQ (marks->GetSize (), 0, "Should have no marks");
+  NS_TEST_EXPECT_MSG_EQ (marks->IsMarked (CreateContentObject ("ccnx:/name=a"), Seconds (0)), false, "Nothing should be marked");
+}
+EndTest ()
+
+BeginTest (Mark_IsMarked)
+{
+  Ptr<AcmeFlatCongestionMarks> marks = CreateObject<AcmeFlatCongestionMarks> ();
+  Ptr<CCNxPacket> a = CreateContentObject ("ccnx:/name=a");
+  Ptr<CCNxPacket> b = CreateContentObject ("ccnx:/name=b");
+  marks->Mark (a, Seconds (0));
+  marks->Mark (b, Seconds (0));
+  NS_TEST_EXPECT_MSG_EQ (marks->IsMarked (a, MilliSeconds (10)), true, "Packet should be marked");
+  NS_TEST_EXPECT_MSG_EQ (marks->IsMarked (b, MilliSeconds (10)), true, "Packet should be marked");
+  NS_TEST_EXPECT_MSG_EQ (marks->GetSize (), 2, "Wrong size");
+  NS_TEST_EXPECT_MSG_EQ (marks->GetMarks (), 2, "Wrong mark count");
+
+  // Another copy of a marked Content Object, as on another path, is not marked
+  Ptr<CCNxPacket> copy = CreateContentObject ("ccnx:/name=a");
+  NS_TEST_EXPECT_MSG_EQ (marks->IsMarked (copy, MilliSeconds (10)), false, "Other packets of the name should not be marked");
+}
+EndTest ()
+
+BeginTest (Unmark)
+{
+  Ptr<AcmeFlatCongestionMarks> marks = CreateObject<AcmeFlatCongestionMarks> ();
+  Ptr<CCNxPacket> a = CreateContentObject ("ccnx:/name=a");
+  marks->Unmark (a);
+  marks->Mark (a, Seconds (0));
+  marks->Unmark (a);
+  NS_TEST_EXPECT_MSG_EQ (marks->IsMarked (a, MilliSeconds (10)), false, "Packet should be unmarked");
+  NS_TEST_EXPECT_MSG_EQ (marks->GetSize (), 0, "Should have no marks");
+
+  // The mark made before the unmark does not expire the new one
+  marks->SetAttribute ("MarkLifetime", TimeValue (MilliSeconds (100)));
+  marks->Mark (a, MilliSeconds (50));
+  NS_TEST_EXPECT_MSG_EQ (marks->IsMarked (a, MilliSeconds (120)), true, "New mark should still be live");
+  NS_TEST_EXPECT_MSG_EQ (marks->IsMarked (a, MilliSeconds (150)), false, "New mark should have expired");
+}
+EndTest ()
+
+BeginTest (Mark_Expire)
+{
+  Ptr<AcmeFlatCongestionMarks> marks = CreateObject<AcmeFlatCongestionMarks> ();
+  marks->SetAttribute ("MarkLifetime", TimeValue (MilliSeconds (100)));
+  Ptr<CCNxPacket> a = CreateContentObject ("ccnx:/name=a");
+  Ptr<CCNxPacket> b = CreateContentObject ("ccnx:/name=b");
+
+  marks->Mark (a, Seconds (0));
+  marks->Mark (b, MilliSeconds (50));
+  NS_TEST_EXPECT_MSG_EQ (marks->IsMarked (a, MilliSeconds (99)), true, "Mark should still be live");
+  NS_TEST_EXPECT_MSG_EQ (marks->IsMarked (a, MilliSeconds (100)), false, "Mark should have expired");
+  NS_TEST_EXPECT_MSG_EQ (marks->IsMarked (b, MilliSeconds (100)), true, "Later mark should still be live");
+  NS_TEST_EXPECT_MSG_EQ (marks->GetSize (), 1, "Expired mark should be removed");
+
+  // Marking again extends the mark
+  marks->Mark (b, MilliSeconds (120));
+  NS_TEST_EXPECT_MSG_EQ (marks->IsMarked (b, MilliSeconds (200)), true, "Second mark should still be live");
+  NS_TEST_EXPECT_MSG_EQ (marks->IsMarked (b, MilliSeconds (220)), false, "Second mark should have expired");
+  NS_TEST_EXPECT_MSG_EQ (marks->GetSize (), 0, "Should have no marks");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for AcmeFlatCongestionMarks
+ */
+static class TestSuiteAcmeFlatCongestionMarks : public TestSuite
+{
+public:
+  TestSuiteAcmeFlatCongestionMarks () : TestSuite ("acme-flat-congestion-marks", UNIT)
+  {
+    AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new Mark_IsMarked (), TestCase::QUICK);
+    AddTestCase (new Unmark (), TestCase::QUICK);
+    AddTestCase (new Mark_Expire (), TestCase::QUICK);
+  }
+} g_TestSuiteAcmeFlatCongestionMarks;
+
+} // namespace TestSuiteAcmeFlatCongestionMarks
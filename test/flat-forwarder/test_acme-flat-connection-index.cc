@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <cstdio>
+
+#include "ns3/test.h"
+#include "ns3/acme-flat-connection-index.h"
+#include "ns3/acme-flat-name-digest.h"
+
+#include "../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+namespace TestSuiteAcmeFlatConnectionIndex {
+
+static Ptr<const CCNxName>
+MakeName (unsigned index)
+{
+  char buffer[64];
+  snprintf (buffer, sizeof(buffer), "ccnx:/name=acm/name=icn/name=%06u", index);
+  return Create<CCNxName> (buffer);
+}
+
+BeginTest (Constructor)
+{
+  AcmeFlatConnectionIndex index;
+  NS_TEST_EXPECT_MSG_EQ (index.GetSize (), 0, "New index should be empty");
+  NS_TEST_EXPECT_MSG_EQ (index.GetConnectionCount (), 0, "New index should have no connections");
+}
+EndTest ()
+
+BeginTest (Add_Remove)
+{
+  AcmeFlatConnectionIndex index;
+  Ptr<const CCNxName> name = MakeName (1);
+  uint64_t digest = AcmeFlatNameDigest::Compute (*name);
+
+  NS_TEST_EXPECT_MSG_EQ (index.Add (1, name, digest), true, "Add failed");
+  NS_TEST_EXPECT_MSG_EQ (index.Add (1, name, digest), false, "Duplicate add should fail");
+  NS_TEST_EXPECT_MSG_EQ (index.Add (2, name, digest), true, "The same name on another connection should add");
+  NS_TEST_EXPECT_MSG_EQ (index.GetSize (), 2, "Wrong size");
+
+  NS_TEST_EXPECT_MSG_EQ (index.Remove (3, *name, digest), false, "Remove from the wrong connection should fail");
+  NS_TEST_EXPECT_MSG_EQ (index.Remove (1, *name, digest), true, "Remove failed");
+  NS_TEST_EXPECT_MSG_EQ (index.GetCount (1), 0, "Connection 1 should be empty");
+  NS_TEST_EXPECT_MSG_EQ (index.GetCount (2), 1, "Connection 2 should keep its name");
+  NS_TEST_EXPECT_MSG_EQ (index.GetConnectionCount (), 1, "Empty connections should be dropped");
+}
+EndTest ()
+
+BeginTest (Take_OnlyThatConnection)
+{
+  AcmeFlatConnectionIndex index;
+  const unsigned count = 1000;
+  for (unsigned i = 0; i < count; ++i)
+    {
+      Ptr<const CCNxName> name = MakeName (i);
+      index.Add (i % 4, name, AcmeFlatNameDigest::Compute (*name));
+    }
+
+  // Remove a few from the middle of connection 2's list first
+  for (unsigned i = 2; i < 40; i += 4)
+    {
+      Ptr<const CCNxName> name = MakeName (i);
+      NS_TEST_EXPECT_MSG_EQ (index.Remove (2, *name, AcmeFlatNameDigest::Compute (*name)), true, "Remove failed " << i);
+    }
+
+  std::vector<AcmeFlatFib::BulkRouteType> routes;
+  NS_TEST_EXPECT_MSG_EQ (index.Take (2, routes), count / 4 - 10, "Wrong number of names taken");
+  NS_TEST_EXPECT_MSG_EQ (routes.size (), count / 4 - 10, "Wrong number of routes returned");
+  for (size_t i = 0; i < routes.size (); ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (routes[i].connId, 2, "Wrong connection id");
+      NS_TEST_EXPECT_MSG_EQ (routes[i].digest, AcmeFlatNameDigest::Compute (*routes[i].name), "Wrong digest");
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (index.GetCount (2), 0, "Connection 2 should be empty");
+  NS_TEST_EXPECT_MSG_EQ (index.GetSize (), count - count / 4, "Other connections should be untouched");
+
+  // The freed entries are reused
+  Ptr<const CCNxName> name = MakeName (2);
+  NS_TEST_EXPECT_MSG_EQ (index.Add (2, name, AcmeFlatNameDigest::Compute (*name)), true, "Add after Take failed");
+  NS_TEST_EXPECT_MSG_EQ (index.Remove (2, *name, AcmeFlatNameDigest::Compute (*name)), true, "Remove after Take failed");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for AcmeFlatConnectionIndex
+ */
+static class TestSuiteAcmeFlatConnectionIndex : public TestSuite
+{
+public:
+  TestSuiteAcmeFlatConnectionIndex () : TestSuite ("acme-flat-connection-index", UNIT)
+  {
+    AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new Add_Remove (), TestCase::QUICK);
+    AddTestCase (new Take_OnlyThatConnection (), TestCase::QUICK);
+  }
+} g_TestSuiteAcmeFlatConnectionIndex;
+
+} // namespace TestSuiteAcmeFlatConnectionIndex
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+#include "ns3/enum.h"
+#include "ns3/ccnx-content-object.h"
+#include "ns3/acme-flat-content-store.h"
+#include "ns3/acme-flat-name-digest.h"
+
+#include "../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+namespace TestSuiteAcmeFlatContentStore {
+
+static Ptr<CCNxPacket>
+CreateObjectPacket (Ptr<const CCNxName> name)
+{
+  Ptr<CCNxContentObject> contentObject = Create<CCNxContentObject> (name);
+  return CCNxPacket::CreateFromMessage (contentObject);
+}
+
+BeginTest (Constructor)
+{
+  Ptr<AcmeFlatContentStore> cs = CreateObject<AcmeFlatContentStore> ();
+  NS_TEST_EXPECT_MSG_EQ (cs->IsEnabled (), false, "Default content store should be disabled");
+
+  Ptr<const CCNxName> name = Create<CCNxName> ("ccnx:/name=acm/name=icn");
+  uint64_t digest = AcmeFlatNameDigest::Compute (*name);
+  NS_TEST_EXPECT_MSG_EQ (cs->Add (name, digest, CreateObjectPacket (name)), false, "Disabled store should not cache");
+  NS_TEST_EXPECT_MSG_EQ (cs->GetCount (), 0, "Disabled store should be empty");
+}
+EndTest ()
+
+BeginTest (Lookup_Hit)
+{
+  Ptr<AcmeFlatContentStore> cs = CreateObject<AcmeFlatContentStore> ();
+  cs->SetAttribute ("ByteCapacity", UintegerValue (1000000));
+
+  Ptr<const CCNxName> name = Create<CCNxName> ("ccnx:/name=acm/name=icn");
+  uint64_t digest = AcmeFlatNameDigest::Compute (*name);
+  Ptr<CCNxPacket> packet = CreateObjectPacket (name);
+  NS_TEST_EXPECT_MSG_EQ (cs->Add (name, digest, packet), true, "Add should cache the object");
+
+  Ptr<const CCNxName> lookup = Create<CCNxName> ("ccnx:/name=acm/name=icn");
+  NS_TEST_EXPECT_MSG_EQ (cs->Lookup (*lookup, digest), packet, "Lookup should return the cached packet");
+
+  Ptr<const CCNxName> other = Create<CCNxName> ("ccnx:/name=acm/name=sigcomm");
+  NS_TEST_EXPECT_MSG_EQ (cs->Lookup (*other, AcmeFlatNameDigest::Compute (*other)), Ptr<CCNxPacket> (), "Lookup should miss");
+
+  NS_TEST_EXPECT_MSG_EQ (cs->GetHits (), 1, "Wrong hit count");
+  NS_TEST_EXPECT_MSG_EQ (cs->GetMisses (), 1, "Wrong miss count");
+  NS_TEST_EXPECT_MSG_EQ (cs->GetBytes (), packet->GetFixedHeader ()->GetPacketLength (), "Wrong byte count");
+}
+EndTest ()
+
+BeginTest (Add_EvictLru)
+{
+  Ptr<const CCNxName> a = Create<CCNxName> ("ccnx:/name=acm/name=a");
+  Ptr<const CCNxName> b = Create<CCNxName> ("ccnx:/name=acm/name=b");
+  Ptr<const CCNxName> c = Create<CCNxName> ("ccnx:/name=acm/name=c");
+  Ptr<CCNxPacket> packetA = CreateObjectPacket (a);
+  Ptr<CCNxPacket> packetB = CreateObjectPacket (b);
+  Ptr<CCNxPacket> packetC = CreateObjectPacket (c);
+
+  // room for exactly two of the three objects
+  uint64_t capacity = packetA->GetFixedHeader ()->GetPacketLength () + packetB->GetFixedHeader ()->GetPacketLength ();
+
+  Ptr<AcmeFlatContentStore> cs = CreateObject<AcmeFlatContentStore> ();
+  cs->SetAttribute ("ByteCapacity", UintegerValue (capacity));
+  cs->SetAttribute ("Policy", EnumValue (AcmeFlatContentStore::LRU));
+
+  cs->Add (a, AcmeFlatNameDigest::Compute (*a), packetA);
+  cs->Add (b, AcmeFlatNameDigest::Compute (*b), packetB);
+
+  // touch a, so b is the least recently used
+  NS_TEST_EXPECT_MSG_EQ (cs->Lookup (*a, AcmeFlatNameDigest::Compute (*a)), packetA, "a should be cached");
+  cs->Add (c, AcmeFlatNameDigest::Compute (*c), packetC);
+
+  NS_TEST_EXPECT_MSG_EQ (cs->GetEvictions (), 1, "Wrong eviction count");
+  NS_TEST_EXPECT_MSG_EQ (cs->GetCount (), 2, "Wrong object count");
+  NS_TEST_EXPECT_MSG_EQ ((cs->GetBytes () <= capacity), true, "Bytes exceed the capacity");
+  NS_TEST_EXPECT_MSG_EQ (cs->Lookup (*a, AcmeFlatNameDigest::Compute (*a)), packetA, "a should still be cached");
+  NS_TEST_EXPECT_MSG_EQ (cs->Lookup (*b, AcmeFlatNameDigest::Compute (*b)), Ptr<CCNxPacket> (), "b should be evicted");
+  NS_TEST_EXPECT_MSG_EQ (cs->Lookup (*c, AcmeFlatNameDigest::Compute (*c)), packetC, "c should be cached");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for AcmeFlatContentStore
+ */
+static class TestSuiteAcmeFlatContentStore : public TestSuite
+{
+public:
+  TestSuiteAcmeFlatContentStore () : TestSuite ("acme-flat-content-store", UNIT)
+  {
+    AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new Lookup_Hit (), TestCase::QUICK);
+    AddTestCase (new Add_EvictLru (), TestCase::QUICK);
+  }
+} g_TestSuiteAcmeFlatContentStore;
+
+} // namespace TestSuiteAcmeFlatContentStore
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/acme-flat-drr-queue.h"
+
+#include "../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+
+namespace TestSuiteAcmeFlatDrrQueue {
+
+/**
+ * Enqueues `count` items of `bytes` from `ingress`.  The arrival time of an
+ * item is its ingress in usec, to tell whose it is when it comes out.
+ */
+static void
+EnqueueMany (AcmeFlatDrrQueue &queue, ccnx::CCNxConnection::ConnIdType ingress, unsigned count, uint32_t bytes)
+{
+  for (unsigned i = 0; i < count; ++i)
+    {
+      Ptr<AcmeFlatWorkItem> item = Create<AcmeFlatWorkItem> ();
+      item->Reset (Ptr<ccnx::CCNxPacket> (), Ptr<ccnx::CCNxConnection> (), Ptr<ccnx::CCNxConnection> (), MicroSeconds (ingress));
+      queue.Enqueue (item, ingress, bytes);
+    }
+}
+
+/**
+ * @return The ingress of each item in dequeue order
+ */
+static std::vector<int64_t>
+DequeueAll (AcmeFlatDrrQueue &queue)
+{
+  std::vector<int64_t> order;
+  Ptr<AcmeFlatWorkItem> item;
+  while ((item = queue.Dequeue ()))
+    {
+      order.push_back (item->GetArrivalTime ().GetMicroSeconds ());
+    }
+  return order;
+}
+
+BeginTest (Constructor)
+{
+  AcmeFlatDrrQueue queue;
+  NS_TEST_EXPECT_MSG_EQ (queue.GetSize (), 0, "Queue should be empty");
+  NS_TEST_EXPECT_MSG_EQ (queue.GetActiveCount (), 0, "No sub-queue should be active");
+  NS_TEST_EXPECT_MSG_EQ (queue.GetWeight (7), 1, "Default weight should be 1");
+  NS_TEST_EXPECT_MSG_EQ (queue.Dequeue (), 0, "Empty queue should dequeue null");
+}
+EndTest ()
+
+BeginTest (Dequeue_RoundRobin)
+{
+  AcmeFlatDrrQueue queue (100);
+
+  // The heavy ingress arrives first but the light one does not wait behind it
+  EnqueueMany (queue, 1, 6, 100);
+  EnqueueMany (queue, 2, 2, 100);
+  NS_TEST_EXPECT_MSG_EQ (queue.GetSize (), 8, "Wrong size");
+  NS_TEST_EXPECT_MSG_EQ (queue.GetActiveCount (), 2, "Wrong active count");
+
+  std::vector<int64_t> order = DequeueAll (queue);
+  int64_t expected[] = { 1, 2, 1, 2, 1, 1, 1, 1 };
+  NS_TEST_EXPECT_MSG_EQ (order.size (), 8, "Every item should be dequeued");
+  for (size_t i = 0; i < order.size () && i < 8; ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (order[i], expected[i], "Wrong order at " << i);
+    }
+  NS_TEST_EXPECT_MSG_EQ (queue.GetActiveCount (), 0, "No sub-queue should be active");
+}
+EndTest ()
+
+BeginTest (Dequeue_Deficit)
+{
+  AcmeFlatDrrQueue queue (100);
+
+  // Ingress 1 sends 150 byte packets, so it skips its first visit and sends
+  // on the credit carried into the second; ingress 2 sends two 50 byte
+  // packets on each visit
+  EnqueueMany (queue, 1, 2, 150);
+  EnqueueMany (queue, 2, 4, 50);
+
+  std::vector<int64_t> order = DequeueAll (queue);
+  int64_t expected[] = { 2, 2, 1, 2, 2, 1 };
+  NS_TEST_EXPECT_MSG_EQ (order.size (), 6, "Every item should be dequeued");
+  for (size_t i = 0; i < order.size () && i < 6; ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (order[i], expected[i], "Wrong order at " << i);
+    }
+}
+EndTest ()
+
+BeginTest (SetWeight_Share)
+{
+  AcmeFlatDrrQueue queue (100);
+  queue.SetWeight (1, 2);
+  NS_TEST_EXPECT_MSG_EQ (queue.GetWeight (1), 2, "Wrong weight");
+
+  EnqueueMany (queue, 1, 6, 100);
+  EnqueueMany (queue, 2, 6, 100);
+
+  std::vector<int64_t> order = DequeueAll (queue);
+  int64_t expected[] = { 1, 1, 2, 1, 1, 2, 1, 1, 2, 2, 2, 2 };
+  NS_TEST_EXPECT_MSG_EQ (order.size (), 12, "Every item should be dequeued");
+  for (size_t i = 0; i < order.size () && i < 12; ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (order[i], expected[i], "Wrong order at " << i);
+    }
+}
+EndTest ()
+
+BeginTest (DropFromLongest)
+{
+  AcmeFlatDrrQueue queue (100);
+  EnqueueMany (queue, 1, 1, 100);
+  EnqueueMany (queue, 2, 3, 100);
+
+  Ptr<AcmeFlatWorkItem> dropped = queue.DropFromLongest ();
+  NS_TEST_EXPECT_MSG_NE (dropped, 0, "Should drop an item");
+  NS_TEST_EXPECT_MSG_EQ (dropped->GetArrivalTime (), MicroSeconds (2), "Should drop from the longest sub-queue");
+  NS_TEST_EXPECT_MSG_EQ (queue.GetSize (), 3, "Wrong size");
+
+  queue.DropFromLongest ();
+  queue.DropFromLongest ();
+  NS_TEST_EXPECT_MSG_EQ (queue.GetActiveCount (), 1, "Emptied sub-queue should leave the round");
+  queue.DropFromLongest ();
+  NS_TEST_EXPECT_MSG_EQ (queue.GetSize (), 0, "Queue should be empty");
+  NS_TEST_EXPECT_MSG_EQ (queue.DropFromLongest (), 0, "Empty queue should drop null");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for AcmeFlatDrrQueue
+ */
+static class TestSuiteAcmeFlatDrrQueue : public TestSuite
+{
+public:
+  TestSuiteAcmeFlatDrrQueue () : TestSuite ("acme-flat-drr-queue", UNIT)
+  {
+    AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new Dequeue_RoundRobin (), TestCase::QUICK);
+    AddTestCase (new Dequeue_Deficit (), TestCase::QUICK);
+    AddTestCase (new SetWeight_Share (), TestCase::QUICK);
+    AddTestCase (new DropFromLongest (), TestCase::QUICK);
+  }
+} g_TestSuiteAcmeFlatDrrQueue;
+
+} // namespace TestSuiteAcmeFlatDrrQueue
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <sstream>
+
+#include "ns3/test.h"
+#include "ns3/acme-flat-fib-writer.h"
+#include "ns3/acme-flat-trie-fib.h"
+#include "ns3/acme-flat-hash-fib.h"
+#include "ns3/acme-flat-name-digest.h"
+
+#include "../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+namespace TestSuiteAcmeFlatFibWriter {
+
+static void
+AddRoute (Ptr<AcmeFlatFib> fib, const char *uri, CCNxConnection::ConnIdType connId)
+{
+  Ptr<const CCNxName> name = Create<CCNxName> (uri);
+  fib->AddRoute (name, AcmeFlatNameDigest::Compute (*name), connId);
+}
+
+static void
+AddRoutes (Ptr<AcmeFlatFib> fib)
+{
+  AddRoute (fib, "ccnx:/name=b/name=2", 4);
+  AddRoute (fib, "ccnx:/name=a/name=b", 2);
+  AddRoute (fib, "ccnx:/name=c", 5);
+  AddRoute (fib, "ccnx:/name=a", 1);
+  AddRoute (fib, "ccnx:/name=b/name=1", 3);
+}
+
+BeginTest (Compare)
+{
+  CCNxName a ("ccnx:/name=a");
+  CCNxName ab ("ccnx:/name=a/name=b");
+  CCNxName b ("ccnx:/name=b");
+  NS_TEST_EXPECT_MSG_EQ (AcmeFlatFibWriter::Compare (a, a), 0, "Equal names should compare 0");
+  NS_TEST_EXPECT_MSG_LT (AcmeFlatFibWriter::Compare (a, ab), 0, "A prefix should sort first");
+  NS_TEST_EXPECT_MSG_LT (AcmeFlatFibWriter::Compare (ab, b), 0, "a/b should sort before b");
+  NS_TEST_EXPECT_MSG_EQ (AcmeFlatFibWriter::HasPrefix (ab, a), true, "a is a prefix of a/b");
+  NS_TEST_EXPECT_MSG_EQ (AcmeFlatFibWriter::HasPrefix (a, ab), false, "a/b is not a prefix of a");
+}
+EndTest ()
+
+BeginTest (Write_TextSorted)
+{
+  Ptr<AcmeFlatTrieFib> fib = CreateObject<AcmeFlatTrieFib> ();
+  AddRoutes (fib);
+
+  AcmeFlatFibWriter writer;
+  std::ostringstream os;
+  NS_TEST_EXPECT_MSG_EQ (writer.Write (*fib, os), 5, "Wrong number of routes written");
+  NS_TEST_EXPECT_MSG_EQ (os.str (),
+                         "1 ccnx:/name=a\n"
+                         "2 ccnx:/name=a/name=b\n"
+                         "3 ccnx:/name=b/name=1\n"
+                         "4 ccnx:/name=b/name=2\n"
+                         "5 ccnx:/name=c\n",
+                         "Wrong text dump");
+}
+EndTest ()
+
+BeginTest (Write_PrefixSample)
+{
+  Ptr<AcmeFlatHashFib> fib = CreateObject<AcmeFlatHashFib> ();
+  AddRoutes (fib);
+
+  AcmeFlatFibWriter writer;
+  writer.SetPrefix (Create<CCNxName> ("ccnx:/name=b"));
+  std::ostringstream prefixed;
+  NS_TEST_EXPECT_MSG_EQ (writer.Write (*fib, prefixed), 2, "Wrong number of routes under the prefix");
+  NS_TEST_EXPECT_MSG_EQ (prefixed.str (), "3 ccnx:/name=b/name=1\n4 ccnx:/name=b/name=2\n", "Wrong prefix dump");
+
+  writer.SetPrefix (0);
+  writer.SetSampleInterval (2);
+  std::ostringstream sampled;
+  NS_TEST_EXPECT_MSG_EQ (writer.Write (*fib, sampled), 3, "Wrong number of sampled routes");
+  NS_TEST_EXPECT_MSG_EQ (sampled.str (), "1 ccnx:/name=a\n3 ccnx:/name=b/name=1\n5 ccnx:/name=c\n", "Wrong sampled dump");
+
+  // A sampled multipath route keeps all of its next hops
+  Ptr<const CCNxName> a = Create<CCNxName> ("ccnx:/name=a");
+  fib->AddNextHop (a, AcmeFlatNameDigest::Compute (*a), 6, 0);
+  std::ostringstream multipath;
+  NS_TEST_EXPECT_MSG_EQ (writer.Write (*fib, multipath), 4, "Wrong number of sampled next hops");
+  NS_TEST_EXPECT_MSG_EQ (multipath.str (), "1 ccnx:/name=a\n6 ccnx:/name=a\n3 ccnx:/name=b/name=1\n5 ccnx:/name=c\n",
+                         "Wrong sampled multipath dump");
+}
+EndTest ()
+
+BeginTest (Write_Binary)
+{
+  Ptr<AcmeFlatTrieFib> fib = CreateObject<AcmeFlatTrieFib> ();
+  AddRoute (fib, "ccnx:/name=ab", 7);
+
+  AcmeFlatFibWriter writer;
+  writer.SetFormat (AcmeFlatFibWriter::BINARY);
+  std::ostringstream os;
+  writer.Write (*fib, os);
+
+  // header, one route with one segment, end marker and count
+  const char expected[] = "AFIB\0\1" "\0\1\0\0\0\7" "\0\1\0\2ab" "\xFF\xFF\0\0\0\1";
+  NS_TEST_EXPECT_MSG_EQ (os.str (), std::string (expected, sizeof (expected) - 1), "Wrong binary dump");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for AcmeFlatFibWriter
+ */
+static class TestSuiteAcmeFlatFibWriter : public TestSuite
+{
+public:
+  TestSuiteAcmeFlatFibWriter () : TestSuite ("acme-flat-fib-writer", UNIT)
+  {
+    AddTestCase (new Compare (), TestCase::QUICK);
+    AddTestCase (new Write_TextSorted (), TestCase::QUICK);
+    AddTestCase (new Write_PrefixSample (), TestCase::QUICK);
+    AddTestCase (new Write_Binary (), TestCase::QUICK);
+  }
+} g_TestSuiteAcmeFlatFibWriter;
+
+} // namespace TestSuiteAcmeFlatFibWriter
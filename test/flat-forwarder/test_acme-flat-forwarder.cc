@@ -54,20 +54,323 @@
  */
 
 #include "ns3/test.h"
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ccns3Sim-module.h"
 #include "ns3/acme-flat-forwarder.h"
+#include "ns3/acme-flat-forwarder-helper.h"
+#include "ns3/acme-flat-trie-fib.h"
+#include "ns3/acme-flat-map-fib.h"
 
 #include "../TestMacros.h"
 
 using namespace ns3;
 using namespace ns3::acme;
+using namespace ns3::ccnx;
 
 namespace TestSuiteAcmeFlatForwarder {
 
+/**
+ * Installs the CCNx stack with an AcmeFlatForwarder on `node`
+ *
+ * @return The forwarder, with the attributes of the current Config defaults
+ */
+static Ptr<AcmeFlatForwarder>
+InstallForwarder (Ptr<Node> node)
+{
+  CCNxStackHelper ccnx;
+  AcmeFlatForwarderHelper forwarder;
+  ccnx.SetForwardingHelper (forwarder);
+  ccnx.Install (node);
+  return node->GetObject<AcmeFlatForwarder> ();
+}
+
+/**
+ * Sends `count` Interests for `uri` from `portal`, all at the current time
+ */
+static void
+SendInterests (Ptr<CCNxPortal> portal, std::string uri, unsigned count)
+{
+  for (unsigned i = 0; i < count; ++i)
+    {
+      Ptr<CCNxInterest> interest = Create<CCNxInterest> (Create<CCNxName> (uri), Create<CCNxBuffer> (10, true));
+      portal->Send (CCNxPacket::CreateFromMessage (interest));
+    }
+}
+
+/**
+ * @return The sum of the items dispatched to all cores
+ */
+static uint64_t
+SumCoreItems (const std::vector<AcmeFlatForwarder::CoreStatsType> &cores)
+{
+  uint64_t items = 0;
+  for (size_t core = 0; core < cores.size (); ++core)
+    {
+      items += cores[core].items;
+    }
+  return items;
+}
+
+/**
+ * Counts the packets waiting in `portal`
+ */
+static void
+CountReceived (unsigned *count, Ptr<CCNxPortal> portal)
+{
+  while (portal->Recv ())
+    {
+      (*count)++;
+    }
+}
+
+/**
+ * A route callback that keeps every connection list it is given
+ */
+static void
+KeepConnectionList (std::vector<Ptr<CCNxConnectionList> > *kept, Ptr<CCNxPacket> packet, Ptr<CCNxConnection> ingress,
+                    CCNxRoutingError::RoutingErrorType error, Ptr<CCNxConnectionList> connections)
+{
+  kept->push_back (connections);
+}
+
 BeginTest (Constructor)
 {
 }
 EndTest ()
 
+BeginTest (NextHop_ConnectionRemoved)
+{
+  // Longest prefix match, so one anchor serves several names
+  Config::SetDefault ("ns3::ccnx::AcmeFlatForwarder::FibType", TypeIdValue (AcmeFlatTrieFib::GetTypeId ()));
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<AcmeFlatForwarder> forwarder = InstallForwarder (node);
+  TypeId portalFactory = TypeId::LookupByName ("ns3::ccnx::CCNxMessagePortalFactory");
+  Ptr<CCNxPortal> consumer = CCNxPortal::CreatePortal (node, portalFactory);
+  Ptr<CCNxPortal> a = CCNxPortal::CreatePortal (node, portalFactory);
+  Ptr<CCNxPortal> b = CCNxPortal::CreatePortal (node, portalFactory);
+  unsigned receivedA = 0;
+  unsigned receivedB = 0;
+  unsigned receivedC = 0;
+  a->SetRecvCallback (MakeBoundCallback (&CountReceived, &receivedA));
+  b->SetRecvCallback (MakeBoundCallback (&CountReceived, &receivedB));
+
+  Simulator::Run ();
+  Ptr<const CCNxName> prefixA = Create<CCNxName> ("ccnx:/name=a");
+  Ptr<const CCNxName> prefixB = Create<CCNxName> ("ccnx:/name=b");
+  a->RegisterAnchor (prefixA);
+  b->RegisterAnchor (prefixB);
+
+  // The connection of a next hop is resolved once and then cached
+  Simulator::Schedule (MilliSeconds (1), &SendInterests, consumer, std::string ("ccnx:/name=b/name=1"), 1u);
+  Simulator::Schedule (MilliSeconds (2), &SendInterests, consumer, std::string ("ccnx:/name=b/name=2"), 1u);
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (receivedB, 2, "Both Interests should reach b");
+  NS_TEST_EXPECT_MSG_EQ (forwarder->GetNextHopResolutions (), 1, "The second Interest should use the cached connection");
+
+  // a's last route goes with its anchor, so every cached connection is resolved again
+  a->UnregisterAnchor (prefixA);
+  a->Close ();
+  Simulator::Schedule (MilliSeconds (1), &SendInterests, consumer, std::string ("ccnx:/name=b/name=3"), 1u);
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (receivedB, 3, "The Interest should still reach b");
+  NS_TEST_EXPECT_MSG_EQ (forwarder->GetNextHopResolutions (), 2, "Removing a connection should drop the cached ones");
+
+  // The prefix of the removed connection now goes to its replacement
+  Ptr<CCNxPortal> c = CCNxPortal::CreatePortal (node, portalFactory);
+  c->SetRecvCallback (MakeBoundCallback (&CountReceived, &receivedC));
+  c->RegisterAnchor (prefixA);
+  Simulator::Schedule (MilliSeconds (1), &SendInterests, consumer, std::string ("ccnx:/name=a/name=1"), 1u);
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (receivedC, 1, "The Interest should reach the new connection");
+  NS_TEST_EXPECT_MSG_EQ (receivedA, 0, "The removed connection should get nothing");
+
+  // So does telling the forwarder directly
+  forwarder->ConnectionRemoved (0);
+  Simulator::Schedule (MilliSeconds (1), &SendInterests, consumer, std::string ("ccnx:/name=b/name=4"), 1u);
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (receivedB, 4, "The Interest should still reach b");
+  NS_TEST_EXPECT_MSG_EQ (forwarder->GetNextHopResolutions (), 4, "ConnectionRemoved should drop the cached connections");
+
+  consumer->Close ();
+  b->Close ();
+  c->Close ();
+  Simulator::Destroy ();
+  Config::SetDefault ("ns3::ccnx::AcmeFlatForwarder::FibType", TypeIdValue (AcmeFlatMapFib::GetTypeId ()));
+}
+EndTest ()
+
+BeginTest (Pools_Reuse)
+{
+  // Longest prefix match, so each Interest has its own PIT entry and still has a route
+  Config::SetDefault ("ns3::ccnx::AcmeFlatForwarder::FibType", TypeIdValue (AcmeFlatTrieFib::GetTypeId ()));
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<AcmeFlatForwarder> forwarder = InstallForwarder (node);
+  TypeId portalFactory = TypeId::LookupByName ("ns3::ccnx::CCNxMessagePortalFactory");
+  Ptr<CCNxPortal> consumer = CCNxPortal::CreatePortal (node, portalFactory);
+  Ptr<CCNxPortal> producer = CCNxPortal::CreatePortal (node, portalFactory);
+  unsigned received = 0;
+  producer->SetRecvCallback (MakeBoundCallback (&CountReceived, &received));
+
+  Simulator::Run ();
+  producer->RegisterAnchor (Create<CCNxName> ("ccnx:/name=pool"));
+
+  // The first Interest fills the pools
+  Simulator::Schedule (MilliSeconds (1), &SendInterests, consumer, std::string ("ccnx:/name=pool/name=0"), 1u);
+  Simulator::Run ();
+  const AcmeFlatForwarder::PoolStatsType warm = forwarder->GetPoolStats ();
+  NS_TEST_EXPECT_MSG_EQ (warm.workItemAllocations, 1, "The first Interest should allocate one work item");
+  NS_TEST_EXPECT_MSG_EQ (warm.connectionListAllocations, 1, "The first Interest should allocate one connection list");
+
+  // In steady state every packet reuses a pooled item and list
+  const unsigned sent = 5;
+  for (unsigned i = 1; i <= sent; ++i)
+    {
+      std::ostringstream uri;
+      uri << "ccnx:/name=pool/name=" << i;
+      Simulator::Schedule (MilliSeconds (i), &SendInterests, consumer, uri.str (), 1u);
+    }
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (received, sent + 1, "Every Interest should reach the producer");
+  const AcmeFlatForwarder::PoolStatsType steady = forwarder->GetPoolStats ();
+  NS_TEST_EXPECT_MSG_EQ (steady.workItemHits - warm.workItemHits, sent, "Every work item should come from the pool");
+  NS_TEST_EXPECT_MSG_EQ (steady.workItemAllocations, warm.workItemAllocations, "No work item should be allocated");
+  NS_TEST_EXPECT_MSG_EQ (steady.connectionListHits - warm.connectionListHits, sent, "Every connection list should come from the pool");
+  NS_TEST_EXPECT_MSG_EQ (steady.connectionListAllocations, warm.connectionListAllocations, "No connection list should be allocated");
+
+  // A list the route callback keeps is never handed out again
+  std::vector<Ptr<CCNxConnectionList> > kept;
+  forwarder->SetRouteCallback (MakeBoundCallback (&KeepConnectionList, &kept));
+  const unsigned keptCount = 3;
+  for (unsigned i = 1; i <= keptCount; ++i)
+    {
+      std::ostringstream uri;
+      uri << "ccnx:/name=pool/name=kept" << i;
+      Simulator::Schedule (MilliSeconds (i), &SendInterests, consumer, uri.str (), 1u);
+    }
+  Simulator::Run ();
+  NS_TEST_ASSERT_MSG_EQ (kept.size (), keptCount, "The callback should see every Interest");
+  for (unsigned i = 0; i < keptCount; ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (kept[i]->size (), 1, "Kept list " << i << " should still hold its egress");
+      for (unsigned j = 0; j < i; ++j)
+        {
+          NS_TEST_EXPECT_MSG_EQ ((kept[i] != kept[j]), true, "Kept lists " << j << " and " << i << " are the same list");
+        }
+    }
+  const AcmeFlatForwarder::PoolStatsType after = forwarder->GetPoolStats ();
+  NS_TEST_EXPECT_MSG_EQ (after.connectionListAllocations - steady.connectionListAllocations, keptCount - 1,
+                         "Only the first kept list should come from the pool");
+  NS_TEST_EXPECT_MSG_EQ (after.workItemHits - steady.workItemHits, keptCount, "Work items should still come from the pool");
+
+  consumer->Close ();
+  producer->Close ();
+  Simulator::Destroy ();
+  Config::SetDefault ("ns3::ccnx::AcmeFlatForwarder::FibType", TypeIdValue (AcmeFlatMapFib::GetTypeId ()));
+}
+EndTest ()
+
+BeginTest (Cores_SameNameSameCore)
+{
+  Config::SetDefault ("ns3::ccnx::AcmeFlatForwarder::Cores", UintegerValue (4));
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<AcmeFlatForwarder> forwarder = InstallForwarder (node);
+  Ptr<CCNxPortal> portal = CCNxPortal::CreatePortal (node, TypeId::LookupByName ("ns3::ccnx::CCNxMessagePortalFactory"));
+
+  // The forwarder creates its core queues when the node is initialized at the start of the run
+  Simulator::Run ();
+  const std::vector<AcmeFlatForwarder::CoreStatsType> &cores = forwarder->GetCoreStats ();
+  NS_TEST_ASSERT_MSG_EQ (cores.size (), 4, "Should have a queue per core");
+
+  const char *uris[] = { "ccnx:/name=a", "ccnx:/name=b", "ccnx:/name=c/name=1", "ccnx:/name=c/name=2", "ccnx:/name=d" };
+  for (size_t i = 0; i < sizeof (uris) / sizeof (uris[0]); ++i)
+    {
+      std::vector<uint64_t> before;
+      for (size_t core = 0; core < cores.size (); ++core)
+        {
+          before.push_back (cores[core].items);
+        }
+
+      Simulator::Schedule (MilliSeconds (1), &SendInterests, portal, std::string (uris[i]), 3u);
+      Simulator::Run ();
+
+      // All three landed on one core and nothing else moved
+      unsigned loaded = 0;
+      for (size_t core = 0; core < cores.size (); ++core)
+        {
+          uint64_t added = cores[core].items - before[core];
+          NS_TEST_EXPECT_MSG_EQ ((added == 0 || added == 3), true, "The Interests for " << uris[i] << " were split across cores");
+          loaded += added > 0 ? 1 : 0;
+        }
+      NS_TEST_EXPECT_MSG_EQ (loaded, 1, "The Interests for " << uris[i] << " should go to one core");
+    }
+
+  portal->Close ();
+  Simulator::Destroy ();
+  Config::SetDefault ("ns3::ccnx::AcmeFlatForwarder::Cores", UintegerValue (0));
+}
+EndTest ()
+
+BeginTest (Cores_Stats)
+{
+  Config::SetDefault ("ns3::ccnx::AcmeFlatForwarder::Cores", UintegerValue (2));
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<AcmeFlatForwarder> forwarder = InstallForwarder (node);
+  Ptr<CCNxPortal> portal = CCNxPortal::CreatePortal (node, TypeId::LookupByName ("ns3::ccnx::CCNxMessagePortalFactory"));
+
+  // Every Interest arrives before the first service (the default 1 us layer delay) ends
+  const unsigned sent = 16;
+  for (unsigned i = 0; i < sent; ++i)
+    {
+      std::ostringstream uri;
+      uri << "ccnx:/name=stats/name=" << i;
+      Simulator::Schedule (MilliSeconds (1), &SendInterests, portal, uri.str (), 1u);
+    }
+  Simulator::Run ();
+
+  const std::vector<AcmeFlatForwarder::CoreStatsType> &cores = forwarder->GetCoreStats ();
+  NS_TEST_EXPECT_MSG_EQ (SumCoreItems (cores), sent, "Every Interest should be dispatched to a core");
+  for (size_t core = 0; core < cores.size (); ++core)
+    {
+      NS_TEST_EXPECT_MSG_EQ (cores[core].busy, MicroSeconds (1) * static_cast<int64_t> (cores[core].items),
+                             "Core " << core << " should be busy one layer delay per item");
+      NS_TEST_EXPECT_MSG_EQ (cores[core].peakDepth, cores[core].items, "Core " << core << " should have queued all its items at once");
+      NS_TEST_EXPECT_MSG_EQ (cores[core].depth, 0, "Core " << core << " should be idle");
+    }
+
+  portal->Close ();
+  Simulator::Destroy ();
+  Config::SetDefault ("ns3::ccnx::AcmeFlatForwarder::Cores", UintegerValue (0));
+}
+EndTest ()
+
+BeginTest (Cores_InputQueueDrop)
+{
+  Config::SetDefault ("ns3::ccnx::AcmeFlatForwarder::Cores", UintegerValue (2));
+  Config::SetDefault ("ns3::ccnx::AcmeFlatForwarder::MaxInputQueueDepth", UintegerValue (1));
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<AcmeFlatForwarder> forwarder = InstallForwarder (node);
+  Ptr<CCNxPortal> portal = CCNxPortal::CreatePortal (node, TypeId::LookupByName ("ns3::ccnx::CCNxMessagePortalFactory"));
+
+  // One in service and one waiting on the core of the name, the other two dropped
+  Simulator::Schedule (MilliSeconds (1), &SendInterests, portal, std::string ("ccnx:/name=drops"), 4u);
+  Simulator::Run ();
+
+  const std::vector<AcmeFlatForwarder::CoreStatsType> &cores = forwarder->GetCoreStats ();
+  NS_TEST_EXPECT_MSG_EQ (SumCoreItems (cores), 4, "Dropped Interests are still dispatched");
+  NS_TEST_EXPECT_MSG_EQ (forwarder->GetStats ().GetTailDrops (), 2, "Wrong number of tail drops");
+  for (size_t core = 0; core < cores.size (); ++core)
+    {
+      NS_TEST_EXPECT_MSG_EQ (cores[core].depth, 0, "Core " << core << " should be idle after its drops");
+    }
+
+  portal->Close ();
+  Simulator::Destroy ();
+  Config::SetDefault ("ns3::ccnx::AcmeFlatForwarder::Cores", UintegerValue (0));
+  Config::SetDefault ("ns3::ccnx::AcmeFlatForwarder::MaxInputQueueDepth", UintegerValue (0));
+}
+EndTest ()
+
 /**
  * @ingroup ccnx-test
  *
@@ -79,6 +382,11 @@ public:
   TestSuiteAcmeFlatForwarder () : TestSuite ("ccnx-flat-forwarder", UNIT)
   {
     AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new NextHop_ConnectionRemoved (), TestCase::QUICK);
+    AddTestCase (new Pools_Reuse (), TestCase::QUICK);
+    AddTestCase (new Cores_SameNameSameCore (), TestCase::QUICK);
+    AddTestCase (new Cores_Stats (), TestCase::QUICK);
+    AddTestCase (new Cores_InputQueueDrop (), TestCase::QUICK);
   }
 } g_TestSuiteAcmeFlatForwarder;
 
@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <cstdio>
+
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+#include "ns3/acme-flat-hash-fib.h"
+#include "ns3/acme-flat-name-digest.h"
+
+#include "../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+namespace TestSuiteAcmeFlatHashFib {
+
+static Ptr<const CCNxName>
+MakeName (unsigned index)
+{
+  char buffer[64];
+  snprintf (buffer, sizeof(buffer), "ccnx:/name=acm/name=icn/name=%06u", index);
+  return Create<CCNxName> (buffer);
+}
+
+BeginTest (Constructor)
+{
+  Ptr<AcmeFlatHashFib> fib = CreateObject<AcmeFlatHashFib> ();
+  NS_TEST_EXPECT_MSG_EQ (fib->GetSize (), 0, "New FIB should be empty");
+}
+EndTest ()
+
+BeginTest (AddRoute_Lookup)
+{
+  Ptr<AcmeFlatHashFib> fib = CreateObject<AcmeFlatHashFib> ();
+  Ptr<const CCNxName> name = MakeName (1);
+  uint64_t digest = AcmeFlatNameDigest::Compute (*name);
+
+  NS_TEST_EXPECT_MSG_EQ (fib->AddRoute (name, digest, 7), true, "First add should succeed");
+  NS_TEST_EXPECT_MSG_EQ (fib->AddRoute (name, digest, 8), false, "Duplicate add should fail");
+
+  // Look up with a different instance of an equal name
+  Ptr<const CCNxName> lookup = MakeName (1);
+  CCNxConnection::ConnIdType connId = 0;
+  bool found = fib->Lookup (lookup, AcmeFlatNameDigest::Compute (*lookup), connId);
+  NS_TEST_EXPECT_MSG_EQ (found, true, "Lookup should find the route");
+  NS_TEST_EXPECT_MSG_EQ (connId, 7, "Wrong connection id");
+
+  Ptr<const CCNxName> missing = MakeName (2);
+  found = fib->Lookup (missing, AcmeFlatNameDigest::Compute (*missing), connId);
+  NS_TEST_EXPECT_MSG_EQ (found, false, "Lookup should not find a missing name");
+}
+EndTest ()
+
+BeginTest (RemoveRoute_GrowAndShift)
+{
+  // A tiny initial table forces several doublings and long probe runs
+  Ptr<AcmeFlatHashFib> fib = CreateObject<AcmeFlatHashFib> ();
+  fib->SetAttribute ("InitialCapacity", UintegerValue (4));
+
+  const unsigned count = 1000;
+  for (unsigned i = 0; i < count; ++i)
+    {
+      Ptr<const CCNxName> name = MakeName (i);
+      fib->AddRoute (name, AcmeFlatNameDigest::Compute (*name), i + 1);
+    }
+  NS_TEST_EXPECT_MSG_EQ (fib->GetSize (), count, "Wrong size after adds");
+
+  // Remove the even names, then every odd name must still be reachable
+  for (unsigned i = 0; i < count; i += 2)
+    {
+      Ptr<const CCNxName> name = MakeName (i);
+      NS_TEST_EXPECT_MSG_EQ (fib->RemoveRoute (name, AcmeFlatNameDigest::Compute (*name), i + 1), true, "Remove failed " << i);
+    }
+  NS_TEST_EXPECT_MSG_EQ (fib->GetSize (), count / 2, "Wrong size after removes");
+
+  for (unsigned i = 0; i < count; ++i)
+    {
+      Ptr<const CCNxName> name = MakeName (i);
+      CCNxConnection::ConnIdType connId = 0;
+      bool found = fib->Lookup (name, AcmeFlatNameDigest::Compute (*name), connId);
+      NS_TEST_EXPECT_MSG_EQ (found, (i % 2) == 1, "Wrong lookup result for " << i);
+      if (found)
+        {
+          NS_TEST_EXPECT_MSG_EQ (connId, i + 1, "Wrong connection id for " << i);
+        }
+    }
+}
+EndTest ()
+
+BeginTest (LookupNextHop_KeepsCache)
+{
+  Ptr<AcmeFlatHashFib> fib = CreateObject<AcmeFlatHashFib> ();
+  fib->SetAttribute ("InitialCapacity", UintegerValue (4));
+  Ptr<const CCNxName> name = MakeName (1);
+  uint64_t digest = AcmeFlatNameDigest::Compute (*name);
+  fib->AddRoute (name, digest, 7);
+
+  AcmeFlatFib::NextHopType *nextHop = fib->LookupNextHop (name, digest);
+  NS_TEST_EXPECT_MSG_EQ ((nextHop != 0), true, "LookupNextHop should find the route");
+  NS_TEST_EXPECT_MSG_EQ (nextHop->connId, 7, "Wrong connection id");
+  NS_TEST_EXPECT_MSG_EQ (fib->PeekNextHopState (*nextHop).epoch, 0, "New route should have nothing cached");
+  fib->GetNextHopState (*nextHop).epoch = 3;
+
+  // Growing the table moves the slot, the cached epoch must move with it
+  for (unsigned i = 2; i < 100; ++i)
+    {
+      Ptr<const CCNxName> other = MakeName (i);
+      fib->AddRoute (other, AcmeFlatNameDigest::Compute (*other), i);
+    }
+  nextHop = fib->LookupNextHop (name, digest);
+  NS_TEST_EXPECT_MSG_EQ (fib->PeekNextHopState (*nextHop).epoch, 3, "Cached epoch lost on resize");
+
+  Ptr<const CCNxName> missing = MakeName (100);
+  NS_TEST_EXPECT_MSG_EQ ((fib->LookupNextHop (missing, AcmeFlatNameDigest::Compute (*missing)) == 0), true, "LookupNextHop should miss");
+}
+EndTest ()
+
+BeginTest (AddRoutes_SizedOnce)
+{
+  Ptr<AcmeFlatHashFib> fib = CreateObject<AcmeFlatHashFib> ();
+  fib->SetAttribute ("InitialCapacity", UintegerValue (4));
+  Ptr<const CCNxName> existing = MakeName (0);
+  fib->AddRoute (existing, AcmeFlatNameDigest::Compute (*existing), 99);
+
+  const unsigned count = 1000;
+  std::vector<AcmeFlatFib::BulkRouteType> routes;
+  for (unsigned i = 0; i < count; ++i)
+    {
+      AcmeFlatFib::BulkRouteType route = { MakeName (i), 0, i + 1 };
+      route.digest = AcmeFlatNameDigest::Compute (*route.name);
+      routes.push_back (route);
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (fib->AddRoutes (routes), count - 1, "The name already in the FIB should be skipped");
+  NS_TEST_EXPECT_MSG_EQ (fib->GetSize (), count, "Wrong size after bulk add");
+  NS_TEST_EXPECT_MSG_EQ (fib->GetCapacity (), 2048, "The table should be sized once for the load factor");
+  NS_TEST_EXPECT_MSG_GT (fib->GetMemoryUsage (), 2048 * sizeof(uint64_t), "Memory usage should cover the digests");
+
+  CCNxConnection::ConnIdType connId = 0;
+  NS_TEST_EXPECT_MSG_EQ (fib->Lookup (existing, AcmeFlatNameDigest::Compute (*existing), connId), true, "Lookup failed");
+  NS_TEST_EXPECT_MSG_EQ (connId, 99, "Bulk add should not replace a route");
+  Ptr<const CCNxName> last = MakeName (count - 1);
+  NS_TEST_EXPECT_MSG_EQ (fib->Lookup (last, AcmeFlatNameDigest::Compute (*last), connId), true, "Lookup failed");
+  NS_TEST_EXPECT_MSG_EQ (connId, count, "Wrong connection id");
+}
+EndTest ()
+
+BeginTest (AddNextHop_RemoveRoute)
+{
+  Ptr<AcmeFlatHashFib> fib = CreateObject<AcmeFlatHashFib> ();
+  Ptr<const CCNxName> name = MakeName (1);
+  uint64_t digest = AcmeFlatNameDigest::Compute (*name);
+
+  NS_TEST_EXPECT_MSG_EQ (fib->AddNextHop (name, digest, 7, 0), true, "First next hop should add the route");
+  NS_TEST_EXPECT_MSG_EQ (fib->AddNextHop (name, digest, 8, 5), true, "Second next hop should be added");
+  NS_TEST_EXPECT_MSG_EQ (fib->AddNextHop (name, digest, 9, 10), true, "Third next hop should be added");
+  NS_TEST_EXPECT_MSG_EQ (fib->AddNextHop (name, digest, 8, 1), false, "Repeated next hop should fail");
+  NS_TEST_EXPECT_MSG_EQ (fib->GetSize (), 1, "Next hops are one route");
+
+  AcmeFlatFib::NextHopType *first = fib->LookupNextHop (name, digest);
+  NS_TEST_EXPECT_MSG_EQ ((first != 0), true, "Lookup failed");
+  NS_TEST_EXPECT_MSG_EQ (fib->GetNextHopCount (*first), 3, "Wrong next hop count");
+  NS_TEST_EXPECT_MSG_EQ (fib->GetNextHop (*first, 2).cost, 10, "Wrong cost");
+
+  std::vector<AcmeFlatFib::RouteType> routes;
+  fib->GetRoutes (routes);
+  NS_TEST_EXPECT_MSG_EQ (routes.size (), 3, "GetRoutes should list every next hop");
+
+  // Removing the first next hop promotes an alternate
+  NS_TEST_EXPECT_MSG_EQ (fib->RemoveRoute (name, digest, 7), true, "Remove failed");
+  first = fib->LookupNextHop (name, digest);
+  NS_TEST_EXPECT_MSG_EQ ((first != 0), true, "The route should remain");
+  NS_TEST_EXPECT_MSG_EQ (fib->GetNextHopCount (*first), 2, "Wrong next hop count");
+  NS_TEST_EXPECT_MSG_EQ ((first->connId == 8 || first->connId == 9), true, "An alternate should be promoted");
+
+  NS_TEST_EXPECT_MSG_EQ (fib->RemoveRoute (name, digest, 7), false, "Removed next hop should be gone");
+  NS_TEST_EXPECT_MSG_EQ (fib->RemoveRoute (name, digest, 8), true, "Remove failed");
+  NS_TEST_EXPECT_MSG_EQ (fib->RemoveRoute (name, digest, 9), true, "Remove failed");
+  NS_TEST_EXPECT_MSG_EQ (fib->GetSize (), 0, "Removing the last next hop should remove the route");
+}
+EndTest ()
+
+BeginTest (NextHopState_Release)
+{
+  NS_TEST_EXPECT_MSG_EQ (sizeof (AcmeFlatFib::NextHopType), 16, "A next hop should only hold the hot fields");
+
+  Ptr<AcmeFlatHashFib> fib = CreateObject<AcmeFlatHashFib> ();
+  Ptr<const CCNxName> name = MakeName (1);
+  uint64_t digest = AcmeFlatNameDigest::Compute (*name);
+  fib->AddNextHop (name, digest, 7, 0);
+  fib->AddNextHop (name, digest, 8, 0);
+
+  AcmeFlatFib::NextHopType *first = fib->LookupNextHop (name, digest);
+  NS_TEST_EXPECT_MSG_EQ (first->state, AcmeFlatFib::NoState, "A new next hop should have no state");
+  fib->GetNextHopState (*first).packets = 5;
+  fib->GetNextHopState (fib->GetNextHop (*first, 1)).packets = 6;
+
+  std::vector<AcmeFlatFib::RouteType> routes;
+  fib->GetRoutes (routes);
+  NS_TEST_EXPECT_MSG_EQ (routes[0].packets + routes[1].packets, 11, "GetRoutes should list the counters");
+
+  // The promoted alternate keeps its own state, the removed one is freed and reused clean
+  fib->RemoveRoute (name, digest, 7);
+  first = fib->LookupNextHop (name, digest);
+  NS_TEST_EXPECT_MSG_EQ (fib->PeekNextHopState (*first).packets, 6, "The promoted next hop lost its state");
+  fib->AddNextHop (name, digest, 7, 0);
+  NS_TEST_EXPECT_MSG_EQ (fib->GetNextHopState (fib->GetNextHop (*first, 1)).packets, 0, "A reused state should be empty");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for AcmeFlatHashFib
+ */
+static class TestSuiteAcmeFlatHashFib : public TestSuite
+{
+public:
+  TestSuiteAcmeFlatHashFib () : TestSuite ("acme-flat-hash-fib", UNIT)
+  {
+    AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new AddRoute_Lookup (), TestCase::QUICK);
+    AddTestCase (new RemoveRoute_GrowAndShift (), TestCase::QUICK);
+    AddTestCase (new LookupNextHop_KeepsCache (), TestCase::QUICK);
+    AddTestCase (new AddRoutes_SizedOnce (), TestCase::QUICK);
+    AddTestCase (new AddNextHop_RemoveRoute (), TestCase::QUICK);
+    AddTestCase (new NextHopState_Release (), TestCase::QUICK);
+  }
+} g_TestSuiteAcmeFlatHashFib;
+
+} // namespace TestSuiteAcmeFlatHashFib
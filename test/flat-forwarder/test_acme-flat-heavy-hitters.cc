@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <stdio.h>
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/acme-flat-heavy-hitters.h"
+#include "ns3/acme-flat-name-digest.h"
+
+#include "../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+namespace TestSuiteAcmeFlatHeavyHitters {
+
+static Ptr<const CCNxName>
+MakeName (unsigned i)
+{
+  char buffer[64];
+  sprintf (buffer, "ccnx:/name=hot/name=%u", i);
+  return Create<CCNxName> (buffer);
+}
+
+/**
+ * Adds name i (1000 / (i + 1)) times for i in [0, count), interleaved as a
+ * Zipf-like stream would be
+ */
+static void
+AddZipf (AcmeFlatHeavyHitters &hitters, unsigned count)
+{
+  std::vector<Ptr<const CCNxName> > names;
+  for (unsigned i = 0; i < count; ++i)
+    {
+      names.push_back (MakeName (i));
+    }
+  for (unsigned round = 0; round < 1000; ++round)
+    {
+      for (unsigned i = 0; i < count && round < 1000 / (i + 1); ++i)
+        {
+          hitters.Add (names[i], AcmeFlatNameDigest::Compute (*names[i]));
+        }
+    }
+}
+
+BeginTest (Constructor)
+{
+  AcmeFlatHeavyHitters hitters (1000, 4, 5);
+  NS_TEST_EXPECT_MSG_EQ (hitters.GetTotal (), 0, "Wrong total");
+  NS_TEST_EXPECT_MSG_EQ (hitters.GetTopK ().size (), 0, "Top K should be empty");
+  NS_TEST_EXPECT_MSG_EQ (hitters.Estimate (1), 0, "Wrong estimate");
+}
+EndTest ()
+
+BeginTest (Add_TopK)
+{
+  AcmeFlatHeavyHitters hitters (1024, 4, 5);
+  AddZipf (hitters, 100);
+
+  std::vector<AcmeFlatHeavyHitters::HitterType> top = hitters.GetTopK ();
+  NS_TEST_EXPECT_MSG_EQ (top.size (), 5, "Should keep k names");
+  for (unsigned i = 0; i < top.size () && i < 5; ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (top[i].name->Equals (*MakeName (i)), true, "Wrong name at rank " << i);
+      NS_TEST_EXPECT_MSG_EQ (top[i].count, 1000 / (i + 1), "A wide sketch should count exactly");
+    }
+}
+EndTest ()
+
+BeginTest (Add_Replace)
+{
+  AcmeFlatHeavyHitters hitters (4096, 4, 3);
+  unsigned counts[] = { 5, 4, 3, 6 };
+  for (unsigned i = 0; i < 4; ++i)
+    {
+      Ptr<const CCNxName> name = MakeName (i);
+      for (unsigned j = 0; j < counts[i]; ++j)
+        {
+          hitters.Add (name, AcmeFlatNameDigest::Compute (*name));
+        }
+    }
+
+  // Name 3 took the slot of name 2 once it passed it
+  std::vector<AcmeFlatHeavyHitters::HitterType> top = hitters.GetTopK ();
+  NS_TEST_ASSERT_MSG_EQ (top.size (), 3, "Should keep k names");
+  NS_TEST_EXPECT_MSG_EQ (top[0].name->Equals (*MakeName (3)), true, "Name 3 should be first");
+  NS_TEST_EXPECT_MSG_EQ (top[0].count, 6, "Wrong count");
+  NS_TEST_EXPECT_MSG_EQ (top[2].name->Equals (*MakeName (1)), true, "Name 1 should be last");
+
+  // A kept name is found again and updated in place
+  Ptr<const CCNxName> name = MakeName (1);
+  for (unsigned j = 0; j < 3; ++j)
+    {
+      hitters.Add (name, AcmeFlatNameDigest::Compute (*name));
+    }
+  top = hitters.GetTopK ();
+  NS_TEST_ASSERT_MSG_EQ (top.size (), 3, "Should keep k names");
+  NS_TEST_EXPECT_MSG_EQ (top[0].name->Equals (*MakeName (1)), true, "Name 1 should be first");
+  NS_TEST_EXPECT_MSG_EQ (top[0].count, 7, "Wrong count");
+}
+EndTest ()
+
+BeginTest (Estimate_Overcount)
+{
+  // 16 counters per row for 100 names: estimates collide but never undercount
+  AcmeFlatHeavyHitters hitters (16, 4, 3);
+  AddZipf (hitters, 100);
+
+  for (unsigned i = 0; i < 100; ++i)
+    {
+      uint64_t estimate = hitters.Estimate (AcmeFlatNameDigest::Compute (*MakeName (i)));
+      NS_TEST_EXPECT_MSG_GT (estimate + 1, 1000 / (i + 1), "Estimate of name " << i << " is below its count");
+    }
+
+  std::vector<AcmeFlatHeavyHitters::HitterType> top = hitters.GetTopK ();
+  NS_TEST_EXPECT_MSG_EQ (top[0].name->Equals (*MakeName (0)), true, "The most frequent name should still be first");
+}
+EndTest ()
+
+BeginTest (GetMemoryUsage_Fixed)
+{
+  AcmeFlatHeavyHitters hitters (256, 4, 10);
+  AddZipf (hitters, 10);
+  size_t bytes = hitters.GetMemoryUsage ();
+
+  // Many more distinct names do not grow the memory
+  for (unsigned i = 0; i < 10000; ++i)
+    {
+      Ptr<const CCNxName> name = MakeName (1000 + i);
+      hitters.Add (name, AcmeFlatNameDigest::Compute (*name));
+    }
+  NS_TEST_EXPECT_MSG_EQ (hitters.GetMemoryUsage (), bytes, "Memory should not grow with the names");
+  NS_TEST_EXPECT_MSG_EQ (hitters.GetTopK ().size (), 10, "Should keep k names");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for AcmeFlatHeavyHitters
+ */
+static class TestSuiteAcmeFlatHeavyHitters : public TestSuite
+{
+public:
+  TestSuiteAcmeFlatHeavyHitters () : TestSuite ("acme-flat-heavy-hitters", UNIT)
+  {
+    AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new Add_TopK (), TestCase::QUICK);
+    AddTestCase (new Add_Replace (), TestCase::QUICK);
+    AddTestCase (new Estimate_Overcount (), TestCase::QUICK);
+    AddTestCase (new GetMemoryUsage_Fixed (), TestCase::QUICK);
+  }
+} g_TestSuiteAcmeFlatHeavyHitters;
+
+} // namespace TestSuiteAcmeFlatHeavyHitters
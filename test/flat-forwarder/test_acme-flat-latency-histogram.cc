@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "ns3/test.h"
+#include "ns3/acme-flat-latency-histogram.h"
+#include "ns3/acme-flat-forwarder-stats.h"
+
+#include "../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+
+namespace TestSuiteAcmeFlatLatencyHistogram {
+
+BeginTest (Constructor)
+{
+  AcmeFlatLatencyHistogram histogram;
+  NS_TEST_EXPECT_MSG_EQ (histogram.GetCount (), 0, "New histogram should be empty");
+  NS_TEST_EXPECT_MSG_EQ (histogram.GetPercentile (50), NanoSeconds (0), "Empty percentile should be 0");
+}
+EndTest ()
+
+BeginTest (Record_Percentile)
+{
+  AcmeFlatLatencyHistogram histogram;
+  for (unsigned i = 1; i <= 1000; ++i)
+    {
+      histogram.Record (MicroSeconds (i));
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (histogram.GetCount (), 1000, "Wrong count");
+  NS_TEST_EXPECT_MSG_EQ (histogram.GetMin (), MicroSeconds (1), "Wrong min");
+  NS_TEST_EXPECT_MSG_EQ (histogram.GetMax (), MicroSeconds (1000), "Wrong max");
+
+  // A bucket spans at most 1/8 of its values
+  int64_t p50 = histogram.GetPercentile (50).GetNanoSeconds ();
+  NS_TEST_EXPECT_MSG_EQ ((p50 >= 500000 && p50 <= 500000 + 500000 / 8), true, "p50 out of bounds " << p50);
+  int64_t p99 = histogram.GetPercentile (99).GetNanoSeconds ();
+  NS_TEST_EXPECT_MSG_EQ ((p99 >= 990000 && p99 <= 1000000), true, "p99 out of bounds " << p99);
+  NS_TEST_EXPECT_MSG_EQ (histogram.GetPercentile (100), MicroSeconds (1000), "p100 should be the max");
+}
+EndTest ()
+
+BeginTest (Stats_Add)
+{
+  AcmeFlatForwarderStats a;
+  a.IncrementInterestsIn ();
+  a.IncrementNoRouteDrops ();
+  a.RecordInputLatency (MicroSeconds (10));
+
+  AcmeFlatForwarderStats b;
+  b.IncrementInterestsIn ();
+  b.IncrementObjectsForwarded (3);
+  b.RecordInputLatency (MicroSeconds (20));
+
+  a += b;
+  NS_TEST_EXPECT_MSG_EQ (a.GetInterestsIn (), 2, "Wrong interests in");
+  NS_TEST_EXPECT_MSG_EQ (a.GetNoRouteDrops (), 1, "Wrong no route drops");
+  NS_TEST_EXPECT_MSG_EQ (a.GetObjectsForwarded (), 3, "Wrong objects forwarded");
+  NS_TEST_EXPECT_MSG_EQ (a.GetInputLatency ().GetCount (), 2, "Wrong latency count");
+  NS_TEST_EXPECT_MSG_EQ (a.GetInputLatency ().GetMin (), MicroSeconds (10), "Wrong latency min");
+  NS_TEST_EXPECT_MSG_EQ (a.GetInputLatency ().GetMax (), MicroSeconds (20), "Wrong latency max");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for AcmeFlatLatencyHistogram and AcmeFlatForwarderStats
+ */
+static class TestSuiteAcmeFlatLatencyHistogram : public TestSuite
+{
+public:
+  TestSuiteAcmeFlatLatencyHistogram () : TestSuite ("acme-flat-latency-histogram", UNIT)
+  {
+    AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new Record_Percentile (), TestCase::QUICK);
+    AddTestCase (new Stats_Add (), TestCase::QUICK);
+  }
+} g_TestSuiteAcmeFlatLatencyHistogram;
+
+} // namespace TestSuiteAcmeFlatLatencyHistogram
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <stdio.h>
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/acme-flat-name-table.h"
+#include "ns3/acme-flat-name-digest.h"
+
+#include "../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+namespace TestSuiteAcmeFlatNameTable {
+
+static Ptr<const CCNxName>
+MakeName (unsigned i)
+{
+  char buffer[64];
+  sprintf (buffer, "ccnx:/name=interned/name=%u", i);
+  return Create<CCNxName> (buffer);
+}
+
+static uint32_t
+Intern (AcmeFlatNameTable &names, Ptr<const CCNxName> name)
+{
+  return names.Intern (name, AcmeFlatNameDigest::Compute (*name));
+}
+
+BeginTest (Constructor)
+{
+  AcmeFlatNameTable names (10);
+  NS_TEST_EXPECT_MSG_EQ (names.GetSize (), 0, "Wrong size");
+  NS_TEST_EXPECT_MSG_EQ (names.GetCapacity (), 10, "Wrong capacity");
+  NS_TEST_EXPECT_MSG_EQ (names.GetHits (), 0, "Wrong hits");
+  NS_TEST_EXPECT_MSG_EQ (names.GetRetired (), 0, "Wrong retired");
+}
+EndTest ()
+
+BeginTest (Intern_SameInstance)
+{
+  AcmeFlatNameTable names (10);
+  Ptr<const CCNxName> first = MakeName (1);
+  Ptr<const CCNxName> copy = MakeName (1);
+  Ptr<const CCNxName> other = MakeName (2);
+
+  uint32_t id = Intern (names, first);
+  NS_TEST_EXPECT_MSG_EQ (Intern (names, copy), id, "A copy should get the same id");
+  NS_TEST_EXPECT_MSG_NE (Intern (names, other), id, "Another name should get another id");
+  NS_TEST_EXPECT_MSG_EQ (names.GetName (id) == first, true, "The first instance should be kept");
+  NS_TEST_EXPECT_MSG_EQ (names.GetSize (), 2, "Wrong size");
+  NS_TEST_EXPECT_MSG_EQ (names.GetHits (), 1, "Wrong hits");
+  NS_TEST_EXPECT_MSG_EQ (names.Find (*copy, AcmeFlatNameDigest::Compute (*copy)), id, "Find should match a copy");
+  NS_TEST_EXPECT_MSG_EQ (names.Find (*MakeName (3), AcmeFlatNameDigest::Compute (*MakeName (3))), AcmeFlatNameTable::None,
+                         "Find should not add a name");
+}
+EndTest ()
+
+BeginTest (Equals_Pointer)
+{
+  Ptr<const CCNxName> a = MakeName (1);
+  Ptr<const CCNxName> b = MakeName (1);
+  uint64_t segmentCompares = 0;
+  NS_TEST_EXPECT_MSG_EQ (AcmeFlatNameTable::Equals (*a, *a, segmentCompares), true, "Same instance should be equal");
+  NS_TEST_EXPECT_MSG_EQ (segmentCompares, 0, "Same instance should not compare segments");
+  NS_TEST_EXPECT_MSG_EQ (AcmeFlatNameTable::Equals (*a, *b, segmentCompares), true, "Copies should be equal");
+  NS_TEST_EXPECT_MSG_EQ (segmentCompares, 2, "Copies should compare segments");
+  NS_TEST_EXPECT_MSG_EQ (AcmeFlatNameTable::Equals (*a, *MakeName (2), segmentCompares), false, "Different names");
+}
+EndTest ()
+
+BeginTest (Intern_RetiresUnused)
+{
+  AcmeFlatNameTable names (4);
+
+  // Names 0 and 1 stay in use, like names held by a PIT entry
+  std::vector<Ptr<const CCNxName> > inUse;
+  inUse.push_back (MakeName (0));
+  inUse.push_back (MakeName (1));
+  uint32_t id0 = Intern (names, inUse[0]);
+  uint32_t id1 = Intern (names, inUse[1]);
+
+  for (unsigned i = 2; i < 20; ++i)
+    {
+      Intern (names, MakeName (i));
+    }
+  NS_TEST_EXPECT_MSG_EQ (names.GetSize (), 4, "The table should stay at capacity");
+  NS_TEST_EXPECT_MSG_EQ (names.GetRetired (), 16, "Wrong retired");
+  NS_TEST_EXPECT_MSG_EQ (Intern (names, MakeName (0)), id0, "A name in use should not be retired");
+  NS_TEST_EXPECT_MSG_EQ (Intern (names, MakeName (1)), id1, "A name in use should not be retired");
+  NS_TEST_EXPECT_MSG_EQ (names.Find (*MakeName (2), AcmeFlatNameDigest::Compute (*MakeName (2))), AcmeFlatNameTable::None,
+                         "The least recent unused name should be retired");
+
+  // Retired ids are reused, so the ids stay dense
+  NS_TEST_EXPECT_MSG_LT (Intern (names, MakeName (100)), 5, "Ids should be reused");
+}
+EndTest ()
+
+BeginTest (Intern_InUseOverCapacity)
+{
+  AcmeFlatNameTable names (2);
+  std::vector<Ptr<const CCNxName> > inUse;
+  for (unsigned i = 0; i < 5; ++i)
+    {
+      inUse.push_back (MakeName (i));
+      Intern (names, inUse.back ());
+    }
+  NS_TEST_EXPECT_MSG_EQ (names.GetSize (), 5, "Names in use should not be retired");
+  NS_TEST_EXPECT_MSG_EQ (names.GetRetired (), 0, "Wrong retired");
+
+  inUse.clear ();
+  Intern (names, MakeName (10));
+  NS_TEST_EXPECT_MSG_EQ (names.GetRetired (), 1, "An unused name should be retired");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for AcmeFlatNameTable
+ */
+static class TestSuiteAcmeFlatNameTable : public TestSuite
+{
+public:
+  TestSuiteAcmeFlatNameTable () : TestSuite ("acme-flat-name-table", UNIT)
+  {
+    AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new Intern_SameInstance (), TestCase::QUICK);
+    AddTestCase (new Equals_Pointer (), TestCase::QUICK);
+    AddTestCase (new Intern_RetiresUnused (), TestCase::QUICK);
+    AddTestCase (new Intern_InUseOverCapacity (), TestCase::QUICK);
+  }
+} g_TestSuiteAcmeFlatNameTable;
+
+} // namespace TestSuiteAcmeFlatNameTable
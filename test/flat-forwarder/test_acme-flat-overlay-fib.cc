@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <cstdio>
+
+#include "ns3/test.h"
+#include "ns3/acme-flat-overlay-fib.h"
+#include "ns3/acme-flat-trie-fib.h"
+#include "ns3/acme-flat-hash-fib.h"
+#include "ns3/acme-flat-name-digest.h"
+
+#include "../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+namespace TestSuiteAcmeFlatOverlayFib {
+
+static bool
+AddNextHop (Ptr<AcmeFlatFib> fib, const char *uri, CCNxConnection::ConnIdType connId)
+{
+  Ptr<const CCNxName> name = Create<CCNxName> (uri);
+  return fib->AddNextHop (name, AcmeFlatNameDigest::Compute (*name), connId, 0);
+}
+
+static bool
+RemoveRoute (Ptr<AcmeFlatFib> fib, const char *uri, CCNxConnection::ConnIdType connId)
+{
+  Ptr<const CCNxName> name = Create<CCNxName> (uri);
+  return fib->RemoveRoute (name, AcmeFlatNameDigest::Compute (*name), connId);
+}
+
+static AcmeFlatFib::NextHopType *
+LookupNextHop (Ptr<AcmeFlatFib> fib, const char *uri)
+{
+  Ptr<const CCNxName> name = Create<CCNxName> (uri);
+  return fib->LookupNextHop (name, AcmeFlatNameDigest::Compute (*name));
+}
+
+/**
+ * @return A shared trie FIB with routes to /acm on 1 and /acm/icn on 2 and 3
+ */
+static Ptr<AcmeFlatFib>
+MakeShared (void)
+{
+  Ptr<AcmeFlatFib> shared = CreateObject<AcmeFlatTrieFib> ();
+  AddNextHop (shared, "ccnx:/name=acm", 1);
+  AddNextHop (shared, "ccnx:/name=acm/name=icn", 2);
+  AddNextHop (shared, "ccnx:/name=acm/name=icn", 3);
+  return shared;
+}
+
+static Ptr<AcmeFlatOverlayFib>
+MakeOverlay (Ptr<AcmeFlatFib> shared)
+{
+  Ptr<AcmeFlatOverlayFib> overlay = CreateObject<AcmeFlatOverlayFib> ();
+  overlay->SetFibs (shared, CreateObject<AcmeFlatTrieFib> ());
+  return overlay;
+}
+
+BeginTest (Constructor)
+{
+  Ptr<AcmeFlatFib> shared = MakeShared ();
+  Ptr<AcmeFlatOverlayFib> overlay = MakeOverlay (shared);
+  NS_TEST_EXPECT_MSG_EQ (overlay->GetSize (), 2, "The overlay should have the shared routes");
+  NS_TEST_EXPECT_MSG_EQ (overlay->GetLocalFib ()->GetSize (), 0, "Nothing should be copied yet");
+  NS_TEST_EXPECT_MSG_EQ (overlay->IsExactMatch (), false, "A trie overlay is longest prefix match");
+
+  std::vector<AcmeFlatFib::RouteType> routes;
+  overlay->GetRoutes (routes);
+  NS_TEST_EXPECT_MSG_EQ (routes.size (), 3, "Should list every shared next hop");
+}
+EndTest ()
+
+BeginTest (LookupNextHop_NoCopy)
+{
+  Ptr<AcmeFlatFib> shared = MakeShared ();
+  Ptr<AcmeFlatOverlayFib> a = MakeOverlay (shared);
+  Ptr<AcmeFlatOverlayFib> b = MakeOverlay (shared);
+
+  AcmeFlatFib::NextHopType *nextHop = LookupNextHop (a, "ccnx:/name=acm/name=icn/name=paper");
+  NS_TEST_ASSERT_MSG_NE (nextHop, 0, "Lookup failed");
+  NS_TEST_EXPECT_MSG_EQ (nextHop->connId, 2, "Should match the longer shared prefix");
+  NS_TEST_EXPECT_MSG_EQ (nextHop == LookupNextHop (shared, "ccnx:/name=acm/name=icn"), true, "Should hand out the shared route");
+  NS_TEST_EXPECT_MSG_EQ (a->GetNextHopCount (*nextHop), 2, "Should see both shared next hops");
+  NS_TEST_EXPECT_MSG_EQ (a->GetNextHop (*nextHop, 1).connId, 3, "Wrong alternate");
+  NS_TEST_EXPECT_MSG_EQ (a->GetCopies (), 0, "A lookup should not copy the route");
+  NS_TEST_EXPECT_MSG_EQ (a->GetLocalFib ()->GetSize (), 0, "The private FIB should stay empty");
+
+  // Per-node state stays on the node
+  a->GetNextHopState (*nextHop).packets = 10;
+  a->GetNextHopState (a->GetNextHop (*nextHop, 1)).packets = 20;
+  AcmeFlatFib::NextHopType *other = LookupNextHop (b, "ccnx:/name=acm/name=icn/name=paper");
+  NS_TEST_EXPECT_MSG_EQ (b->PeekNextHopState (*other).packets, 0, "Another node should not see the counters");
+  NS_TEST_EXPECT_MSG_EQ (a->PeekNextHopState (*LookupNextHop (a, "ccnx:/name=acm/name=icn/name=paper")).packets, 10,
+                         "The node should keep its counters");
+  NS_TEST_EXPECT_MSG_EQ (shared->PeekNextHopState (*nextHop).packets, 0, "The shared FIB should not be written");
+  NS_TEST_EXPECT_MSG_EQ (nextHop->state, AcmeFlatFib::NoState, "The shared next hop should not get state");
+
+  std::vector<AcmeFlatFib::RouteType> routes;
+  a->GetRoutes (routes);
+  uint64_t packets = 0;
+  for (size_t i = 0; i < routes.size (); ++i)
+    {
+      packets += routes[i].packets;
+    }
+  NS_TEST_EXPECT_MSG_EQ (packets, 30, "Should list the node's counters");
+}
+EndTest ()
+
+BeginTest (AddNextHop_Local)
+{
+  Ptr<AcmeFlatFib> shared = MakeShared ();
+  Ptr<AcmeFlatOverlayFib> overlay = MakeOverlay (shared);
+  overlay->GetNextHopState (*LookupNextHop (overlay, "ccnx:/name=acm/name=sigcomm")).packets = 7;
+
+  NS_TEST_EXPECT_MSG_EQ (AddNextHop (overlay, "ccnx:/name=acm/name=icn/name=local", 4), true, "Add failed");
+  NS_TEST_EXPECT_MSG_EQ (AddNextHop (overlay, "ccnx:/name=acm", 1), false, "A shared next hop is already there");
+  NS_TEST_EXPECT_MSG_EQ (overlay->GetCopies (), 0, "Nothing should be copied yet");
+  NS_TEST_EXPECT_MSG_EQ (AddNextHop (overlay, "ccnx:/name=acm", 5), true, "Add to a shared route failed");
+  NS_TEST_EXPECT_MSG_EQ (overlay->GetCopies (), 1, "Changing a shared route should copy it");
+  NS_TEST_EXPECT_MSG_EQ (overlay->GetSize (), 3, "Wrong size");
+  NS_TEST_EXPECT_MSG_EQ (shared->GetSize (), 2, "The shared FIB should not change");
+
+  NS_TEST_EXPECT_MSG_EQ (LookupNextHop (overlay, "ccnx:/name=acm/name=icn/name=local/name=x")->connId, 4,
+                         "A longer local route should win");
+  NS_TEST_EXPECT_MSG_EQ (LookupNextHop (overlay, "ccnx:/name=acm/name=icn/name=other")->connId, 2,
+                         "A longer shared route should win");
+  AcmeFlatFib::NextHopType *acm = LookupNextHop (overlay, "ccnx:/name=acm/name=sigcomm");
+  NS_TEST_EXPECT_MSG_EQ (overlay->GetNextHopCount (*acm), 2, "The local next hop should be added to the copy");
+  NS_TEST_EXPECT_MSG_EQ (overlay->PeekNextHopState (*acm).packets, 7, "The copy should keep the node's counters");
+
+  std::vector<AcmeFlatFib::RouteType> routes;
+  overlay->GetRoutes (routes);
+  NS_TEST_EXPECT_MSG_EQ (routes.size (), 5, "Copied routes should be listed once");
+}
+EndTest ()
+
+BeginTest (RemoveRoute_Withdraw)
+{
+  Ptr<AcmeFlatFib> shared = MakeShared ();
+  Ptr<AcmeFlatOverlayFib> overlay = MakeOverlay (shared);
+  AddNextHop (overlay, "ccnx:/name=local", 4);
+  NS_TEST_EXPECT_MSG_EQ (RemoveRoute (overlay, "ccnx:/name=local", 4), true, "Remove failed");
+
+  // Removing one of two shared next hops copies the route, the last withdraws it
+  NS_TEST_EXPECT_MSG_EQ (RemoveRoute (overlay, "ccnx:/name=acm/name=icn", 9), false, "Not a next hop of the route");
+  NS_TEST_EXPECT_MSG_EQ (overlay->GetCopies (), 0, "Nothing to remove, nothing to copy");
+  NS_TEST_EXPECT_MSG_EQ (RemoveRoute (overlay, "ccnx:/name=acm/name=icn", 2), true, "Remove failed");
+  NS_TEST_EXPECT_MSG_EQ (LookupNextHop (overlay, "ccnx:/name=acm/name=icn/name=paper")->connId, 3, "Wrong next hop left");
+  NS_TEST_EXPECT_MSG_EQ (RemoveRoute (overlay, "ccnx:/name=acm/name=icn", 3), true, "Remove failed");
+  NS_TEST_EXPECT_MSG_EQ (RemoveRoute (overlay, "ccnx:/name=acm/name=icn", 3), false, "Already removed");
+  NS_TEST_EXPECT_MSG_EQ (overlay->GetSharedFib () == shared, true, "The overlay should stay attached");
+  NS_TEST_EXPECT_MSG_EQ (overlay->GetCopies (), 1, "Only the multipath route should be copied");
+  NS_TEST_EXPECT_MSG_EQ (overlay->GetWithdrawnCount (), 1, "Wrong tombstone count");
+  NS_TEST_EXPECT_MSG_EQ (overlay->GetSize (), 1, "Wrong size");
+  NS_TEST_EXPECT_MSG_EQ (LookupNextHop (overlay, "ccnx:/name=acm/name=icn/name=paper")->connId, 1,
+                         "The withdrawn route should not show through");
+
+  // A single next hop route is withdrawn without a copy
+  NS_TEST_EXPECT_MSG_EQ (RemoveRoute (overlay, "ccnx:/name=acm", 1), true, "Remove failed");
+  NS_TEST_EXPECT_MSG_EQ (overlay->GetCopies (), 1, "Withdrawing should not copy");
+  NS_TEST_EXPECT_MSG_EQ (overlay->GetSize (), 0, "Wrong size");
+  NS_TEST_EXPECT_MSG_EQ (LookupNextHop (overlay, "ccnx:/name=acm/name=icn/name=paper") == 0, true, "Every route is withdrawn");
+  std::vector<AcmeFlatFib::RouteType> routes;
+  overlay->GetRoutes (routes);
+  NS_TEST_EXPECT_MSG_EQ (routes.size (), 0, "Withdrawn routes should not be listed");
+
+  // Adding the route back clears its tombstone
+  NS_TEST_EXPECT_MSG_EQ (AddNextHop (overlay, "ccnx:/name=acm", 7), true, "Add failed");
+  NS_TEST_EXPECT_MSG_EQ (overlay->GetWithdrawnCount (), 1, "Wrong tombstone count");
+  NS_TEST_EXPECT_MSG_EQ (overlay->GetSize (), 1, "Wrong size");
+  AcmeFlatFib::NextHopType *acm = LookupNextHop (overlay, "ccnx:/name=acm/name=sigcomm");
+  NS_TEST_EXPECT_MSG_EQ (acm->connId, 7, "Should use the new route");
+  NS_TEST_EXPECT_MSG_EQ (overlay->GetNextHopCount (*acm), 1, "The withdrawn next hop should not come back");
+
+  NS_TEST_EXPECT_MSG_EQ (shared->GetSize (), 2, "The shared FIB should not change");
+  NS_TEST_EXPECT_MSG_EQ (LookupNextHop (MakeOverlay (shared), "ccnx:/name=acm/name=icn/name=paper")->connId, 2,
+                         "Other nodes should still see the shared routes");
+}
+EndTest ()
+
+BeginTest (GetSharedRoutes_Connection)
+{
+  Ptr<AcmeFlatFib> shared = MakeShared ();
+  AddNextHop (shared, "ccnx:/name=ietf", 2);
+  Ptr<AcmeFlatOverlayFib> overlay = MakeOverlay (shared);
+  AddNextHop (overlay, "ccnx:/name=acm/name=icn", 4);
+
+  // What AcmeFlatForwarder::RemoveRoutesForConnection does when connection 2 fails
+  std::vector<AcmeFlatFib::BulkRouteType> routes;
+  NS_TEST_EXPECT_MSG_EQ (overlay->GetSharedRoutes (2, routes), 2, "Should find the shared routes through 2");
+  for (size_t i = 0; i < routes.size (); ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (overlay->RemoveRoute (routes[i].name, routes[i].digest, routes[i].connId), true, "Remove failed");
+    }
+  NS_TEST_EXPECT_MSG_EQ (overlay->GetSharedFib () == shared, true, "The overlay should stay attached");
+
+  AcmeFlatFib::NextHopType *nextHop = LookupNextHop (overlay, "ccnx:/name=acm/name=icn/name=paper");
+  for (size_t i = 0; i < overlay->GetNextHopCount (*nextHop); ++i)
+    {
+      NS_TEST_EXPECT_MSG_NE (overlay->GetNextHop (*nextHop, i).connId, 2, "The failed connection should be gone");
+    }
+  NS_TEST_EXPECT_MSG_EQ (overlay->GetNextHopCount (*nextHop), 2, "The other next hops should stay");
+  NS_TEST_EXPECT_MSG_EQ (LookupNextHop (overlay, "ccnx:/name=ietf/name=rfc") == 0, true, "The route through 2 should be gone");
+
+  routes.clear ();
+  NS_TEST_EXPECT_MSG_EQ (overlay->GetSharedRoutes (2, routes), 1, "A copied route is still listed");
+  NS_TEST_EXPECT_MSG_EQ (overlay->RemoveRoute (routes[0].name, routes[0].digest, 2), false, "Already removed");
+  routes.clear ();
+  NS_TEST_EXPECT_MSG_EQ (overlay->GetSharedRoutes (1, routes), 1, "Should find the shared route through 1");
+  NS_TEST_EXPECT_MSG_EQ (overlay->RemoveRoute (routes[0].name, routes[0].digest, 1), true, "Remove failed");
+  routes.clear ();
+  NS_TEST_EXPECT_MSG_EQ (overlay->GetSharedRoutes (1, routes), 0, "A withdrawn route is not listed");
+  NS_TEST_EXPECT_MSG_EQ (LookupNextHop (overlay, "ccnx:/name=acm/name=sigcomm") == 0, true, "The route through 1 should be gone");
+}
+EndTest ()
+
+BeginTest (LookupNextHop_ExactMatch)
+{
+  Ptr<AcmeFlatFib> shared = CreateObject<AcmeFlatHashFib> ();
+  AddNextHop (shared, "ccnx:/name=a", 1);
+  Ptr<AcmeFlatOverlayFib> overlay = CreateObject<AcmeFlatOverlayFib> ();
+  overlay->SetFibs (shared, CreateObject<AcmeFlatHashFib> ());
+
+  NS_TEST_EXPECT_MSG_EQ (overlay->IsExactMatch (), true, "A hash overlay is exact match");
+  NS_TEST_EXPECT_MSG_EQ (LookupNextHop (overlay, "ccnx:/name=a")->connId, 1, "Lookup failed");
+  NS_TEST_EXPECT_MSG_EQ (LookupNextHop (overlay, "ccnx:/name=a/name=b") == 0, true, "Should not match a prefix");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for AcmeFlatOverlayFib
+ */
+static class TestSuiteAcmeFlatOverlayFib : public TestSuite
+{
+public:
+  TestSuiteAcmeFlatOverlayFib () : TestSuite ("acme-flat-overlay-fib", UNIT)
+  {
+    AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new LookupNextHop_NoCopy (), TestCase::QUICK);
+    AddTestCase (new AddNextHop_Local (), TestCase::QUICK);
+    AddTestCase (new RemoveRoute_Withdraw (), TestCase::QUICK);
+    AddTestCase (new GetSharedRoutes_Connection (), TestCase::QUICK);
+    AddTestCase (new LookupNextHop_ExactMatch (), TestCase::QUICK);
+  }
+} g_TestSuiteAcmeFlatOverlayFib;
+
+} // namespace TestSuiteAcmeFlatOverlayFib
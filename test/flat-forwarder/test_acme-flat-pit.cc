@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "ns3/test.h"
+#include "ns3/acme-flat-pit.h"
+#include "ns3/acme-flat-name-digest.h"
+
+#include "../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+namespace TestSuiteAcmeFlatPit {
+
+BeginTest (Constructor)
+{
+  Ptr<AcmeFlatPit> pit = CreateObject<AcmeFlatPit> ();
+  NS_TEST_EXPECT_MSG_EQ (pit->GetSize (), 0, "New PIT should be empty");
+}
+EndTest ()
+
+BeginTest (AddIngress_Aggregate)
+{
+  Ptr<AcmeFlatPit> pit = CreateObject<AcmeFlatPit> ();
+  Ptr<const CCNxName> name = Create<CCNxName> ("ccnx:/name=acm/name=icn");
+  uint64_t digest = AcmeFlatNameDigest::Compute (*name);
+  Time now = Seconds (1);
+
+  NS_TEST_EXPECT_MSG_EQ (pit->Find (*name, digest, now), AcmeFlatPit::None, "Find should miss");
+
+  uint32_t handle = pit->Insert (name, digest, now);
+  NS_TEST_EXPECT_MSG_EQ (pit->AddIngress (handle, 1, now), true, "First ingress should be new");
+  NS_TEST_EXPECT_MSG_EQ (pit->AddIngress (handle, 2, now), true, "Second ingress should be new");
+  NS_TEST_EXPECT_MSG_EQ (pit->AddIngress (handle, 1, now), false, "Repeated ingress is a retransmission");
+
+  Ptr<const CCNxName> lookup = Create<CCNxName> ("ccnx:/name=acm/name=icn");
+  NS_TEST_EXPECT_MSG_EQ (pit->Find (*lookup, digest, now), handle, "Find should return the entry");
+  NS_TEST_EXPECT_MSG_EQ (pit->GetIngress (handle).size (), 2, "Wrong ingress count");
+
+  pit->Erase (handle);
+  NS_TEST_EXPECT_MSG_EQ (pit->Find (*name, digest, now), AcmeFlatPit::None, "Find should miss after erase");
+  NS_TEST_EXPECT_MSG_EQ (pit->GetSize (), 0, "PIT should be empty");
+}
+EndTest ()
+
+BeginTest (Find_Expired)
+{
+  Ptr<AcmeFlatPit> pit = CreateObject<AcmeFlatPit> ();
+  pit->SetAttribute ("DefaultLifetime", TimeValue (Seconds (4)));
+  Ptr<const CCNxName> name = Create<CCNxName> ("ccnx:/name=acm/name=icn");
+  uint64_t digest = AcmeFlatNameDigest::Compute (*name);
+
+  uint32_t handle = pit->Insert (name, digest, Seconds (1));
+  pit->AddIngress (handle, 1, Seconds (2));
+  NS_TEST_EXPECT_MSG_EQ (pit->Find (*name, digest, Seconds (5.5)), handle, "AddIngress should extend the lifetime");
+  NS_TEST_EXPECT_MSG_EQ (pit->Find (*name, digest, Seconds (6)), AcmeFlatPit::None, "Entry should have expired");
+  NS_TEST_EXPECT_MSG_EQ (pit->GetSize (), 0, "Expired entry should be erased");
+}
+EndTest ()
+
+BeginTest (SetCongestionMark_Reuse)
+{
+  Ptr<AcmeFlatPit> pit = CreateObject<AcmeFlatPit> ();
+  Ptr<const CCNxName> name = Create<CCNxName> ("ccnx:/name=acm/name=icn");
+  uint64_t digest = AcmeFlatNameDigest::Compute (*name);
+  Time now = Seconds (1);
+
+  uint32_t handle = pit->Insert (name, digest, now);
+  NS_TEST_EXPECT_MSG_EQ (pit->HasCongestionMark (handle), false, "New entry should not be marked");
+  pit->SetCongestionMark (handle);
+  NS_TEST_EXPECT_MSG_EQ (pit->HasCongestionMark (handle), true, "Entry should be marked");
+
+  // The mark does not outlive the entry
+  pit->Erase (handle);
+  uint32_t reused = pit->Insert (name, digest, now);
+  NS_TEST_EXPECT_MSG_EQ (reused, handle, "The free slot should be reused");
+  NS_TEST_EXPECT_MSG_EQ (pit->HasCongestionMark (reused), false, "A reused entry should not be marked");
+}
+EndTest ()
+
+BeginTest (GetOperations_Counts)
+{
+  Ptr<AcmeFlatPit> pit = CreateObject<AcmeFlatPit> ();
+  Ptr<const CCNxName> name = Create<CCNxName> ("ccnx:/name=acm/name=icn");
+  uint64_t digest = AcmeFlatNameDigest::Compute (*name);
+  Time now = Seconds (1);
+
+  // A miss on an empty table examines the one empty slot
+  pit->Find (*name, digest, now);
+  AcmeFlatOperationCounts operations = pit->GetOperations ();
+  NS_TEST_EXPECT_MSG_EQ (operations.probes, 1, "Wrong probes after a miss");
+  NS_TEST_EXPECT_MSG_EQ (operations.segmentCompares, 0, "A miss should not compare names");
+  NS_TEST_EXPECT_MSG_EQ (operations.insertions, 0, "Wrong insertions");
+
+  uint32_t handle = pit->Insert (name, digest, now);
+  Ptr<const CCNxName> copy = Create<CCNxName> ("ccnx:/name=acm/name=icn");
+  NS_TEST_EXPECT_MSG_EQ (pit->Find (*copy, digest, now), handle, "Find should return the entry");
+  operations = pit->GetOperations ();
+  NS_TEST_EXPECT_MSG_EQ (operations.probes, 2, "Wrong probes after a hit");
+  NS_TEST_EXPECT_MSG_EQ (operations.segmentCompares, 2, "A hit should compare both segments");
+  NS_TEST_EXPECT_MSG_EQ (operations.insertions, 1, "Wrong insertions");
+
+  // The entry's own instance (an interned name) matches without comparing segments
+  NS_TEST_EXPECT_MSG_EQ (pit->Find (*name, digest, now), handle, "Find should return the entry");
+  operations = pit->GetOperations ();
+  NS_TEST_EXPECT_MSG_EQ (operations.probes, 3, "Wrong probes after a hit");
+  NS_TEST_EXPECT_MSG_EQ (operations.segmentCompares, 2, "The same instance should not compare segments");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for AcmeFlatPit
+ */
+static class TestSuiteAcmeFlatPit : public TestSuite
+{
+public:
+  TestSuiteAcmeFlatPit () : TestSuite ("acme-flat-pit", UNIT)
+  {
+    AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new AddIngress_Aggregate (), TestCase::QUICK);
+    AddTestCase (new Find_Expired (), TestCase::QUICK);
+    AddTestCase (new SetCongestionMark_Reuse (), TestCase::QUICK);
+    AddTestCase (new GetOperations_Counts (), TestCase::QUICK);
+  }
+} g_TestSuiteAcmeFlatPit;
+
+} // namespace TestSuiteAcmeFlatPit
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/ccnx-content-object.h"
+#include "ns3/acme-flat-rate-controller.h"
+
+#include "../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+namespace TestSuiteAcmeFlatRateController {
+
+static std::vector<Time> _intervals;
+
+static void
+SampleInterval (Ptr<AcmeFlatRateController> controller)
+{
+  _intervals.push_back (controller->GetInterval ());
+}
+
+static void
+Mark (Ptr<AcmeFlatRateController> controller, std::string uri)
+{
+  Ptr<CCNxPacket> packet = CCNxPacket::CreateFromMessage (Create<CCNxContentObject> (Create<CCNxName> (uri)));
+  controller->CongestionMarked (packet, Ptr<CCNxConnection> ());
+}
+
+BeginTest (CongestionMarked_Decrease)
+{
+  _intervals.clear ();
+  Ptr<AcmeFlatRateController> controller = CreateObject<AcmeFlatRateController> ();
+  controller->SetConsumer (Ptr<Object> (), Create<CCNxName> ("ccnx:/name=a"), MilliSeconds (10));
+  NS_TEST_EXPECT_MSG_EQ (controller->GetInterval (), MilliSeconds (10), "Should start at the configured rate");
+
+  // Three marks within one reaction interval cut the rate once
+  Simulator::Schedule (MilliSeconds (1), &Mark, controller, "ccnx:/name=a/name=1");
+  Simulator::Schedule (MilliSeconds (2), &Mark, controller, "ccnx:/name=a/name=2");
+  Simulator::Schedule (MilliSeconds (3), &Mark, controller, "ccnx:/name=a/name=3");
+  Simulator::Schedule (MilliSeconds (4), &SampleInterval, controller);
+
+  // Marks of other consumers are ignored
+  Simulator::Schedule (MilliSeconds (150), &Mark, controller, "ccnx:/name=b/name=1");
+  Simulator::Schedule (MilliSeconds (250), &SampleInterval, controller);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (controller->GetMarks (), 3, "Wrong mark count");
+  NS_TEST_EXPECT_MSG_EQ (controller->GetDecreases (), 1, "Should cut once per reaction interval");
+  NS_TEST_EXPECT_MSG_EQ (_intervals[0], MilliSeconds (20), "Rate should be halved");
+  NS_TEST_EXPECT_MSG_LT (_intervals[1], MilliSeconds (20), "Rate should be increasing");
+  controller->Dispose ();
+}
+EndTest ()
+
+BeginTest (Increase_Recover)
+{
+  _intervals.clear ();
+  Ptr<AcmeFlatRateController> controller = CreateObject<AcmeFlatRateController> ();
+  controller->SetAttribute ("IncreaseStep", DoubleValue (10));
+  controller->SetConsumer (Ptr<Object> (), Ptr<const CCNxName> (), MilliSeconds (10));
+
+  // 100/s cut to 50/s, then 10/s more each 100 msec without a mark
+  Simulator::Schedule (Seconds (0), &Mark, controller, "ccnx:/name=a");
+  Simulator::Schedule (MilliSeconds (250), &SampleInterval, controller);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (_intervals[0].GetMicroSeconds (), 14285, "Wrong rate after two increases");
+  NS_TEST_EXPECT_MSG_EQ (controller->GetInterval (), MilliSeconds (10), "Should recover to the configured rate");
+  controller->Dispose ();
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for AcmeFlatRateController
+ */
+static class TestSuiteAcmeFlatRateController : public TestSuite
+{
+public:
+  TestSuiteAcmeFlatRateController () : TestSuite ("acme-flat-rate-controller", UNIT)
+  {
+    AddTestCase (new CongestionMarked_Decrease (), TestCase::QUICK);
+    AddTestCase (new Increase_Recover (), TestCase::QUICK);
+  }
+} g_TestSuiteAcmeFlatRateController;
+
+} // namespace TestSuiteAcmeFlatRateController
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+
+#include "ns3/test.h"
+#include "ns3/double.h"
+#include "ns3/acme-flat-rtt-strategy.h"
+#include "ns3/acme-flat-hash-fib.h"
+#include "ns3/acme-flat-name-digest.h"
+
+#include "../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+namespace TestSuiteAcmeFlatRttStrategy {
+
+/**
+ * A FIB with one route to next hops 1, 2 and 3
+ */
+static AcmeFlatFib::NextHopType &
+MakeRoute (Ptr<AcmeFlatHashFib> fib)
+{
+  Ptr<const CCNxName> name = Create<CCNxName> ("ccnx:/name=replica");
+  uint64_t digest = AcmeFlatNameDigest::Compute (*name);
+  for (CCNxConnection::ConnIdType connId = 1; connId <= 3; ++connId)
+    {
+      fib->AddNextHop (name, digest, connId, 0);
+    }
+  return *fib->LookupNextHop (name, digest);
+}
+
+BeginTest (SelectNextHop_Unmeasured)
+{
+  Ptr<AcmeFlatHashFib> fib = CreateObject<AcmeFlatHashFib> ();
+  AcmeFlatFib::NextHopType &first = MakeRoute (fib);
+  Ptr<AcmeFlatRttStrategy> strategy = CreateObject<AcmeFlatRttStrategy> ();
+  strategy->SetAttribute ("ExplorationFraction", DoubleValue (0.0));
+
+  NS_TEST_EXPECT_MSG_EQ (strategy->IsMeasuring (), true, "The strategy needs round trip times");
+
+  // Next hop 1 is measured, so an unmeasured one is tried first
+  strategy->ReportRtt (*fib, fib->GetNextHop (first, 0), MilliSeconds (10));
+  NS_TEST_EXPECT_MSG_EQ (strategy->SelectNextHop (*fib, first, 1, 4).connId, 2, "Should try an unmeasured next hop");
+
+  // Never the ingress
+  strategy->ReportRtt (*fib, fib->GetNextHop (first, 1), MilliSeconds (20));
+  strategy->ReportRtt (*fib, fib->GetNextHop (first, 2), MilliSeconds (30));
+  NS_TEST_EXPECT_MSG_EQ (strategy->SelectNextHop (*fib, first, 1, 1).connId, 2, "Should skip the ingress");
+}
+EndTest ()
+
+BeginTest (SelectNextHop_Fastest)
+{
+  Ptr<AcmeFlatHashFib> fib = CreateObject<AcmeFlatHashFib> ();
+  AcmeFlatFib::NextHopType &first = MakeRoute (fib);
+  Ptr<AcmeFlatRttStrategy> strategy = CreateObject<AcmeFlatRttStrategy> ();
+  strategy->SetAttribute ("ExplorationFraction", DoubleValue (0.1));
+  strategy->AssignStreams (1);
+
+  strategy->ReportRtt (*fib, fib->GetNextHop (first, 0), MilliSeconds (30));
+  strategy->ReportRtt (*fib, fib->GetNextHop (first, 1), MilliSeconds (10));
+  strategy->ReportRtt (*fib, fib->GetNextHop (first, 2), MilliSeconds (20));
+
+  const unsigned count = 10000;
+  unsigned chosen[4] = { 0, 0, 0, 0 };
+  for (unsigned i = 0; i < count; ++i)
+    {
+      chosen[strategy->SelectNextHop (*fib, first, i, 4).connId]++;
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (chosen[2] + strategy->GetExplorations (), count, "The fastest next hop should get the rest");
+  NS_TEST_EXPECT_MSG_GT (chosen[2], count * 85 / 100, "The fastest next hop should get most Interests");
+  NS_TEST_EXPECT_MSG_GT (chosen[1], count * 3 / 100, "Each other next hop should be explored");
+  NS_TEST_EXPECT_MSG_GT (chosen[3], count * 3 / 100, "Each other next hop should be explored");
+}
+EndTest ()
+
+BeginTest (ReportTimeout_Demotes)
+{
+  Ptr<AcmeFlatHashFib> fib = CreateObject<AcmeFlatHashFib> ();
+  AcmeFlatFib::NextHopType &first = MakeRoute (fib);
+  Ptr<AcmeFlatRttStrategy> strategy = CreateObject<AcmeFlatRttStrategy> ();
+  strategy->SetAttribute ("ExplorationFraction", DoubleValue (0.0));
+  strategy->SetAttribute ("Gain", DoubleValue (0.5));
+
+  strategy->ReportRtt (*fib, fib->GetNextHop (first, 0), MilliSeconds (10));
+  strategy->ReportRtt (*fib, fib->GetNextHop (first, 1), MilliSeconds (40));
+  strategy->ReportRtt (*fib, fib->GetNextHop (first, 2), MilliSeconds (50));
+  NS_TEST_EXPECT_MSG_EQ (strategy->SelectNextHop (*fib, first, 1, 4).connId, 1, "Should choose the fastest");
+
+  // 10 + 0.5 * (100 - 10) = 55 msec
+  strategy->ReportTimeout (*fib, fib->GetNextHop (first, 0), MilliSeconds (100));
+  NS_TEST_EXPECT_MSG_EQ (fib->PeekNextHopState (fib->GetNextHop (first, 0)).rtt, MilliSeconds (55), "Wrong smoothed round trip time");
+  NS_TEST_EXPECT_MSG_EQ (strategy->SelectNextHop (*fib, first, 1, 4).connId, 2, "A timeout should demote the next hop");
+  NS_TEST_EXPECT_MSG_EQ (strategy->GetSamples (), 4, "Wrong sample count");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for AcmeFlatRttStrategy
+ */
+static class TestSuiteAcmeFlatRttStrategy : public TestSuite
+{
+public:
+  TestSuiteAcmeFlatRttStrategy () : TestSuite ("acme-flat-rtt-strategy", UNIT)
+  {
+    AddTestCase (new SelectNextHop_Unmeasured (), TestCase::QUICK);
+    AddTestCase (new SelectNextHop_Fastest (), TestCase::QUICK);
+    AddTestCase (new ReportTimeout_Demotes (), TestCase::QUICK);
+  }
+} g_TestSuiteAcmeFlatRttStrategy;
+
+} // namespace TestSuiteAcmeFlatRttStrategy
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "ns3/test.h"
+#include "ns3/acme-flat-timer-wheel.h"
+
+#include "../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+
+namespace TestSuiteAcmeFlatTimerWheel {
+
+BeginTest (Constructor)
+{
+  AcmeFlatTimerWheel wheel;
+  NS_TEST_EXPECT_MSG_EQ (wheel.GetSize (), 0, "New wheel should be empty");
+  NS_TEST_EXPECT_MSG_EQ (wheel.GetNextTick (), AcmeFlatTimerWheel::Never, "Empty wheel has no next tick");
+}
+EndTest ()
+
+BeginTest (Advance_SameSlot)
+{
+  AcmeFlatTimerWheel wheel;
+  std::vector<AcmeFlatTimerWheel::TimerType> expired;
+
+  wheel.Insert (10, 1, 0);
+  wheel.Insert (10, 2, 0);
+  wheel.Insert (12, 3, 0);
+  NS_TEST_EXPECT_MSG_EQ (wheel.GetNextTick (), 10, "Wrong next tick");
+
+  wheel.Advance (9, expired);
+  NS_TEST_EXPECT_MSG_EQ (expired.size (), 0, "Nothing is due yet");
+
+  wheel.Advance (10, expired);
+  NS_TEST_EXPECT_MSG_EQ (expired.size (), 2, "Both timers in the slot should fire");
+  NS_TEST_EXPECT_MSG_EQ (wheel.GetNextTick (), 12, "Wrong next tick");
+
+  expired.clear ();
+  wheel.Advance (100, expired);
+  NS_TEST_EXPECT_MSG_EQ (expired.size (), 1, "Last timer should fire");
+  NS_TEST_EXPECT_MSG_EQ (expired[0].handle, 3, "Wrong handle");
+  NS_TEST_EXPECT_MSG_EQ (wheel.GetSize (), 0, "Wheel should be empty");
+}
+EndTest ()
+
+BeginTest (Advance_Cascade)
+{
+  // Timers in every level, fired in order as the wheel cascades
+  AcmeFlatTimerWheel wheel;
+  std::vector<AcmeFlatTimerWheel::TimerType> expired;
+
+  const uint64_t ticks[] = { 5, 70, 4100, 262200, 300000, 16000000 };
+  const unsigned count = sizeof(ticks) / sizeof(ticks[0]);
+  for (unsigned i = 0; i < count; ++i)
+    {
+      wheel.Insert (ticks[i], i, 7);
+    }
+
+  for (unsigned i = 0; i < count; ++i)
+    {
+      // Step event by event, as the forwarder does
+      while (expired.empty ())
+        {
+          uint64_t next = wheel.GetNextTick ();
+          NS_TEST_EXPECT_MSG_EQ ((next <= ticks[i]), true, "Next tick is after the earliest timer");
+          wheel.Advance (next, expired);
+        }
+      NS_TEST_EXPECT_MSG_EQ (expired.size (), 1, "One timer per tick");
+      NS_TEST_EXPECT_MSG_EQ (expired[0].handle, i, "Timers fired out of order");
+      NS_TEST_EXPECT_MSG_EQ (expired[0].generation, 7, "Wrong generation");
+      NS_TEST_EXPECT_MSG_EQ (wheel.GetCurrentTick (), ticks[i], "Fired on the wrong tick");
+      expired.clear ();
+    }
+  NS_TEST_EXPECT_MSG_EQ (wheel.GetNextTick (), AcmeFlatTimerWheel::Never, "Wheel should be empty");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for AcmeFlatTimerWheel
+ */
+static class TestSuiteAcmeFlatTimerWheel : public TestSuite
+{
+public:
+  TestSuiteAcmeFlatTimerWheel () : TestSuite ("acme-flat-timer-wheel", UNIT)
+  {
+    AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new Advance_SameSlot (), TestCase::QUICK);
+    AddTestCase (new Advance_Cascade (), TestCase::QUICK);
+  }
+} g_TestSuiteAcmeFlatTimerWheel;
+
+} // namespace TestSuiteAcmeFlatTimerWheel
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "ns3/test.h"
+#include "ns3/acme-flat-token-bucket.h"
+
+#include "../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+
+namespace TestSuiteAcmeFlatTokenBucket {
+
+BeginTest (Constructor)
+{
+  AcmeFlatTokenBucket bucket (1000, 4);
+  NS_TEST_EXPECT_MSG_EQ (bucket.GetTokens (Seconds (0)), 4.0, "The bucket should start full");
+  NS_TEST_EXPECT_MSG_EQ (bucket.GetConforming (), 0, "Wrong conforming count");
+  NS_TEST_EXPECT_MSG_EQ (bucket.GetExceeding (), 0, "Wrong exceeding count");
+}
+EndTest ()
+
+BeginTest (Consume_Burst)
+{
+  AcmeFlatTokenBucket bucket (1000, 4);
+
+  // A back to back burst gets the tokens in the bucket and no more
+  for (unsigned i = 0; i < 4; ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (bucket.Consume (Seconds (0)), true, "Burst should conform");
+    }
+  NS_TEST_EXPECT_MSG_EQ (bucket.Consume (Seconds (0)), false, "Packet past the burst should exceed");
+  NS_TEST_EXPECT_MSG_EQ (bucket.GetConforming (), 4, "Wrong conforming count");
+  NS_TEST_EXPECT_MSG_EQ (bucket.GetExceeding (), 1, "Wrong exceeding count");
+}
+EndTest ()
+
+BeginTest (Consume_Refill)
+{
+  AcmeFlatTokenBucket bucket (1000, 4);
+  for (unsigned i = 0; i < 4; ++i)
+    {
+      bucket.Consume (Seconds (0));
+    }
+
+  // One token per msec
+  NS_TEST_EXPECT_MSG_EQ (bucket.Consume (MicroSeconds (500)), false, "Half a token is not enough");
+  NS_TEST_EXPECT_MSG_EQ (bucket.Consume (MicroSeconds (1000)), true, "A token should have been added");
+  NS_TEST_EXPECT_MSG_EQ (bucket.Consume (MicroSeconds (1000)), false, "Only one token should have been added");
+
+  // A long idle period fills the bucket only up to the burst
+  NS_TEST_EXPECT_MSG_EQ (bucket.GetTokens (Seconds (10)), 4.0, "Refill should stop at the burst");
+  unsigned conforming = 0;
+  for (unsigned i = 0; i < 10; ++i)
+    {
+      conforming += bucket.Consume (Seconds (10)) ? 1 : 0;
+    }
+  NS_TEST_EXPECT_MSG_EQ (conforming, 4, "Wrong burst after idle");
+}
+EndTest ()
+
+BeginTest (Consume_Rate)
+{
+  AcmeFlatTokenBucket bucket (1000, 1);
+
+  // Offered at 4 packets per msec for 100 msec, about 1 per msec conforms
+  for (unsigned i = 0; i < 400; ++i)
+    {
+      bucket.Consume (MicroSeconds (250 * i));
+    }
+  NS_TEST_EXPECT_MSG_EQ (bucket.GetConforming (), 100, "Wrong conforming count");
+  NS_TEST_EXPECT_MSG_EQ (bucket.GetExceeding (), 300, "Wrong exceeding count");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for AcmeFlatTokenBucket
+ */
+static class TestSuiteAcmeFlatTokenBucket : public TestSuite
+{
+public:
+  TestSuiteAcmeFlatTokenBucket () : TestSuite ("acme-flat-token-bucket", UNIT)
+  {
+    AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new Consume_Burst (), TestCase::QUICK);
+    AddTestCase (new Consume_Refill (), TestCase::QUICK);
+    AddTestCase (new Consume_Rate (), TestCase::QUICK);
+  }
+} g_TestSuiteAcmeFlatTokenBucket;
+
+} // namespace TestSuiteAcmeFlatTokenBucket
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <cstdio>
+
+#include "ns3/test.h"
+#include "ns3/acme-flat-trie-fib.h"
+#include "ns3/acme-flat-name-digest.h"
+
+#include "../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::acme;
+using namespace ns3::ccnx;
+
+namespace TestSuiteAcmeFlatTrieFib {
+
+static bool
+Lookup (Ptr<AcmeFlatTrieFib> fib, const char *uri, CCNxConnection::ConnIdType &connId)
+{
+  Ptr<const CCNxName> name = Create<CCNxName> (uri);
+  return fib->Lookup (name, AcmeFlatNameDigest::Compute (*name), connId);
+}
+
+static bool
+AddRoute (Ptr<AcmeFlatTrieFib> fib, const char *uri, CCNxConnection::ConnIdType connId)
+{
+  Ptr<const CCNxName> name = Create<CCNxName> (uri);
+  return fib->AddRoute (name, AcmeFlatNameDigest::Compute (*name), connId);
+}
+
+static bool
+RemoveRoute (Ptr<AcmeFlatTrieFib> fib, const char *uri, CCNxConnection::ConnIdType connId)
+{
+  Ptr<const CCNxName> name = Create<CCNxName> (uri);
+  return fib->RemoveRoute (name, AcmeFlatNameDigest::Compute (*name), connId);
+}
+
+BeginTest (Constructor)
+{
+  Ptr<AcmeFlatTrieFib> fib = CreateObject<AcmeFlatTrieFib> ();
+  NS_TEST_EXPECT_MSG_EQ (fib->GetSize (), 0, "New FIB should be empty");
+  NS_TEST_EXPECT_MSG_EQ (fib->GetNodeCount (), 1, "New FIB should only have the root");
+}
+EndTest ()
+
+BeginTest (Lookup_LongestPrefix)
+{
+  Ptr<AcmeFlatTrieFib> fib = CreateObject<AcmeFlatTrieFib> ();
+  NS_TEST_EXPECT_MSG_EQ (AddRoute (fib, "ccnx:/name=acm", 1), true, "Add failed");
+  NS_TEST_EXPECT_MSG_EQ (AddRoute (fib, "ccnx:/name=acm/name=icn/name=000001", 2), true, "Add failed");
+  NS_TEST_EXPECT_MSG_EQ (AddRoute (fib, "ccnx:/name=acm", 3), false, "Duplicate add should fail");
+
+  CCNxConnection::ConnIdType connId = 0;
+  NS_TEST_EXPECT_MSG_EQ (Lookup (fib, "ccnx:/name=acm/name=icn/name=000001/name=chunk7", connId), true, "Lookup failed");
+  NS_TEST_EXPECT_MSG_EQ (connId, 2, "Should match the longer prefix");
+
+  NS_TEST_EXPECT_MSG_EQ (Lookup (fib, "ccnx:/name=acm/name=icn/name=000002/name=chunk7", connId), true, "Lookup failed");
+  NS_TEST_EXPECT_MSG_EQ (connId, 1, "Should match the shorter prefix");
+
+  // Ends inside the compressed edge icn/000001
+  NS_TEST_EXPECT_MSG_EQ (Lookup (fib, "ccnx:/name=acm/name=icn", connId), true, "Lookup failed");
+  NS_TEST_EXPECT_MSG_EQ (connId, 1, "Should match the shorter prefix");
+
+  NS_TEST_EXPECT_MSG_EQ (Lookup (fib, "ccnx:/name=ieee/name=icn", connId), false, "Lookup should miss");
+}
+EndTest ()
+
+BeginTest (RemoveRoute_Prune)
+{
+  Ptr<AcmeFlatTrieFib> fib = CreateObject<AcmeFlatTrieFib> ();
+  AddRoute (fib, "ccnx:/name=a/name=b/name=c", 1);
+  AddRoute (fib, "ccnx:/name=a/name=b/name=d", 2);
+  AddRoute (fib, "ccnx:/name=a/name=b", 3);
+
+  // root, a/b, c, d
+  NS_TEST_EXPECT_MSG_EQ (fib->GetNodeCount (), 4, "Wrong node count");
+
+  NS_TEST_EXPECT_MSG_EQ (RemoveRoute (fib, "ccnx:/name=a/name=b", 4), false, "Remove with wrong connId should fail");
+  NS_TEST_EXPECT_MSG_EQ (RemoveRoute (fib, "ccnx:/name=a/name=b", 3), true, "Remove failed");
+  NS_TEST_EXPECT_MSG_EQ (RemoveRoute (fib, "ccnx:/name=a/name=b/name=c", 1), true, "Remove failed");
+
+  // d collapses into a/b/d
+  NS_TEST_EXPECT_MSG_EQ (fib->GetNodeCount (), 2, "Wrong node count after prune");
+  NS_TEST_EXPECT_MSG_EQ (fib->GetSize (), 1, "Wrong size after remove");
+
+  CCNxConnection::ConnIdType connId = 0;
+  NS_TEST_EXPECT_MSG_EQ (Lookup (fib, "ccnx:/name=a/name=b/name=d/name=e", connId), true, "Lookup failed");
+  NS_TEST_EXPECT_MSG_EQ (connId, 2, "Wrong connection id");
+  NS_TEST_EXPECT_MSG_EQ (Lookup (fib, "ccnx:/name=a/name=b/name=c", connId), false, "Lookup should miss");
+}
+EndTest ()
+
+BeginTest (AddRoute_Many)
+{
+  Ptr<AcmeFlatTrieFib> fib = CreateObject<AcmeFlatTrieFib> ();
+  const unsigned count = 5000;
+  char buffer[64];
+  for (unsigned i = 0; i < count; ++i)
+    {
+      snprintf (buffer, sizeof(buffer), "ccnx:/name=acm/name=icn/name=%06u", i);
+      AddRoute (fib, buffer, i + 1);
+    }
+  NS_TEST_EXPECT_MSG_EQ (fib->GetSize (), count, "Wrong size after adds");
+
+  // Remove enough to force the segment pool to compact
+  for (unsigned i = 0; i < count; ++i)
+    {
+      if (i % 4 == 3)
+        {
+          continue;
+        }
+      snprintf (buffer, sizeof(buffer), "ccnx:/name=acm/name=icn/name=%06u", i);
+      NS_TEST_EXPECT_MSG_EQ (RemoveRoute (fib, buffer, i + 1), true, "Remove failed " << i);
+    }
+
+  for (unsigned i = 0; i < count; ++i)
+    {
+      snprintf (buffer, sizeof(buffer), "ccnx:/name=acm/name=icn/name=%06u/name=chunk", i);
+      CCNxConnection::ConnIdType connId = 0;
+      bool found = Lookup (fib, buffer, connId);
+      NS_TEST_EXPECT_MSG_EQ (found, (i % 4) == 3, "Wrong lookup result for " << i);
+      if (found)
+        {
+          NS_TEST_EXPECT_MSG_EQ (connId, i + 1, "Wrong connection id for " << i);
+        }
+    }
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for AcmeFlatTrieFib
+ */
+BeginTest (AddNextHop_LongestPrefix)
+{
+  Ptr<AcmeFlatTrieFib> fib = CreateObject<AcmeFlatTrieFib> ();
+  Ptr<const CCNxName> prefix = Create<CCNxName> ("ccnx:/name=a/name=b");
+  uint64_t digest = AcmeFlatNameDigest::Compute (*prefix);
+  NS_TEST_EXPECT_MSG_EQ (fib->AddNextHop (prefix, digest, 1, 0), true, "Add failed");
+  NS_TEST_EXPECT_MSG_EQ (fib->AddNextHop (prefix, digest, 2, 0), true, "Add failed");
+  AddRoute (fib, "ccnx:/name=a/name=b/name=c", 3);
+
+  Ptr<const CCNxName> name = Create<CCNxName> ("ccnx:/name=a/name=b/name=d");
+  AcmeFlatFib::NextHopType *first = fib->LookupNextHop (name, AcmeFlatNameDigest::Compute (*name));
+  NS_TEST_EXPECT_MSG_EQ ((first != 0), true, "Lookup failed");
+  NS_TEST_EXPECT_MSG_EQ (fib->GetNextHopCount (*first), 2, "The prefix should have two next hops");
+
+  // Removing one next hop keeps the node, the other still serves names below it
+  NS_TEST_EXPECT_MSG_EQ (RemoveRoute (fib, "ccnx:/name=a/name=b", 1), true, "Remove failed");
+  CCNxConnection::ConnIdType connId = 0;
+  NS_TEST_EXPECT_MSG_EQ (Lookup (fib, "ccnx:/name=a/name=b/name=d", connId), true, "Lookup failed");
+  NS_TEST_EXPECT_MSG_EQ (connId, 2, "The alternate should be promoted");
+  NS_TEST_EXPECT_MSG_EQ (fib->GetSize (), 2, "Wrong size");
+}
+EndTest ()
+
+static class TestSuiteAcmeFlatTrieFib : public TestSuite
+{
+public:
+  TestSuiteAcmeFlatTrieFib () : TestSuite ("acme-flat-trie-fib", UNIT)
+  {
+    AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new Lookup_LongestPrefix (), TestCase::QUICK);
+    AddTestCase (new RemoveRoute_Prune (), TestCase::QUICK);
+    AddTestCase (new AddRoute_Many (), TestCase::QUICK);
+    AddTestCase (new AddNextHop_LongestPrefix (), TestCase::QUICK);
+  }
+} g_TestSuiteAcmeFlatTrieFib;
+
+} // namespace TestSuiteAcmeFlatTrieFib